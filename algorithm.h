@@ -0,0 +1,943 @@
+#ifndef LZ_STL_ALGORITHM_H
+#define LZ_STL_ALGORITHM_H
+
+/*
+algorithm：copy / fill / fill_n / find / count / equal / mismatch / lexicographical_compare / min_element / max_element
+为什么需要？
+库里原来没有算法，只能对 vector::data() 调用 std::find、std::count，这些都是逐个元素比较
+扫描几 MB 的 int 数组时，一次比较 8 个（AVX2）或 16 个（AVX-512）能快好几倍
+
+做法：
+1.通用版本只要求相应的迭代器类别；随机访问迭代器按个数循环（find 展开 4 次），少做一次迭代器比较
+2.原生指针上的算术类型（1/2/4/8 字节整数、float、double）走 SIMD 内核：
+	find / count：整块比较得到掩码，ctz 得到位置，popcount 得到个数
+	mismatch / lexicographical_compare：整数按字节比较，找第一个不同的字节；equal 直接用 memcmp
+		浮点数有 NaN 和 ±0，按字节比较结果不对，仍走通用版本
+	min_element / max_element（整数）：先用向量 min/max 归约出极值，再用 find 找它第一次出现的位置
+	copy / fill：平凡可复制 / POD 走 memmove、simd.h 的 simd_copy（大块且不重叠）、simd_fill
+3.和 simd.h 一样运行时检测 CPU：AVX-512（还要求 AVX512BW）、AVX2，都没有时用标量循环
+  每个（算法, 元素类型）第一次调用时选定内核，之后只是一次函数指针调用
+4.find / count 要求查找的值与元素同类型（find(int*, int*, int)）
+  类型不同时比较涉及整型提升和符号转换，交给通用版本
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "type_traits.h"
+#include "iterator.h"
+#include "simd.h"
+
+namespace lzstl
+{
+	// -------------------------- 元素类型分类 --------------------------
+	// SIMD 内核支持的整数：1/2/4/8 字节
+	template <typename T>
+	struct __is_simd_integral
+		: public __bool_type<std::is_integral<T>::value
+							 && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)>::type {};
+
+	// 再加上 float、double
+	template <typename T>
+	struct __is_simd_arithmetic
+		: public __bool_type<__is_simd_integral<T>::value || std::is_same<T,float>::value
+							 || std::is_same<T,double>::value>::type {};
+
+	// 只有原生指针才走 SIMD；下面几个判断都只对指针特化
+	// find / count：元素可向量化，且查找的值与元素同类型
+	template <typename Iterator,typename T>
+	struct __simd_find_ok : public false_type {};
+
+	template <typename T>
+	struct __simd_find_ok<T*,T> : public __is_simd_arithmetic<T> {};
+
+	template <typename T>
+	struct __simd_find_ok<const T*,T> : public __is_simd_arithmetic<T> {};
+
+	// equal / mismatch / lexicographical_compare：两边元素同类型的整数
+	template <typename Iterator1,typename Iterator2>
+	struct __simd_mismatch_ok : public false_type {};
+
+	template <typename T>
+	struct __simd_mismatch_ok<T*,T*> : public __is_simd_integral<T> {};
+
+	template <typename T>
+	struct __simd_mismatch_ok<const T*,T*> : public __is_simd_integral<T> {};
+
+	template <typename T>
+	struct __simd_mismatch_ok<T*,const T*> : public __is_simd_integral<T> {};
+
+	template <typename T>
+	struct __simd_mismatch_ok<const T*,const T*> : public __is_simd_integral<T> {};
+
+	// min_element / max_element：整数
+	template <typename Iterator>
+	struct __simd_extreme_ok : public false_type {};
+
+	template <typename T>
+	struct __simd_extreme_ok<T*> : public __is_simd_integral<T> {};
+
+	template <typename T>
+	struct __simd_extreme_ok<const T*> : public __is_simd_integral<T> {};
+
+	// copy：两边同类型且平凡可复制，可以按字节搬
+	template <typename InputIterator,typename OutputIterator>
+	struct __copy_memmove_ok : public false_type {};
+
+	template <typename T>
+	struct __copy_memmove_ok<T*,T*> : public is_trivially_copyable<T> {};
+
+	template <typename T>
+	struct __copy_memmove_ok<const T*,T*> : public is_trivially_copyable<T> {};
+
+	// fill：POD 元素
+	template <typename ForwardIterator>
+	struct __simd_fill_ok : public false_type {};
+
+	template <typename T>
+	struct __simd_fill_ok<T*> : public type_traits<T>::is_POD_type {};
+
+	// -------------------------- 内核选择 --------------------------
+	// AVX-512 内核用到 8/16 位整数的比较（AVX512BW），只有 AVX512F 的 CPU 退回 AVX2
+	inline __simd_level __algorithm_simd_level()
+	{
+		static const __simd_level level = []()
+		{
+			__simd_level l = simd_level();
+#ifdef LZ_STL_SIMD_X86
+			if(l == __SIMD_AVX512 && !__builtin_cpu_supports("avx512bw"))
+				l = __SIMD_AVX2;
+#endif
+			return l;
+		}();
+		return level;
+	}
+
+	// 每种算法是一个 “内核族”：scalar / avx2 / avx512 三个静态函数，type 为函数指针类型
+	template <typename Kernels>
+	inline typename Kernels::type __select_algorithm_kernel()
+	{
+#ifdef LZ_STL_SIMD_X86
+		switch(__algorithm_simd_level())
+		{
+			case __SIMD_AVX512: return &Kernels::avx512;
+			case __SIMD_AVX2:   return &Kernels::avx2;
+			default: break;
+		}
+#endif
+		return &Kernels::scalar;
+	}
+
+	template <typename Kernels>
+	inline typename Kernels::type __algorithm_kernel_for_cpu()
+	{
+		static const typename Kernels::type kernel = __select_algorithm_kernel<Kernels>();
+		return kernel;
+	}
+
+#ifdef LZ_STL_SIMD_X86
+	// -------------------------- 向量操作 --------------------------
+	// 按元素大小、符号、是否浮点选择指令；整数的相等比较与符号无关
+	// AVX2：eq 返回字节掩码（每个相等的元素占 sizeof(E) 位）
+	template <size_t Size>
+	struct __avx2_int_lane;
+
+	template <>
+	struct __avx2_int_lane<1>
+	{
+		__attribute__((target("avx2"))) static __m256i set1(long long v) {return _mm256_set1_epi8(char(v));}
+		__attribute__((target("avx2"))) static unsigned eq(__m256i a,__m256i b) {return unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a,b)));}
+	};
+
+	template <>
+	struct __avx2_int_lane<2>
+	{
+		__attribute__((target("avx2"))) static __m256i set1(long long v) {return _mm256_set1_epi16(short(v));}
+		__attribute__((target("avx2"))) static unsigned eq(__m256i a,__m256i b) {return unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi16(a,b)));}
+	};
+
+	template <>
+	struct __avx2_int_lane<4>
+	{
+		__attribute__((target("avx2"))) static __m256i set1(long long v) {return _mm256_set1_epi32(int(v));}
+		__attribute__((target("avx2"))) static unsigned eq(__m256i a,__m256i b) {return unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi32(a,b)));}
+	};
+
+	template <>
+	struct __avx2_int_lane<8>
+	{
+		__attribute__((target("avx2"))) static __m256i set1(long long v) {return _mm256_set1_epi64x(v);}
+		__attribute__((target("avx2"))) static unsigned eq(__m256i a,__m256i b) {return unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi64(a,b)));}
+	};
+
+	template <typename E,size_t Size = sizeof(E),bool Signed = std::is_signed<E>::value,
+			  bool Float = std::is_floating_point<E>::value>
+	struct __avx2_ops;
+
+	template <typename E>
+	struct __avx2_ops<E,1,true,false> : public __avx2_int_lane<1>
+	{
+		__attribute__((target("avx2"))) static __m256i min(__m256i a,__m256i b) {return _mm256_min_epi8(a,b);}
+		__attribute__((target("avx2"))) static __m256i max(__m256i a,__m256i b) {return _mm256_max_epi8(a,b);}
+	};
+
+	template <typename E>
+	struct __avx2_ops<E,1,false,false> : public __avx2_int_lane<1>
+	{
+		__attribute__((target("avx2"))) static __m256i min(__m256i a,__m256i b) {return _mm256_min_epu8(a,b);}
+		__attribute__((target("avx2"))) static __m256i max(__m256i a,__m256i b) {return _mm256_max_epu8(a,b);}
+	};
+
+	template <typename E>
+	struct __avx2_ops<E,2,true,false> : public __avx2_int_lane<2>
+	{
+		__attribute__((target("avx2"))) static __m256i min(__m256i a,__m256i b) {return _mm256_min_epi16(a,b);}
+		__attribute__((target("avx2"))) static __m256i max(__m256i a,__m256i b) {return _mm256_max_epi16(a,b);}
+	};
+
+	template <typename E>
+	struct __avx2_ops<E,2,false,false> : public __avx2_int_lane<2>
+	{
+		__attribute__((target("avx2"))) static __m256i min(__m256i a,__m256i b) {return _mm256_min_epu16(a,b);}
+		__attribute__((target("avx2"))) static __m256i max(__m256i a,__m256i b) {return _mm256_max_epu16(a,b);}
+	};
+
+	template <typename E>
+	struct __avx2_ops<E,4,true,false> : public __avx2_int_lane<4>
+	{
+		__attribute__((target("avx2"))) static __m256i min(__m256i a,__m256i b) {return _mm256_min_epi32(a,b);}
+		__attribute__((target("avx2"))) static __m256i max(__m256i a,__m256i b) {return _mm256_max_epi32(a,b);}
+	};
+
+	template <typename E>
+	struct __avx2_ops<E,4,false,false> : public __avx2_int_lane<4>
+	{
+		__attribute__((target("avx2"))) static __m256i min(__m256i a,__m256i b) {return _mm256_min_epu32(a,b);}
+		__attribute__((target("avx2"))) static __m256i max(__m256i a,__m256i b) {return _mm256_max_epu32(a,b);}
+	};
+
+	// AVX2 没有 64 位 min/max：比较后按掩码混合；无符号数先翻转最高位再做有符号比较
+	template <typename E>
+	struct __avx2_ops<E,8,true,false> : public __avx2_int_lane<8>
+	{
+		__attribute__((target("avx2"))) static __m256i min(__m256i a,__m256i b) {return _mm256_blendv_epi8(a,b,_mm256_cmpgt_epi64(a,b));}
+		__attribute__((target("avx2"))) static __m256i max(__m256i a,__m256i b) {return _mm256_blendv_epi8(b,a,_mm256_cmpgt_epi64(a,b));}
+	};
+
+	template <typename E>
+	struct __avx2_ops<E,8,false,false> : public __avx2_int_lane<8>
+	{
+		__attribute__((target("avx2"))) static __m256i __gt(__m256i a,__m256i b)
+		{
+			const __m256i bias = _mm256_set1_epi64x((long long)(1ULL << 63));
+			return _mm256_cmpgt_epi64(_mm256_xor_si256(a,bias),_mm256_xor_si256(b,bias));
+		}
+		__attribute__((target("avx2"))) static __m256i min(__m256i a,__m256i b) {return _mm256_blendv_epi8(a,b,__gt(a,b));}
+		__attribute__((target("avx2"))) static __m256i max(__m256i a,__m256i b) {return _mm256_blendv_epi8(b,a,__gt(a,b));}
+	};
+
+	// 浮点数按 == 的语义比较（有序比较：NaN 不等于任何值，+0 等于 -0）
+	template <typename E>
+	struct __avx2_ops<E,4,true,true>
+	{
+		__attribute__((target("avx2"))) static __m256i set1(float v) {return _mm256_castps_si256(_mm256_set1_ps(v));}
+		__attribute__((target("avx2"))) static unsigned eq(__m256i a,__m256i b)
+		{
+			return unsigned(_mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a),_mm256_castsi256_ps(b),_CMP_EQ_OQ))));
+		}
+	};
+
+	template <typename E>
+	struct __avx2_ops<E,8,true,true>
+	{
+		__attribute__((target("avx2"))) static __m256i set1(double v) {return _mm256_castpd_si256(_mm256_set1_pd(v));}
+		__attribute__((target("avx2"))) static unsigned eq(__m256i a,__m256i b)
+		{
+			return unsigned(_mm256_movemask_epi8(_mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a),_mm256_castsi256_pd(b),_CMP_EQ_OQ))));
+		}
+	};
+
+	// AVX-512：eq 返回元素掩码（每个元素一位）
+	template <size_t Size>
+	struct __avx512_int_lane;
+
+	template <>
+	struct __avx512_int_lane<1>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i set1(long long v) {return _mm512_set1_epi8(char(v));}
+		__attribute__((target("avx512f,avx512bw"))) static unsigned long long eq(__m512i a,__m512i b) {return _mm512_cmpeq_epi8_mask(a,b);}
+	};
+
+	template <>
+	struct __avx512_int_lane<2>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i set1(long long v) {return _mm512_set1_epi16(short(v));}
+		__attribute__((target("avx512f,avx512bw"))) static unsigned long long eq(__m512i a,__m512i b) {return _mm512_cmpeq_epi16_mask(a,b);}
+	};
+
+	template <>
+	struct __avx512_int_lane<4>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i set1(long long v) {return _mm512_set1_epi32(int(v));}
+		__attribute__((target("avx512f,avx512bw"))) static unsigned long long eq(__m512i a,__m512i b) {return _mm512_cmpeq_epi32_mask(a,b);}
+	};
+
+	template <>
+	struct __avx512_int_lane<8>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i set1(long long v) {return _mm512_set1_epi64(v);}
+		__attribute__((target("avx512f,avx512bw"))) static unsigned long long eq(__m512i a,__m512i b) {return _mm512_cmpeq_epi64_mask(a,b);}
+	};
+
+	template <typename E,size_t Size = sizeof(E),bool Signed = std::is_signed<E>::value,
+			  bool Float = std::is_floating_point<E>::value>
+	struct __avx512_ops;
+
+	template <typename E>
+	struct __avx512_ops<E,1,true,false> : public __avx512_int_lane<1>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i min(__m512i a,__m512i b) {return _mm512_min_epi8(a,b);}
+		__attribute__((target("avx512f,avx512bw"))) static __m512i max(__m512i a,__m512i b) {return _mm512_max_epi8(a,b);}
+	};
+
+	template <typename E>
+	struct __avx512_ops<E,1,false,false> : public __avx512_int_lane<1>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i min(__m512i a,__m512i b) {return _mm512_min_epu8(a,b);}
+		__attribute__((target("avx512f,avx512bw"))) static __m512i max(__m512i a,__m512i b) {return _mm512_max_epu8(a,b);}
+	};
+
+	template <typename E>
+	struct __avx512_ops<E,2,true,false> : public __avx512_int_lane<2>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i min(__m512i a,__m512i b) {return _mm512_min_epi16(a,b);}
+		__attribute__((target("avx512f,avx512bw"))) static __m512i max(__m512i a,__m512i b) {return _mm512_max_epi16(a,b);}
+	};
+
+	template <typename E>
+	struct __avx512_ops<E,2,false,false> : public __avx512_int_lane<2>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i min(__m512i a,__m512i b) {return _mm512_min_epu16(a,b);}
+		__attribute__((target("avx512f,avx512bw"))) static __m512i max(__m512i a,__m512i b) {return _mm512_max_epu16(a,b);}
+	};
+
+	// 32/64 位的 min/max 用全 1 掩码的版本：GCC 12 对不带掩码的版本会误报 -Wmaybe-uninitialized
+	template <typename E>
+	struct __avx512_ops<E,4,true,false> : public __avx512_int_lane<4>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i min(__m512i a,__m512i b) {return _mm512_mask_min_epi32(a,__mmask16(-1),a,b);}
+		__attribute__((target("avx512f,avx512bw"))) static __m512i max(__m512i a,__m512i b) {return _mm512_mask_max_epi32(a,__mmask16(-1),a,b);}
+	};
+
+	template <typename E>
+	struct __avx512_ops<E,4,false,false> : public __avx512_int_lane<4>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i min(__m512i a,__m512i b) {return _mm512_mask_min_epu32(a,__mmask16(-1),a,b);}
+		__attribute__((target("avx512f,avx512bw"))) static __m512i max(__m512i a,__m512i b) {return _mm512_mask_max_epu32(a,__mmask16(-1),a,b);}
+	};
+
+	template <typename E>
+	struct __avx512_ops<E,8,true,false> : public __avx512_int_lane<8>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i min(__m512i a,__m512i b) {return _mm512_mask_min_epi64(a,__mmask8(-1),a,b);}
+		__attribute__((target("avx512f,avx512bw"))) static __m512i max(__m512i a,__m512i b) {return _mm512_mask_max_epi64(a,__mmask8(-1),a,b);}
+	};
+
+	template <typename E>
+	struct __avx512_ops<E,8,false,false> : public __avx512_int_lane<8>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i min(__m512i a,__m512i b) {return _mm512_mask_min_epu64(a,__mmask8(-1),a,b);}
+		__attribute__((target("avx512f,avx512bw"))) static __m512i max(__m512i a,__m512i b) {return _mm512_mask_max_epu64(a,__mmask8(-1),a,b);}
+	};
+
+	template <typename E>
+	struct __avx512_ops<E,4,true,true>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i set1(float v) {return _mm512_castps_si512(_mm512_set1_ps(v));}
+		__attribute__((target("avx512f,avx512bw"))) static unsigned long long eq(__m512i a,__m512i b)
+		{
+			return _mm512_cmp_ps_mask(_mm512_castsi512_ps(a),_mm512_castsi512_ps(b),_CMP_EQ_OQ);
+		}
+	};
+
+	template <typename E>
+	struct __avx512_ops<E,8,true,true>
+	{
+		__attribute__((target("avx512f,avx512bw"))) static __m512i set1(double v) {return _mm512_castpd_si512(_mm512_set1_pd(v));}
+		__attribute__((target("avx512f,avx512bw"))) static unsigned long long eq(__m512i a,__m512i b)
+		{
+			return _mm512_cmp_pd_mask(_mm512_castsi512_pd(a),_mm512_castsi512_pd(b),_CMP_EQ_OQ);
+		}
+	};
+#endif
+
+	// -------------------------- 内核 --------------------------
+	// find：返回第一个等于 v 的下标，没有则返回 n
+	template <typename E>
+	struct __find_kernels
+	{
+		typedef size_t (*type)(const E*,size_t,E);
+
+		static size_t scalar(const E* p,size_t n,E v)
+		{
+			for(size_t i = 0;i<n;++i)
+				if(p[i] == v)
+					return i;
+			return n;
+		}
+
+#ifdef LZ_STL_SIMD_X86
+		// 每轮比较两个向量，拼成 64 位掩码只判断一次
+		__attribute__((target("avx2")))
+		static size_t avx2(const E* p,size_t n,E v)
+		{
+			typedef __avx2_ops<E> ops;
+			const size_t step = 32 / sizeof(E);
+			const __m256i key = ops::set1(v);
+			size_t i = 0;
+			for(;i + 2*step <= n;i += 2*step)
+			{
+				unsigned long long m = ops::eq(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p+i)),key)
+					| (unsigned long long)ops::eq(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p+i+step)),key) << 32;
+				if(m)
+					return i + __builtin_ctzll(m) / sizeof(E);
+			}
+			return i + scalar(p+i,n-i,v);
+		}
+
+		__attribute__((target("avx512f,avx512bw")))
+		static size_t avx512(const E* p,size_t n,E v)
+		{
+			typedef __avx512_ops<E> ops;
+			const size_t step = 64 / sizeof(E);
+			const __m512i key = ops::set1(v);
+			size_t i = 0;
+			for(;i + step <= n;i += step)
+			{
+				unsigned long long m = ops::eq(_mm512_loadu_si512(p+i),key);
+				if(m)
+					return i + __builtin_ctzll(m);
+			}
+			return i + scalar(p+i,n-i,v);
+		}
+#endif
+	};
+
+	// count：等于 v 的个数
+	template <typename E>
+	struct __count_kernels
+	{
+		typedef size_t (*type)(const E*,size_t,E);
+
+		static size_t scalar(const E* p,size_t n,E v)
+		{
+			size_t c = 0;
+			for(size_t i = 0;i<n;++i)
+				c += p[i] == v;
+			return c;
+		}
+
+#ifdef LZ_STL_SIMD_X86
+		// 字节掩码里每个相等的元素占 sizeof(E) 位，最后统一除
+		__attribute__((target("avx2")))
+		static size_t avx2(const E* p,size_t n,E v)
+		{
+			typedef __avx2_ops<E> ops;
+			const size_t step = 32 / sizeof(E);
+			const __m256i key = ops::set1(v);
+			size_t bits = 0,i = 0;
+			for(;i + step <= n;i += step)
+				bits += __builtin_popcount(ops::eq(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p+i)),key));
+			return bits / sizeof(E) + scalar(p+i,n-i,v);
+		}
+
+		__attribute__((target("avx512f,avx512bw")))
+		static size_t avx512(const E* p,size_t n,E v)
+		{
+			typedef __avx512_ops<E> ops;
+			const size_t step = 64 / sizeof(E);
+			const __m512i key = ops::set1(v);
+			size_t c = 0,i = 0;
+			for(;i + step <= n;i += step)
+				c += __builtin_popcountll(ops::eq(_mm512_loadu_si512(p+i),key));
+			return c + scalar(p+i,n-i,v);
+		}
+#endif
+	};
+
+	// mismatch：按字节比较，返回第一个不同字节的偏移，全部相同返回 bytes
+	struct __mismatch_kernels
+	{
+		typedef size_t (*type)(const unsigned char*,const unsigned char*,size_t);
+
+		static size_t scalar(const unsigned char* a,const unsigned char* b,size_t bytes)
+		{
+			for(size_t i = 0;i<bytes;++i)
+				if(a[i] != b[i])
+					return i;
+			return bytes;
+		}
+
+#ifdef LZ_STL_SIMD_X86
+		__attribute__((target("avx2")))
+		static size_t avx2(const unsigned char* a,const unsigned char* b,size_t bytes)
+		{
+			size_t i = 0;
+			for(;i + 32 <= bytes;i += 32)
+			{
+				unsigned m = ~unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a+i)),
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b+i)))));
+				if(m)
+					return i + __builtin_ctz(m);
+			}
+			return i + scalar(a+i,b+i,bytes-i);
+		}
+
+		__attribute__((target("avx512f,avx512bw")))
+		static size_t avx512(const unsigned char* a,const unsigned char* b,size_t bytes)
+		{
+			size_t i = 0;
+			for(;i + 64 <= bytes;i += 64)
+			{
+				unsigned long long m = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a+i),_mm512_loadu_si512(b+i));
+				if(m)
+					return i + __builtin_ctzll(m);
+			}
+			return i + scalar(a+i,b+i,bytes-i);
+		}
+#endif
+	};
+
+	// min / max 归约：返回 [p, p+n) 的最小（Max 为 false）或最大值，n > 0
+	template <typename E,bool Max>
+	struct __extreme_kernels
+	{
+		typedef E (*type)(const E*,size_t);
+
+		static E __pick(E a,E b)
+		{
+			return Max ? (a < b ? b : a) : (b < a ? b : a);
+		}
+
+		static E scalar(const E* p,size_t n)
+		{
+			E r = p[0];
+			for(size_t i = 1;i<n;++i)
+				r = __pick(r,p[i]);
+			return r;
+		}
+
+#ifdef LZ_STL_SIMD_X86
+		__attribute__((target("avx2")))
+		static E avx2(const E* p,size_t n)
+		{
+			typedef __avx2_ops<E> ops;
+			const size_t step = 32 / sizeof(E);
+			if(n < step)
+				return scalar(p,n);
+			__m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+			size_t i = step;
+			for(;i + step <= n;i += step)
+			{
+				__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p+i));
+				acc = Max ? ops::max(acc,x) : ops::min(acc,x);
+			}
+			E lanes[32 / sizeof(E)];
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes),acc);
+			E r = scalar(lanes,step);
+			for(;i<n;++i)
+				r = __pick(r,p[i]);
+			return r;
+		}
+
+		__attribute__((target("avx512f,avx512bw")))
+		static E avx512(const E* p,size_t n)
+		{
+			typedef __avx512_ops<E> ops;
+			const size_t step = 64 / sizeof(E);
+			if(n < step)
+				return scalar(p,n);
+			__m512i acc = _mm512_loadu_si512(p);
+			size_t i = step;
+			for(;i + step <= n;i += step)
+			{
+				__m512i x = _mm512_loadu_si512(p+i);
+				acc = Max ? ops::max(acc,x) : ops::min(acc,x);
+			}
+			E lanes[64 / sizeof(E)];
+			_mm512_storeu_si512(lanes,acc);
+			E r = scalar(lanes,step);
+			for(;i<n;++i)
+				r = __pick(r,p[i]);
+			return r;
+		}
+#endif
+	};
+
+	// -------------------------- copy --------------------------
+	// 把 [first, last) 赋值到 [result, ...)，返回 result + (last - first)
+	// 目标区间的起点不能落在 [first, last) 内（与 std::copy 相同）
+	template <typename InputIterator,typename OutputIterator>
+	inline OutputIterator copy(InputIterator first,InputIterator last,OutputIterator result)
+	{
+		return __copy_aux(first,last,result,__copy_memmove_ok<InputIterator,OutputIterator>());
+	}
+
+	// 平凡可复制：memmove；大块且不重叠时用 simd_copy（超过阈值走非临时存储）
+	template <typename InputPointer,typename T>
+	inline T* __copy_aux(InputPointer first,InputPointer last,T* result,true_type)
+	{
+		const size_t n = size_t(last - first);
+		const size_t bytes = n * sizeof(T);
+		if(bytes >= nontemporal_threshold()
+		   && (reinterpret_cast<size_t>(result) + bytes <= reinterpret_cast<size_t>(first)
+			   || reinterpret_cast<size_t>(first) + bytes <= reinterpret_cast<size_t>(result)))
+			simd_copy(result,first,bytes);
+		else if(n)
+			std::memmove(result,first,bytes);
+		return result + n;
+	}
+
+	template <typename InputIterator,typename OutputIterator>
+	inline OutputIterator __copy_aux(InputIterator first,InputIterator last,OutputIterator result,false_type)
+	{
+		return __copy_loop(first,last,result,typename __is_random_access_iterator<InputIterator>::type());
+	}
+
+	// 随机访问：按个数循环
+	template <typename RandomAccessIterator,typename OutputIterator>
+	OutputIterator __copy_loop(RandomAccessIterator first,RandomAccessIterator last,OutputIterator result,true_type)
+	{
+		for(typename iterator_traits<RandomAccessIterator>::difference_type n = last - first;n > 0;--n,++first,++result)
+			*result = *first;
+		return result;
+	}
+
+	template <typename InputIterator,typename OutputIterator>
+	OutputIterator __copy_loop(InputIterator first,InputIterator last,OutputIterator result,false_type)
+	{
+		for(;first != last;++first,++result)
+			*result = *first;
+		return result;
+	}
+
+	// -------------------------- fill / fill_n --------------------------
+	template <typename ForwardIterator,typename T>
+	inline void fill(ForwardIterator first,ForwardIterator last,const T& value)
+	{
+		__fill_aux(first,last,value,__simd_fill_ok<ForwardIterator>());
+	}
+
+	template <typename T,typename Value>
+	inline void __fill_aux(T* first,T* last,const Value& value,true_type)
+	{
+		if(first != last)
+			simd_fill(first,size_t(last - first),T(value));
+	}
+
+	template <typename ForwardIterator,typename T>
+	inline void __fill_aux(ForwardIterator first,ForwardIterator last,const T& value,false_type)
+	{
+		for(;first != last;++first)
+			*first = value;
+	}
+
+	// 返回 first + n
+	template <typename OutputIterator,typename Size,typename T>
+	inline OutputIterator fill_n(OutputIterator first,Size n,const T& value)
+	{
+		return __fill_n_aux(first,n,value,__simd_fill_ok<OutputIterator>());
+	}
+
+	template <typename T,typename Size,typename Value>
+	inline T* __fill_n_aux(T* first,Size n,const Value& value,true_type)
+	{
+		if(n <= 0)
+			return first;
+		simd_fill(first,size_t(n),T(value));
+		return first + n;
+	}
+
+	template <typename OutputIterator,typename Size,typename T>
+	inline OutputIterator __fill_n_aux(OutputIterator first,Size n,const T& value,false_type)
+	{
+		for(;n > 0;--n,++first)
+			*first = value;
+		return first;
+	}
+
+	// -------------------------- find --------------------------
+	template <typename InputIterator,typename T>
+	inline InputIterator find(InputIterator first,InputIterator last,const T& value)
+	{
+		return __find_aux(first,last,value,__simd_find_ok<InputIterator,T>());
+	}
+
+	template <typename Pointer,typename T>
+	inline Pointer __find_aux(Pointer first,Pointer last,const T& value,true_type)
+	{
+		return first + __algorithm_kernel_for_cpu<__find_kernels<T> >()(first,size_t(last - first),value);
+	}
+
+	template <typename InputIterator,typename T>
+	inline InputIterator __find_aux(InputIterator first,InputIterator last,const T& value,false_type)
+	{
+		return __find_loop(first,last,value,typename __is_random_access_iterator<InputIterator>::type());
+	}
+
+	// 随机访问：每轮比较 4 个，剩下的不超过 3 个
+	template <typename RandomAccessIterator,typename T>
+	RandomAccessIterator __find_loop(RandomAccessIterator first,RandomAccessIterator last,const T& value,true_type)
+	{
+		for(typename iterator_traits<RandomAccessIterator>::difference_type n = (last - first) >> 2;n > 0;--n)
+		{
+			if(*first == value) return first;
+			++first;
+			if(*first == value) return first;
+			++first;
+			if(*first == value) return first;
+			++first;
+			if(*first == value) return first;
+			++first;
+		}
+		for(;first != last;++first)
+			if(*first == value)
+				return first;
+		return last;
+	}
+
+	template <typename InputIterator,typename T>
+	InputIterator __find_loop(InputIterator first,InputIterator last,const T& value,false_type)
+	{
+		for(;first != last;++first)
+			if(*first == value)
+				return first;
+		return last;
+	}
+
+	// -------------------------- count --------------------------
+	template <typename InputIterator,typename T>
+	inline typename iterator_traits<InputIterator>::difference_type
+	count(InputIterator first,InputIterator last,const T& value)
+	{
+		return __count_aux(first,last,value,__simd_find_ok<InputIterator,T>());
+	}
+
+	template <typename Pointer,typename T>
+	inline ptrdiff_t __count_aux(Pointer first,Pointer last,const T& value,true_type)
+	{
+		return ptrdiff_t(__algorithm_kernel_for_cpu<__count_kernels<T> >()(first,size_t(last - first),value));
+	}
+
+	template <typename InputIterator,typename T>
+	typename iterator_traits<InputIterator>::difference_type
+	__count_aux(InputIterator first,InputIterator last,const T& value,false_type)
+	{
+		typename iterator_traits<InputIterator>::difference_type n = 0;
+		for(;first != last;++first)
+			if(*first == value)
+				++n;
+		return n;
+	}
+
+	// -------------------------- mismatch / equal --------------------------
+	// 返回两个区间第一个不相等的位置；[first2, ...) 至少要和 [first1, last1) 一样长
+	template <typename InputIterator1,typename InputIterator2>
+	inline std::pair<InputIterator1,InputIterator2>
+	mismatch(InputIterator1 first1,InputIterator1 last1,InputIterator2 first2)
+	{
+		return __mismatch_aux(first1,last1,first2,__simd_mismatch_ok<InputIterator1,InputIterator2>());
+	}
+
+	// 元素下标 = 第一个不同字节的偏移 / sizeof(T)
+	template <typename Pointer1,typename Pointer2>
+	inline std::pair<Pointer1,Pointer2> __mismatch_aux(Pointer1 first1,Pointer1 last1,Pointer2 first2,true_type)
+	{
+		typedef typename iterator_traits<Pointer1>::value_type T;
+		const size_t bytes = size_t(last1 - first1) * sizeof(T);
+		const size_t i = __algorithm_kernel_for_cpu<__mismatch_kernels>()(
+			reinterpret_cast<const unsigned char*>(first1),reinterpret_cast<const unsigned char*>(first2),bytes) / sizeof(T);
+		return std::pair<Pointer1,Pointer2>(first1 + i,first2 + i);
+	}
+
+	template <typename InputIterator1,typename InputIterator2>
+	inline std::pair<InputIterator1,InputIterator2>
+	__mismatch_aux(InputIterator1 first1,InputIterator1 last1,InputIterator2 first2,false_type)
+	{
+		while(first1 != last1 && *first1 == *first2)
+		{
+			++first1;
+			++first2;
+		}
+		return std::pair<InputIterator1,InputIterator2>(first1,first2);
+	}
+
+	template <typename InputIterator1,typename InputIterator2,typename BinaryPredicate>
+	inline std::pair<InputIterator1,InputIterator2>
+	mismatch(InputIterator1 first1,InputIterator1 last1,InputIterator2 first2,BinaryPredicate pred)
+	{
+		while(first1 != last1 && pred(*first1,*first2))
+		{
+			++first1;
+			++first2;
+		}
+		return std::pair<InputIterator1,InputIterator2>(first1,first2);
+	}
+
+	// 整数只关心是否相等、不关心位置：libc 的 memcmp 已经是向量化的，比自己的 mismatch 内核还快
+	template <typename InputIterator1,typename InputIterator2>
+	inline bool equal(InputIterator1 first1,InputIterator1 last1,InputIterator2 first2)
+	{
+		return __equal_aux(first1,last1,first2,__simd_mismatch_ok<InputIterator1,InputIterator2>());
+	}
+
+	template <typename Pointer1,typename Pointer2>
+	inline bool __equal_aux(Pointer1 first1,Pointer1 last1,Pointer2 first2,true_type)
+	{
+		typedef typename iterator_traits<Pointer1>::value_type T;
+		return first1 == last1 || std::memcmp(first1,first2,size_t(last1 - first1) * sizeof(T)) == 0;
+	}
+
+	template <typename InputIterator1,typename InputIterator2>
+	inline bool __equal_aux(InputIterator1 first1,InputIterator1 last1,InputIterator2 first2,false_type)
+	{
+		return __mismatch_aux(first1,last1,first2,false_type()).first == last1;
+	}
+
+	template <typename InputIterator1,typename InputIterator2,typename BinaryPredicate>
+	inline bool equal(InputIterator1 first1,InputIterator1 last1,InputIterator2 first2,BinaryPredicate pred)
+	{
+		return lzstl::mismatch(first1,last1,first2,pred).first == last1;
+	}
+
+	// -------------------------- lexicographical_compare --------------------------
+	// 字典序 [first1, last1) < [first2, last2)
+	template <typename InputIterator1,typename InputIterator2>
+	inline bool lexicographical_compare(InputIterator1 first1,InputIterator1 last1,InputIterator2 first2,InputIterator2 last2)
+	{
+		return __lexicographical_compare_aux(first1,last1,first2,last2,__simd_mismatch_ok<InputIterator1,InputIterator2>());
+	}
+
+	// 先找公共长度内第一个不同的元素，比较它；都相同则短的在前
+	template <typename Pointer1,typename Pointer2>
+	inline bool __lexicographical_compare_aux(Pointer1 first1,Pointer1 last1,Pointer2 first2,Pointer2 last2,true_type)
+	{
+		const ptrdiff_t n1 = last1 - first1,n2 = last2 - first2;
+		const ptrdiff_t n = n1 < n2 ? n1 : n2;
+		std::pair<Pointer1,Pointer2> m = __mismatch_aux(first1,first1 + n,first2,true_type());
+		if(m.first != first1 + n)
+			return *m.first < *m.second;
+		return n1 < n2;
+	}
+
+	template <typename InputIterator1,typename InputIterator2>
+	inline bool __lexicographical_compare_aux(InputIterator1 first1,InputIterator1 last1,InputIterator2 first2,InputIterator2 last2,false_type)
+	{
+		for(;first1 != last1 && first2 != last2;++first1,++first2)
+		{
+			if(*first1 < *first2) return true;
+			if(*first2 < *first1) return false;
+		}
+		return first1 == last1 && first2 != last2;
+	}
+
+	template <typename InputIterator1,typename InputIterator2,typename Compare>
+	inline bool lexicographical_compare(InputIterator1 first1,InputIterator1 last1,InputIterator2 first2,InputIterator2 last2,Compare comp)
+	{
+		for(;first1 != last1 && first2 != last2;++first1,++first2)
+		{
+			if(comp(*first1,*first2)) return true;
+			if(comp(*first2,*first1)) return false;
+		}
+		return first1 == last1 && first2 != last2;
+	}
+
+	// -------------------------- min_element / max_element --------------------------
+	// 返回第一个最小 / 最大元素的位置，空区间返回 last
+	template <typename ForwardIterator>
+	inline ForwardIterator min_element(ForwardIterator first,ForwardIterator last)
+	{
+		return __min_element_aux(first,last,__simd_extreme_ok<ForwardIterator>());
+	}
+
+	template <typename ForwardIterator>
+	inline ForwardIterator max_element(ForwardIterator first,ForwardIterator last)
+	{
+		return __max_element_aux(first,last,__simd_extreme_ok<ForwardIterator>());
+	}
+
+	// 第一遍求极值，第二遍 find 它第一次出现的位置（命中即停）
+	template <typename Pointer>
+	inline Pointer __min_element_aux(Pointer first,Pointer last,true_type)
+	{
+		typedef typename iterator_traits<Pointer>::value_type T;
+		if(first == last)
+			return last;
+		const size_t n = size_t(last - first);
+		T v = __algorithm_kernel_for_cpu<__extreme_kernels<T,false> >()(first,n);
+		return first + __algorithm_kernel_for_cpu<__find_kernels<T> >()(first,n,v);
+	}
+
+	template <typename Pointer>
+	inline Pointer __max_element_aux(Pointer first,Pointer last,true_type)
+	{
+		typedef typename iterator_traits<Pointer>::value_type T;
+		if(first == last)
+			return last;
+		const size_t n = size_t(last - first);
+		T v = __algorithm_kernel_for_cpu<__extreme_kernels<T,true> >()(first,n);
+		return first + __algorithm_kernel_for_cpu<__find_kernels<T> >()(first,n,v);
+	}
+
+	template <typename ForwardIterator>
+	inline ForwardIterator __min_element_aux(ForwardIterator first,ForwardIterator last,false_type)
+	{
+		if(first == last)
+			return last;
+		ForwardIterator smallest = first;
+		while(++first != last)
+			if(*first < *smallest)
+				smallest = first;
+		return smallest;
+	}
+
+	template <typename ForwardIterator>
+	inline ForwardIterator __max_element_aux(ForwardIterator first,ForwardIterator last,false_type)
+	{
+		if(first == last)
+			return last;
+		ForwardIterator largest = first;
+		while(++first != last)
+			if(*largest < *first)
+				largest = first;
+		return largest;
+	}
+
+	template <typename ForwardIterator,typename Compare>
+	inline ForwardIterator min_element(ForwardIterator first,ForwardIterator last,Compare comp)
+	{
+		if(first == last)
+			return last;
+		ForwardIterator smallest = first;
+		while(++first != last)
+			if(comp(*first,*smallest))
+				smallest = first;
+		return smallest;
+	}
+
+	template <typename ForwardIterator,typename Compare>
+	inline ForwardIterator max_element(ForwardIterator first,ForwardIterator last,Compare comp)
+	{
+		if(first == last)
+			return last;
+		ForwardIterator largest = first;
+		while(++first != last)
+			if(comp(*largest,*first))
+				largest = first;
+		return largest;
+	}
+}
+
+#endif
@@ -99,6 +99,27 @@ namespace lzstl
 			return result;
 		}
 		
+		//与二级配置器统一接口，容器可以不关心用的是哪一级
+		static void* reallocate(void* p,size_t old_sz,size_t new_sz)
+		{
+			return realloc(p,old_sz,new_sz);
+		}
+		
+		//申请 n 字节时实际占用的大小，malloc 的内部规格不可见，按 n 本身算
+		static size_t size_class(size_t n)
+		{
+			return n;
+		}
+		
+		//与二级配置器统一接口：malloc 没有批量接口，只给一块，nobjs 置为 1
+		static void* allocate_batch(size_t n,int& nobjs)
+		{
+			void* result = allocate(n);
+			*static_cast<void**>(result) = nullptr;
+			nobjs = 1;
+			return result;
+		}
+		
 		//设置一个接受 用户回调函数 的函数
 		//参数是 该回调函数
 		//返回类型 是 “指向无参数、无返回值的函数的指针”
@@ -254,10 +275,62 @@ namespace lzstl
 			}
 		}
 		
+		//重新分配，保留 min(old_sz,new_sz) 字节的内容
+		//1.新旧都大于128字节：交给 realloc，缩小时通常原地完成
+		//2.新旧落在同一个规格：原块就够用，直接返回
+		//3.其余情况：新块中复制内容，旧块头插回它所属的自由链表
 		static void* reallocate(void*p,size_t old_sz,size_t new_sz)
 		{
+			if(old_sz > (size_t)__MAX_BYTES && new_sz > (size_t)__MAX_BYTES)
+				return __malloc_alloc_template<inst>::realloc(p,old_sz,new_sz);
+			if(old_sz && new_sz && size_class(old_sz) == size_class(new_sz))
+				return p;
+			void* result = allocate(new_sz);
+			size_t copy_sz = new_sz > old_sz ? old_sz : new_sz;
+			if(copy_sz)
+				std::memcpy(result,p,copy_sz);
 			deallocate(p,old_sz);
-			return allocate(new_sz);
+			return result;
+		}
+		
+		//申请 n 字节时实际占用的块大小（小块向上对齐到8的倍数）
+		//容器按这个大小确定容量，就不会浪费自由链表块尾部的零头
+		static size_t size_class(size_t n)
+		{
+			return n > (size_t)__MAX_BYTES ? n : ROUND_UP(n);
+		}
+		
+		//一次取一批（至多 nobjs 个）n 字节的块，返回链表头，nobjs 改为实际块数
+		//块之间用每块开头的指针串起来，最后一块的指针为 nullptr
+		//每一块都可以单独 deallocate(p,n)，和 allocate 得到的块没有区别
+		//自由链表有存货就整段摘下，没有就直接从内存池切一段连续的块，不经过自由链表
+		//节点容器（list）用它预取节点，省去逐个 allocate 的开销，同一批节点在内存里也挨在一起
+		static void* allocate_batch(size_t n,int& nobjs)
+		{
+			if(n > (size_t)__MAX_BYTES)
+				return __malloc_alloc_template<inst>::allocate_batch(n,nobjs);
+			obj* volatile* my_free_list = free_list + FREELIST_INDEX(n);
+			obj* result = *my_free_list;
+			if(result)
+			{
+				obj* last = result;
+				int count = 1;
+				while(count < nobjs && last->free_list_link)
+				{
+					last = last->free_list_link;
+					++count;
+				}
+				*my_free_list = last->free_list_link;
+				last->free_list_link = nullptr;
+				nobjs = count;
+				return result;
+			}
+			size_t size = ROUND_UP(n);
+			char* chunk = (char*)chunk_alloc(size,nobjs);
+			for(int i = 0;i<nobjs-1;++i)
+				((obj*)(chunk + i*size))->free_list_link = (obj*)(chunk + (i+1)*size);
+			((obj*)(chunk + (nobjs-1)*size))->free_list_link = nullptr;
+			return chunk;
 		}
 		
 		
@@ -400,6 +473,8 @@ namespace lzstl
 		return chunk_alloc(size,nobjs);
 	}
 	typedef __default_alloc_template<false,0> alloc;
+	//直接走 malloc/free 的一级配置器，自由链表不是线程安全的，多线程容器默认用它
+	typedef __malloc_alloc_template<0> malloc_alloc;
 }
 
 #endif //LZ_STL_ALLOC_H
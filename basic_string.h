@@ -0,0 +1,611 @@
+#ifndef LZ_STL_BASIC_STRING_H
+#define LZ_STL_BASIC_STRING_H
+
+/*
+basic_string / string：带短字符串优化（SSO）的字符串，堆内存来自本库的配置器
+为什么需要？
+库里没有字符串类型，处理文本的代码只能用 std::string，堆内存走全局 operator new
+几十字节的中等字符串每次都是一次 malloc/free，正好是二级配置器自由链表最擅长的大小
+
+做法：
+1.对象本身 24 字节：短串（至多 23 个字符）直接放在对象里，不分配内存
+  长串时这 24 字节是 {指针, 长度, 容量}，容量最高字节的最高位作标记
+  短串时最后一个字节存 23 - 长度：长度为 23 时它正好是 0，兼作结尾的 '\0'
+2.长串的缓冲区向 Alloc 申请，容量取 size_class 后的整块大小，不浪费自由链表块尾部的零头
+  24~128 字节的中等字符串落在二级配置器的自由链表里
+3.reserve / append 扩容时长串交给 Alloc::reallocate：
+  大块走 realloc（常常原地扩展，不复制），小块同一规格内直接返回原块
+4.find 先用 memchr 找子串的首字符（libc 的 memchr 是向量化的，一次比较 16/32 字节），
+  再比较末字符和整段，单字符的 find 就是一次 memchr
+5.移动构造/移动赋值只复制 24 字节再把源置为空短串，不分配、不抛异常；
+  放在 vector<string> 里扩容时，每个元素的搬运就是这 24 字节
+
+限制：
+1.只支持 char；布局依赖小端（x86 / ARM 小端）
+2.子串查找最坏 O(n*m)（首字符大量重复时），一般文本里首字符 + 末字符的过滤已经足够
+3.默认的 alloc 不是线程安全的，和其他容器一样，多线程各自使用要换成 malloc_alloc
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <utility>
+#include "type_traits.h"
+#include "alloc.h"
+
+namespace lzstl
+{
+	template <typename Alloc = alloc>
+	class basic_string
+	{
+		static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,"短串标记放在容量的最高字节，只支持小端");
+	public:
+		typedef char						value_type;
+		typedef char*						iterator;
+		typedef const char*					const_iterator;
+		typedef char&						reference;
+		typedef const char&					const_reference;
+		typedef char*						pointer;
+		typedef const char*					const_pointer;
+		typedef size_t						size_type;
+		typedef ptrdiff_t					difference_type;
+		typedef Alloc						allocator_type;
+
+		static const size_type npos = size_type(-1);
+	private:
+		struct __long
+		{
+			char*		ptr;
+			size_type	size;
+			size_type	cap;		// 最高位是长串标记
+		};
+		enum {__SSO_CAPACITY = sizeof(__long) - 1};		// 23
+		static const size_type __LONG_FLAG = size_type(1) << (sizeof(size_type) * 8 - 1);
+
+		union
+		{
+			__long	_l;
+			char	_s[sizeof(__long)];
+		};
+
+		// -------------------------- 内部辅助函数 --------------------------
+		bool _is_long() const {return static_cast<unsigned char>(_s[__SSO_CAPACITY]) & 0x80;}
+
+		void _set_short_size(size_type n)
+		{
+			_s[n] = '\0';
+			_s[__SSO_CAPACITY] = static_cast<char>(__SSO_CAPACITY - n);
+		}
+
+		void _set_size(size_type n)
+		{
+			if(_is_long())
+			{
+				_l.size = n;
+				_l.ptr[n] = '\0';
+			}
+			else
+				_set_short_size(n);
+		}
+
+		// 能放下 n 个字符（加结尾 '\0'）的长串容量：按配置器的规格向上取整
+		static size_type _cap_for(size_type n) {return Alloc::size_class(n + 1) - 1;}
+
+		// 按长度 n 准备好缓冲区（长度、结尾 '\0' 都已写好），返回放字符的位置；对象原来的内容不管
+		char* _init_storage(size_type n)
+		{
+			if(n <= __SSO_CAPACITY)
+			{
+				_set_short_size(n);
+				return _s;
+			}
+			size_type cap = _cap_for(n);
+			char* buf = static_cast<char*>(Alloc::allocate(cap + 1));
+			buf[n] = '\0';
+			_l.ptr = buf;
+			_l.size = n;
+			_l.cap = cap | __LONG_FLAG;
+			return buf;
+		}
+
+		void _init(const char* p,size_type n) {std::memcpy(_init_storage(n),p,n);}
+
+		void _init_empty() {_set_short_size(0);}
+
+		void _deallocate()
+		{
+			if(_is_long())
+				Alloc::deallocate(_l.ptr,capacity() + 1);
+		}
+
+		// 把容量扩到 new_cap（> capacity()），内容不变
+		// 长串交给 Alloc::reallocate：大块 realloc 常常原地扩展；短串搬到新分配的块里
+		void _grow_to(size_type new_cap)
+		{
+			new_cap = _cap_for(new_cap);
+			if(_is_long())
+				_l.ptr = static_cast<char*>(Alloc::reallocate(_l.ptr,capacity() + 1,new_cap + 1));
+			else
+			{
+				size_type n = _short_size();
+				char* buf = static_cast<char*>(Alloc::allocate(new_cap + 1));
+				std::memcpy(buf,_s,n + 1);
+				_l.ptr = buf;
+				_l.size = n;
+			}
+			_l.cap = new_cap | __LONG_FLAG;
+		}
+
+		// 保证能再放下 n 个字符：不够时至少扩到 2 倍
+		void _ensure_room(size_type n)
+		{
+			size_type need = size() + n;
+			size_type cap = capacity();
+			if(need > cap)
+				_grow_to(need > cap * 2 ? need : cap * 2);
+		}
+
+		size_type _short_size() const {return __SSO_CAPACITY - static_cast<unsigned char>(_s[__SSO_CAPACITY]);}
+
+		// p 指向自己的内容时，扩容后它会失效，先记下偏移
+		bool _inside(const char* p) const
+		{
+			std::less_equal<const char*> le;
+			return le(data(),p) && le(p,data() + size());
+		}
+
+	public:
+		// -------------------------- 构造函数/析构函数/赋值运算符 --------------------------
+		basic_string() {_init_empty();}
+		basic_string(const char* s) {_init(s,std::strlen(s));}
+		basic_string(const char* s,size_type n) {_init(s,n);}
+
+		basic_string(size_type n,char c) {std::memset(_init_storage(n),c,n);}
+
+		template <typename InputIterator,typename = typename std::enable_if<
+			!std::is_integral<InputIterator>::value>::type>
+		basic_string(InputIterator first,InputIterator last)
+		{
+			_init_empty();
+			for(;first != last;++first)
+				push_back(*first);
+		}
+
+		basic_string(const basic_string& rhs) {_init(rhs.data(),rhs.size());}
+
+		// 整个对象 24 字节照搬，源置为空短串
+		basic_string(basic_string&& rhs) noexcept
+		{
+			std::memcpy(static_cast<void*>(this),static_cast<const void*>(&rhs),sizeof(__long));
+			rhs._init_empty();
+		}
+
+		~basic_string() {_deallocate();}
+
+		basic_string& operator=(const basic_string& rhs)
+		{
+			if(this != &rhs)
+				assign(rhs.data(),rhs.size());
+			return *this;
+		}
+
+		basic_string& operator=(basic_string&& rhs) noexcept
+		{
+			if(this != &rhs)
+			{
+				_deallocate();
+				std::memcpy(static_cast<void*>(this),static_cast<const void*>(&rhs),sizeof(__long));
+				rhs._init_empty();
+			}
+			return *this;
+		}
+
+		basic_string& operator=(const char* s) {return assign(s,std::strlen(s));}
+
+		// 容量够时原地覆盖，不重新分配
+		basic_string& assign(const char* s,size_type n)
+		{
+			if(n > capacity())
+			{
+				basic_string tmp(s,n);
+				swap(tmp);
+			}
+			else
+			{
+				std::memmove(data(),s,n);
+				_set_size(n);
+			}
+			return *this;
+		}
+
+		basic_string& assign(const basic_string& s) {return *this = s;}
+
+		// -------------------------- 容量与大小 --------------------------
+		size_type size() const {return _is_long() ? _l.size : _short_size();}
+		size_type length() const {return size();}
+		size_type capacity() const {return _is_long() ? (_l.cap & ~__LONG_FLAG) : size_type(__SSO_CAPACITY);}
+		bool empty() const {return size() == 0;}
+		size_type max_size() const {return (__LONG_FLAG - 1) / 2;}
+
+		void reserve(size_type n)
+		{
+			if(n > capacity())
+				_grow_to(n);
+		}
+
+		// 放得进对象里就搬回去；长串按当前长度的规格重新分配
+		void shrink_to_fit()
+		{
+			if(!_is_long())
+				return;
+			size_type n = _l.size;
+			if(n <= __SSO_CAPACITY)
+			{
+				char* buf = _l.ptr;
+				size_type cap = capacity();
+				std::memcpy(_s,buf,n);
+				_set_short_size(n);
+				Alloc::deallocate(buf,cap + 1);
+			}
+			else if(_cap_for(n) < capacity())
+			{
+				size_type cap = _cap_for(n);
+				_l.ptr = static_cast<char*>(Alloc::reallocate(_l.ptr,capacity() + 1,cap + 1));
+				_l.cap = cap | __LONG_FLAG;
+			}
+		}
+
+		void clear() {_set_size(0);}
+
+		void resize(size_type n,char c = '\0')
+		{
+			size_type old = size();
+			if(n > old)
+				append(n - old,c);
+			else
+				_set_size(n);
+		}
+
+		// -------------------------- 访问 --------------------------
+		char* data() {return _is_long() ? _l.ptr : _s;}
+		const char* data() const {return _is_long() ? _l.ptr : _s;}
+		const char* c_str() const {return data();}
+
+		iterator begin() {return data();}
+		const_iterator begin() const {return data();}
+		iterator end() {return data() + size();}
+		const_iterator end() const {return data() + size();}
+
+		reference operator[](size_type i) {return data()[i];}
+		const_reference operator[](size_type i) const {return data()[i];}
+		reference front() {return *data();}
+		const_reference front() const {return *data();}
+		reference back() {return data()[size() - 1];}
+		const_reference back() const {return data()[size() - 1];}
+
+		// -------------------------- 修改 --------------------------
+		basic_string& append(const char* s,size_type n)
+		{
+			size_type old = size();
+			if(old + n > capacity())
+			{
+				if(_inside(s))
+				{
+					size_type offset = s - data();
+					_ensure_room(n);
+					s = data() + offset;
+				}
+				else
+					_ensure_room(n);
+			}
+			char* p = data();
+			std::memmove(p + old,s,n);
+			_set_size(old + n);
+			return *this;
+		}
+
+		basic_string& append(const char* s) {return append(s,std::strlen(s));}
+		basic_string& append(const basic_string& s) {return append(s.data(),s.size());}
+
+		basic_string& append(size_type n,char c)
+		{
+			_ensure_room(n);
+			size_type old = size();
+			std::memset(data() + old,c,n);
+			_set_size(old + n);
+			return *this;
+		}
+
+		basic_string& operator+=(const basic_string& s) {return append(s.data(),s.size());}
+		basic_string& operator+=(const char* s) {return append(s,std::strlen(s));}
+		basic_string& operator+=(char c) {push_back(c);return *this;}
+
+		void push_back(char c)
+		{
+			size_type n = size();
+			if(n == capacity())
+				_ensure_room(1);
+			data()[n] = c;
+			_set_size(n + 1);
+		}
+
+		void pop_back() {_set_size(size() - 1);}
+
+		basic_string& insert(size_type pos,const char* s,size_type n)
+		{
+			if(_inside(s))
+			{
+				basic_string tmp(s,n);
+				return insert(pos,tmp.data(),n);
+			}
+			_ensure_room(n);
+			size_type old = size();
+			char* p = data();
+			std::memmove(p + pos + n,p + pos,old - pos);
+			std::memcpy(p + pos,s,n);
+			_set_size(old + n);
+			return *this;
+		}
+
+		basic_string& insert(size_type pos,const basic_string& s) {return insert(pos,s.data(),s.size());}
+
+		// 删除 [pos, pos+n)，n 超出末尾时删到末尾
+		basic_string& erase(size_type pos = 0,size_type n = npos)
+		{
+			size_type old = size();
+			if(n > old - pos)
+				n = old - pos;
+			char* p = data();
+			std::memmove(p + pos,p + pos + n,old - pos - n);
+			_set_size(old - n);
+			return *this;
+		}
+
+		void swap(basic_string& rhs) noexcept
+		{
+			char tmp[sizeof(__long)];
+			std::memcpy(tmp,static_cast<const void*>(this),sizeof(__long));
+			std::memcpy(static_cast<void*>(this),static_cast<const void*>(&rhs),sizeof(__long));
+			std::memcpy(static_cast<void*>(&rhs),tmp,sizeof(__long));
+		}
+
+		// -------------------------- 查找 --------------------------
+		size_type find(char c,size_type pos = 0) const
+		{
+			size_type n = size();
+			if(pos >= n)
+				return npos;
+			const char* p = data();
+			const void* hit = std::memchr(p + pos,c,n - pos);
+			return hit ? static_cast<const char*>(hit) - p : npos;
+		}
+
+		// memchr 找首字符，再核对末字符，最后比较整段
+		size_type find(const char* s,size_type pos,size_type n) const
+		{
+			size_type len = size();
+			if(n == 0)
+				return pos <= len ? pos : npos;
+			if(pos >= len || n > len - pos)
+				return npos;
+			const char* p = data();
+			const char* cur = p + pos;
+			const char* last = p + len - n + 1;		// 首字符可能出现的位置 [cur, last)
+			const char first = s[0];
+			const char tail = s[n - 1];
+			while(cur < last)
+			{
+				cur = static_cast<const char*>(std::memchr(cur,first,last - cur));
+				if(!cur)
+					return npos;
+				if(cur[n - 1] == tail && std::memcmp(cur + 1,s + 1,n - 1) == 0)
+					return cur - p;
+				++cur;
+			}
+			return npos;
+		}
+
+		size_type find(const char* s,size_type pos = 0) const {return find(s,pos,std::strlen(s));}
+		size_type find(const basic_string& s,size_type pos = 0) const {return find(s.data(),pos,s.size());}
+
+		size_type rfind(char c,size_type pos = npos) const
+		{
+			size_type n = size();
+			if(n == 0)
+				return npos;
+			const char* p = data();
+			for(size_type i = pos < n ? pos + 1 : n;i-- > 0;)
+				if(p[i] == c)
+					return i;
+			return npos;
+		}
+
+		basic_string substr(size_type pos = 0,size_type n = npos) const
+		{
+			size_type len = size();
+			if(n > len - pos)
+				n = len - pos;
+			return basic_string(data() + pos,n);
+		}
+
+		// -------------------------- 比较 --------------------------
+		int compare(const char* s,size_type n) const
+		{
+			size_type len = size();
+			int r = std::memcmp(data(),s,len < n ? len : n);
+			if(r != 0)
+				return r;
+			return len < n ? -1 : (len > n ? 1 : 0);
+		}
+
+		int compare(const basic_string& s) const {return compare(s.data(),s.size());}
+		int compare(const char* s) const {return compare(s,std::strlen(s));}
+
+		allocator_type get_allocator() const {return allocator_type();}
+	};
+
+	template <typename Alloc>
+	const typename basic_string<Alloc>::size_type basic_string<Alloc>::npos;
+
+	template <typename Alloc>
+	const typename basic_string<Alloc>::size_type basic_string<Alloc>::__LONG_FLAG;
+
+	typedef basic_string<alloc> string;
+
+	// -------------------------- 非成员函数 --------------------------
+	template <typename Alloc>
+	inline bool operator==(const basic_string<Alloc>& a,const basic_string<Alloc>& b)
+	{
+		return a.size() == b.size() && std::memcmp(a.data(),b.data(),a.size()) == 0;
+	}
+
+	template <typename Alloc>
+	inline bool operator==(const basic_string<Alloc>& a,const char* b) {return a.compare(b) == 0;}
+
+	template <typename Alloc>
+	inline bool operator==(const char* a,const basic_string<Alloc>& b) {return b.compare(a) == 0;}
+
+	template <typename Alloc>
+	inline bool operator!=(const basic_string<Alloc>& a,const basic_string<Alloc>& b) {return !(a == b);}
+
+	template <typename Alloc>
+	inline bool operator!=(const basic_string<Alloc>& a,const char* b) {return !(a == b);}
+
+	template <typename Alloc>
+	inline bool operator!=(const char* a,const basic_string<Alloc>& b) {return !(b == a);}
+
+	template <typename Alloc>
+	inline bool operator<(const basic_string<Alloc>& a,const basic_string<Alloc>& b) {return a.compare(b) < 0;}
+
+	template <typename Alloc>
+	inline bool operator<(const basic_string<Alloc>& a,const char* b) {return a.compare(b) < 0;}
+
+	template <typename Alloc>
+	inline bool operator<(const char* a,const basic_string<Alloc>& b) {return b.compare(a) > 0;}
+
+	template <typename Alloc>
+	inline bool operator>(const basic_string<Alloc>& a,const basic_string<Alloc>& b) {return b < a;}
+
+	template <typename Alloc>
+	inline bool operator<=(const basic_string<Alloc>& a,const basic_string<Alloc>& b) {return !(b < a);}
+
+	template <typename Alloc>
+	inline bool operator>=(const basic_string<Alloc>& a,const basic_string<Alloc>& b) {return !(a < b);}
+
+	template <typename Alloc>
+	inline basic_string<Alloc> operator+(const basic_string<Alloc>& a,const basic_string<Alloc>& b)
+	{
+		basic_string<Alloc> r;
+		r.reserve(a.size() + b.size());
+		r.append(a);
+		r.append(b);
+		return r;
+	}
+
+	template <typename Alloc>
+	inline basic_string<Alloc> operator+(basic_string<Alloc>&& a,const basic_string<Alloc>& b)
+	{
+		a.append(b);
+		return std::move(a);
+	}
+
+	template <typename Alloc>
+	inline basic_string<Alloc> operator+(const basic_string<Alloc>& a,const char* b)
+	{
+		size_t nb = std::strlen(b);
+		basic_string<Alloc> r;
+		r.reserve(a.size() + nb);
+		r.append(a);
+		r.append(b,nb);
+		return r;
+	}
+
+	template <typename Alloc>
+	inline basic_string<Alloc> operator+(const char* a,const basic_string<Alloc>& b)
+	{
+		size_t na = std::strlen(a);
+		basic_string<Alloc> r;
+		r.reserve(na + b.size());
+		r.append(a,na);
+		r.append(b);
+		return r;
+	}
+
+	template <typename Alloc>
+	inline basic_string<Alloc> operator+(const basic_string<Alloc>& a,char c)
+	{
+		basic_string<Alloc> r;
+		r.reserve(a.size() + 1);
+		r.append(a);
+		r.push_back(c);
+		return r;
+	}
+
+	template <typename Alloc>
+	inline basic_string<Alloc> operator+(char c,const basic_string<Alloc>& b)
+	{
+		basic_string<Alloc> r;
+		r.reserve(1 + b.size());
+		r.push_back(c);
+		r.append(b);
+		return r;
+	}
+
+	template <typename Alloc>
+	inline basic_string<Alloc> operator+(basic_string<Alloc>&& a,const char* b)
+	{
+		a.append(b);
+		return std::move(a);
+	}
+
+	template <typename Alloc>
+	inline basic_string<Alloc> operator+(basic_string<Alloc>&& a,char c)
+	{
+		a.push_back(c);
+		return std::move(a);
+	}
+
+	template <typename Alloc>
+	inline void swap(basic_string<Alloc>& a,basic_string<Alloc>& b) noexcept
+	{
+		a.swap(b);
+	}
+
+	template <typename Alloc>
+	inline std::ostream& operator<<(std::ostream& os,const basic_string<Alloc>& s)
+	{
+		return os.write(s.data(),s.size());
+	}
+}
+
+namespace lzstl
+{
+	// 字节哈希：FNV-1a 逐字节异或再乘，最后乘以 2^64/φ 把高位折叠到低位（FNV 的低位分布较差）
+	inline size_t __string_hash(const char* p,size_t n)
+	{
+		unsigned long long h = 0xcbf29ce484222325ull;
+		for(size_t i = 0;i<n;++i)
+		{
+			h ^= (unsigned char)p[i];
+			h *= 0x100000001b3ull;
+		}
+		h *= 0x9E3779B97F4A7C15ull;
+		return size_t(h ^ (h >> 32));
+	}
+}
+
+namespace std
+{
+	// 只用标准接口，不依赖标准库的内部实现；可以直接做 flat_hash_map 的键
+	template <typename Alloc>
+	struct hash<lzstl::basic_string<Alloc> >
+	{
+		size_t operator()(const lzstl::basic_string<Alloc>& s) const
+		{
+			return lzstl::__string_hash(s.data(),s.size());
+		}
+	};
+}
+
+#endif
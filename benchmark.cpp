@@ -0,0 +1,1158 @@
+/*
+性能测试程序
+用法：
+	benchmark            运行全部测试
+	benchmark 名字...    只运行指定的测试（名字见 main 中的表）
+建议用 -O2 编译：g++ -std=c++14 -O2 -pthread benchmark.cpp -o benchmark
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <map>
+#include <vector>
+#include "alloc.h"
+#include "vector.h"
+#include "concurrent_vector.h"
+#include "sort.h"
+#include "simd.h"
+#include "thread_pool.h"
+#include "algorithm.h"
+#include "deque.h"
+#include "list.h"
+#include "flat_hash_map.h"
+#include "flat_map.h"
+#include "btree.h"
+#include "spsc_ring.h"
+#include "mpmc_queue.h"
+#include "priority_queue.h"
+#include "basic_string.h"
+#include "static_vector.h"
+
+using namespace std;
+
+// -------------------------- 计时工具 --------------------------
+typedef chrono::steady_clock bench_clock;
+
+static double elapsed_ms(bench_clock::time_point start)
+{
+	return chrono::duration<double, milli>(bench_clock::now() - start).count();
+}
+
+// 测试的线程数：1,2,4,... 直到硬件线程数（至少测到4）
+static std::vector<unsigned> thread_counts()
+{
+	unsigned hw = thread::hardware_concurrency();
+	if (hw < 4) hw = 4;
+	std::vector<unsigned> res;
+	for (unsigned t = 1; t <= hw; t *= 2)
+		res.push_back(t);
+	return res;
+}
+
+// -------------------------- concurrent_vector --------------------------
+// 多线程尾插 total 个元素：互斥锁 + lzstl::vector 对比 无锁 concurrent_vector
+void bench_concurrent_vector()
+{
+	cout << "=== concurrent_vector 多线程尾插 ===" << endl;
+	const size_t total = 8000000;
+	cout << setw(8) << "threads" << setw(18) << "mutex+vector(ms)" << setw(22) << "concurrent_vector(ms)" << endl;
+
+	for (unsigned nthreads : thread_counts())
+	{
+		size_t per_thread = total / nthreads;
+
+		// 1. 互斥锁保护的 lzstl::vector
+		double t_mutex;
+		{
+			lzstl::vector<size_t> vec;
+			std::mutex mtx;
+			std::vector<thread> workers;
+			auto start = bench_clock::now();
+			for (unsigned t = 0; t < nthreads; ++t)
+				workers.emplace_back([&]() {
+					for (size_t i = 0; i < per_thread; ++i)
+					{
+						lock_guard<std::mutex> lock(mtx);
+						vec.push_back(i);
+					}
+				});
+			for (auto& w : workers) w.join();
+			t_mutex = elapsed_ms(start);
+		}
+
+		// 2. 无锁 concurrent_vector
+		double t_concurrent;
+		{
+			lzstl::concurrent_vector<size_t> cv;
+			std::vector<thread> workers;
+			auto start = bench_clock::now();
+			for (unsigned t = 0; t < nthreads; ++t)
+				workers.emplace_back([&]() {
+					for (size_t i = 0; i < per_thread; ++i)
+						cv.push_back(i);
+				});
+			for (auto& w : workers) w.join();
+			t_concurrent = elapsed_ms(start);
+		}
+
+		cout << setw(8) << nthreads << setw(18) << fixed << setprecision(1) << t_mutex
+		     << setw(22) << t_concurrent << endl;
+	}
+	cout << endl;
+}
+
+// -------------------------- sort --------------------------
+// 对 n 个随机 uint64 / {uint64 key, payload} 记录排序：std::sort 对比 radix_sort、parallel_merge_sort
+// 元素个数可用环境变量 LZ_BENCH_SORT_N 调整
+struct bench_record
+{
+	unsigned long long key;
+	unsigned long long payload;
+};
+
+void bench_sort()
+{
+	cout << "=== sort 排序 ===" << endl;
+	size_t n = 20000000;
+	if (const char* env = getenv("LZ_BENCH_SORT_N"))
+		n = strtoull(env, nullptr, 10);
+
+	lzstl::vector<unsigned long long> keys;
+	lzstl::vector<bench_record> recs;
+	unsigned long long seed = 88172645463325252ULL;
+	for (size_t i = 0; i < n; ++i)
+	{
+		seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+		keys.push_back(seed);
+		bench_record r = { seed, i };
+		recs.push_back(r);
+	}
+	auto by_key = [](const bench_record& a, const bench_record& b) { return a.key < b.key; };
+	auto key_of = [](const bench_record& r) { return r.key; };
+
+	double t_std_keys, t_std_recs;
+	{
+		lzstl::vector<unsigned long long> v = keys;
+		auto start = bench_clock::now();
+		std::sort(v.data(), v.data() + v.size());
+		t_std_keys = elapsed_ms(start);
+	}
+	{
+		lzstl::vector<bench_record> v = recs;
+		auto start = bench_clock::now();
+		std::sort(v.data(), v.data() + v.size(), by_key);
+		t_std_recs = elapsed_ms(start);
+	}
+	cout << "n = " << n << "  std::sort: uint64 " << fixed << setprecision(1) << t_std_keys
+	     << " ms, record " << t_std_recs << " ms" << endl;
+	cout << setw(8) << "threads" << setw(16) << "radix u64(ms)" << setw(18) << "radix record(ms)"
+	     << setw(16) << "merge u64(ms)" << setw(18) << "merge record(ms)" << endl;
+
+	for (unsigned nthreads : thread_counts())
+	{
+		double t[4];
+		{
+			lzstl::vector<unsigned long long> v = keys;
+			auto start = bench_clock::now();
+			lzstl::radix_sort(v.begin(), v.end(), nthreads);
+			t[0] = elapsed_ms(start);
+		}
+		{
+			lzstl::vector<bench_record> v = recs;
+			auto start = bench_clock::now();
+			lzstl::radix_sort_by_key(v.begin(), v.end(), key_of, nthreads);
+			t[1] = elapsed_ms(start);
+		}
+		{
+			lzstl::vector<unsigned long long> v = keys;
+			auto start = bench_clock::now();
+			lzstl::parallel_merge_sort(v.begin(), v.end(), lzstl::__sort_less<unsigned long long>(), nthreads);
+			t[2] = elapsed_ms(start);
+		}
+		{
+			lzstl::vector<bench_record> v = recs;
+			auto start = bench_clock::now();
+			lzstl::parallel_merge_sort(v.begin(), v.end(), by_key, nthreads);
+			t[3] = elapsed_ms(start);
+		}
+		cout << setw(8) << nthreads << setw(16) << t[0] << setw(18) << t[1]
+		     << setw(16) << t[2] << setw(18) << t[3] << endl;
+	}
+	cout << endl;
+}
+
+// -------------------------- fill --------------------------
+// 填充带宽（GB/s）：逐元素赋值 对比 uninitialized_fill_n（SIMD，普通存储/非临时存储）
+// 缓冲区预先写过一次，排除缺页的影响；每个大小重复到约 2GB 的总写入量
+void bench_fill()
+{
+	cout << "=== fill 填充带宽 ===" << endl;
+	const char* levels[] = {"none", "SSE2", "AVX2", "AVX-512"};
+	cout << "SIMD: " << levels[lzstl::simd_level()] << ", 非临时存储阈值: "
+	     << (lzstl::nontemporal_threshold() >> 20) << " MB" << endl;
+	cout << setw(10) << "size(MB)" << setw(14) << "loop(GB/s)" << setw(14) << "simd(GB/s)" << setw(18) << "simd+nt(GB/s)" << endl;
+
+	const size_t sizes_mb[] = {1, 8, 64, 512};
+	const size_t old_threshold = lzstl::nontemporal_threshold();
+	for (size_t mb : sizes_mb)
+	{
+		const size_t n = (mb << 20) / sizeof(unsigned);
+		unsigned* buf = static_cast<unsigned*>(lzstl::malloc_alloc::allocate(n * sizeof(unsigned)));
+		memset(buf, 1, n * sizeof(unsigned));
+		const size_t reps = (2048 + mb - 1) / mb;
+		const double gb = double(n * sizeof(unsigned)) * reps / 1e9;
+
+		// 1. 逐元素赋值（原来 POD 分支的写法）
+		auto start = bench_clock::now();
+		for (size_t r = 0; r < reps; ++r)
+		{
+			volatile unsigned* p = buf;
+			for (size_t i = 0; i < n; ++i)
+				p[i] = unsigned(r) | 0x01020300u;
+		}
+		double t_loop = elapsed_ms(start);
+
+		// 2. SIMD，强制普通存储
+		lzstl::set_nontemporal_threshold(size_t(-1));
+		start = bench_clock::now();
+		for (size_t r = 0; r < reps; ++r)
+			lzstl::uninitialized_fill_n(buf, n, unsigned(r) | 0x01020300u);
+		double t_simd = elapsed_ms(start);
+
+		// 3. SIMD，强制非临时存储
+		lzstl::set_nontemporal_threshold(0);
+		start = bench_clock::now();
+		for (size_t r = 0; r < reps; ++r)
+			lzstl::uninitialized_fill_n(buf, n, unsigned(r) | 0x01020300u);
+		double t_nt = elapsed_ms(start);
+		lzstl::set_nontemporal_threshold(old_threshold);
+
+		lzstl::malloc_alloc::deallocate(buf, n * sizeof(unsigned));
+		cout << setw(10) << mb << setw(14) << fixed << setprecision(2) << gb / (t_loop / 1e3)
+		     << setw(14) << gb / (t_simd / 1e3) << setw(18) << gb / (t_nt / 1e3) << endl;
+	}
+	cout << endl;
+}
+
+// -------------------------- copy --------------------------
+// vector<long long> 拷贝构造的带宽（GB/s）：普通存储（memcpy）对比 非临时存储
+// 源数据已经在内存中，目标每次都是新分配的，包含缺页时间，更接近真实的拷贝/扩容
+void bench_copy()
+{
+	cout << "=== copy vector 拷贝带宽 ===" << endl;
+	cout << setw(10) << "size(MB)" << setw(16) << "memcpy(GB/s)" << setw(14) << "nt(GB/s)" << endl;
+
+	const size_t sizes_mb[] = {1, 8, 64, 512};
+	const size_t old_threshold = lzstl::nontemporal_threshold();
+	for (size_t mb : sizes_mb)
+	{
+		const size_t n = (mb << 20) / sizeof(long long);
+		lzstl::vector<long long> src(n, 12345);
+		const size_t reps = (2048 + mb - 1) / mb;
+		const double gb = double(n * sizeof(long long)) * reps / 1e9;
+		double t[2];
+		for (int nt = 0; nt < 2; ++nt)
+		{
+			lzstl::set_nontemporal_threshold(nt ? 0 : size_t(-1));
+			auto start = bench_clock::now();
+			for (size_t r = 0; r < reps; ++r)
+			{
+				lzstl::vector<long long> dst(src);
+				if (dst[n - 1] != 12345) cout << "error" << endl;
+			}
+			t[nt] = elapsed_ms(start);
+		}
+		lzstl::set_nontemporal_threshold(old_threshold);
+		cout << setw(10) << mb << setw(16) << fixed << setprecision(2) << gb / (t[0] / 1e3)
+		     << setw(14) << gb / (t[1] / 1e3) << endl;
+	}
+	cout << endl;
+}
+
+// -------------------------- ready --------------------------
+// 构造一个大 vector 直到可用的时间（包括缺页）：vector(n, value)、拷贝构造、resize
+// 单线程（关闭并行阈值）对比 默认线程池并行 first-touch
+// 大小默认 4096MB，可用环境变量 LZ_BENCH_READY_MB 调整
+void bench_ready()
+{
+	size_t mb = 4096;
+	if (const char* env = getenv("LZ_BENCH_READY_MB"))
+		mb = strtoull(env, nullptr, 10);
+	const size_t n = (mb << 20) / sizeof(unsigned long long);
+	cout << "=== ready " << mb << "MB vector 就绪时间 ===" << endl;
+	cout << "线程池并发数: " << lzstl::default_thread_pool().concurrency() << endl;
+	cout << setw(10) << "mode" << setw(16) << "fill ctor(ms)" << setw(16) << "copy ctor(ms)" << setw(14) << "resize(ms)" << endl;
+
+	const size_t old_threshold = lzstl::parallel_uninitialized_threshold();
+	for (int parallel = 0; parallel < 2; ++parallel)
+	{
+		lzstl::set_parallel_uninitialized_threshold(parallel ? old_threshold : size_t(-1));
+		double t[3];
+		{
+			auto start = bench_clock::now();
+			lzstl::vector<unsigned long long> v(n, 0x0102030405060708ULL);
+			t[0] = elapsed_ms(start);
+
+			start = bench_clock::now();
+			lzstl::vector<unsigned long long> c(v);
+			t[1] = elapsed_ms(start);
+			if (c[n - 1] != v[n - 1]) cout << "error" << endl;
+		}
+		{
+			lzstl::vector<unsigned long long> v;
+			auto start = bench_clock::now();
+			v.resize(n, 3);
+			t[2] = elapsed_ms(start);
+		}
+		cout << setw(10) << (parallel ? "parallel" : "serial") << setw(16) << fixed << setprecision(1) << t[0]
+		     << setw(16) << t[1] << setw(14) << t[2] << endl;
+	}
+	lzstl::set_parallel_uninitialized_threshold(old_threshold);
+	cout << endl;
+}
+
+// -------------------------- algorithm --------------------------
+// 扫描速度（G 元素/s）：std 版本 对比 lzstl 的 SIMD 版本
+// find 找的是不存在的值（扫完整个区间），equal 比较两份相同的数据，lexicographical_compare 只在最后一个元素不同
+// 每个大小重复到约 5 亿个元素的总扫描量
+template <typename T>
+static void bench_algorithm_type(const char* name)
+{
+	cout << "-- " << name << " --" << endl;
+	cout << setw(10) << "n" << setw(10) << "algo" << setw(12) << "std" << setw(12) << "lzstl" << setw(10) << "speedup" << endl;
+	const size_t sizes[] = {size_t(1) << 12, size_t(1) << 16, size_t(1) << 22};
+	for (size_t n : sizes)
+	{
+		lzstl::vector<T> a(n), b(n);
+		for (size_t i = 0; i < n; ++i)
+			a[i] = b[i] = T(i % 97);
+		b[n - 1] = T(b[n - 1] + 1);
+		const T* p = a.data();
+		const T* q = b.data();
+		const size_t reps = (size_t(1) << 29) / n;
+		const double g = double(n) * reps / 1e9;
+		volatile size_t sink = 0;
+
+		auto run = [&](const char* algo, auto std_version, auto lz_version)
+		{
+			auto start = bench_clock::now();
+			for (size_t r = 0; r < reps; ++r)
+				sink = sink + size_t(std_version());
+			double t_std = elapsed_ms(start);
+			start = bench_clock::now();
+			for (size_t r = 0; r < reps; ++r)
+				sink = sink + size_t(lz_version());
+			double t_lz = elapsed_ms(start);
+			cout << setw(10) << n << setw(10) << algo << setw(12) << fixed << setprecision(2) << g / (t_std / 1e3)
+			     << setw(12) << g / (t_lz / 1e3) << setw(9) << t_std / t_lz << "x" << endl;
+		};
+		const T missing = T(100);
+		run("find", [&] { return std::find(p, p + n, missing) - p; }, [&] { return lzstl::find(p, p + n, missing) - p; });
+		run("count", [&] { return std::count(p, p + n, T(5)); }, [&] { return lzstl::count(p, p + n, T(5)); });
+		run("equal", [&] { return std::equal(p, p + n - 1, q); }, [&] { return lzstl::equal(p, p + n - 1, q); });
+		run("lexcmp", [&] { return std::lexicographical_compare(p, p + n, q, q + n); },
+		    [&] { return lzstl::lexicographical_compare(p, p + n, q, q + n); });
+		run("min", [&] { return std::min_element(p, p + n) - p; }, [&] { return lzstl::min_element(p, p + n) - p; });
+		run("max", [&] { return std::max_element(p, p + n) - p; }, [&] { return lzstl::max_element(p, p + n) - p; });
+	}
+}
+
+void bench_algorithm()
+{
+	cout << "=== algorithm 扫描速度（G 元素/s）===" << endl;
+	const char* levels[] = {"none", "SSE2", "AVX2", "AVX-512"};
+	cout << "SIMD: " << levels[lzstl::__algorithm_simd_level()] << endl;
+	bench_algorithm_type<int>("int");
+	bench_algorithm_type<unsigned char>("unsigned char");
+	bench_algorithm_type<double>("double");
+	cout << endl;
+}
+
+// -------------------------- deque --------------------------
+// 队列负载（M 次操作/s）：std::deque 对比 lzstl::deque
+// fifo：保持 window 个元素，每次 push_back + pop_front（稳态下块在空闲块栈里循环）
+// burst：一次压入 n 个再全部弹出，重复多轮
+// steal：工作窃取，拥有者在尾部进出，窃取者每 4 次从头部取一个
+// scan：按下标随机访问求和
+template <typename Deque>
+static double bench_deque_workload(int kind, size_t n, size_t ops)
+{
+	Deque d;
+	long long sum = 0;
+	auto start = bench_clock::now();
+	if (kind == 0)
+	{
+		for (size_t i = 0; i < n; ++i) d.push_back(int(i));
+		for (size_t i = 0; i < ops; ++i)
+		{
+			d.push_back(int(i));
+			sum += d.front();
+			d.pop_front();
+		}
+	}
+	else if (kind == 1)
+	{
+		for (size_t r = 0; r < ops / n; ++r)
+		{
+			for (size_t i = 0; i < n; ++i) d.push_back(int(i));
+			while (!d.empty()) { sum += d.front(); d.pop_front(); }
+		}
+	}
+	else if (kind == 2)
+	{
+		for (size_t i = 0; i < ops; ++i)
+		{
+			d.push_back(int(i));
+			if (i % 4 == 3) { sum += d.front(); d.pop_front(); }
+			else if (i % 4 == 2) { sum += d.back(); d.pop_back(); }
+			if (d.size() > n) { sum += d.front(); d.pop_front(); }
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < n; ++i) d.push_back(int(i));
+		start = bench_clock::now();
+		for (size_t r = 0; r < ops / n; ++r)
+			for (size_t i = 0; i < n; ++i)
+				sum += d[i];
+	}
+	double t = elapsed_ms(start);
+	volatile long long sink = sum;
+	(void)sink;
+	return double(ops) / (t * 1e3);
+}
+
+void bench_deque()
+{
+	cout << "=== deque 队列负载（M 次操作/s）===" << endl;
+	cout << setw(8) << "work" << setw(10) << "n" << setw(12) << "std" << setw(12) << "lzstl" << setw(10) << "speedup" << endl;
+	const char* names[] = {"fifo", "burst", "steal", "scan"};
+	const size_t sizes[] = {64, 4096, size_t(1) << 20};
+	const size_t ops = size_t(1) << 25;
+	for (int kind = 0; kind < 4; ++kind)
+		for (size_t n : sizes)
+		{
+			double s = bench_deque_workload<std::deque<int>>(kind, n, ops);
+			double l = bench_deque_workload<lzstl::deque<int>>(kind, n, ops);
+			cout << setw(8) << names[kind] << setw(10) << n << setw(12) << fixed << setprecision(1) << s
+			     << setw(12) << l << setw(9) << setprecision(2) << l / s << "x" << endl;
+		}
+	cout << endl;
+}
+
+// -------------------------- list --------------------------
+// 节点分配与链表操作（ms）：std::list 对比 lzstl::list
+// build：push_back n 个再析构；churn：保持 n 个元素，反复删头插尾（节点缓存循环使用）
+// splice：两个 list 之间来回搬单个节点和整段；sort：随机数据排序
+template <typename List>
+static double bench_list_workload(int kind, size_t n)
+{
+	long long sum = 0;
+	auto start = bench_clock::now();
+	if (kind == 0)
+	{
+		for (int r = 0; r < 10; ++r)
+		{
+			List l;
+			for (size_t i = 0; i < n; ++i) l.push_back(int(i));
+			sum += l.back();
+		}
+	}
+	else if (kind == 1)
+	{
+		List l;
+		for (size_t i = 0; i < n; ++i) l.push_back(int(i));
+		start = bench_clock::now();
+		for (size_t i = 0; i < 10 * n; ++i)
+		{
+			sum += l.front();
+			l.pop_front();
+			l.push_back(int(i));
+		}
+	}
+	else if (kind == 2)
+	{
+		List a, b;
+		for (size_t i = 0; i < n; ++i) a.push_back(int(i));
+		start = bench_clock::now();
+		for (size_t i = 0; i < 10 * n; ++i)
+		{
+			b.splice(b.end(), a, a.begin());
+			if (a.empty()) a.splice(a.end(), b);
+		}
+		sum += a.size();
+	}
+	else
+	{
+		List l;
+		unsigned x = 12345;
+		for (size_t i = 0; i < n; ++i) { x = x * 1103515245u + 12345u; l.push_back(int(x >> 8)); }
+		start = bench_clock::now();
+		l.sort();
+		sum += l.front();
+	}
+	double t = elapsed_ms(start);
+	volatile long long sink = sum;
+	(void)sink;
+	return t;
+}
+
+void bench_list()
+{
+	cout << "=== list 节点操作（ms）===" << endl;
+	cout << setw(8) << "work" << setw(10) << "n" << setw(12) << "std" << setw(12) << "lzstl" << setw(10) << "speedup" << endl;
+	const char* names[] = {"build", "churn", "splice", "sort"};
+	const size_t sizes[] = {1000, size_t(1) << 20};
+	for (int kind = 0; kind < 4; ++kind)
+		for (size_t n : sizes)
+		{
+			double s = bench_list_workload<std::list<int>>(kind, n);
+			double l = bench_list_workload<lzstl::list<int>>(kind, n);
+			cout << setw(8) << names[kind] << setw(10) << n << setw(12) << fixed << setprecision(2) << s
+			     << setw(12) << l << setw(9) << s / l << "x" << endl;
+		}
+	cout << endl;
+}
+
+// -------------------------- flat_hash_map --------------------------
+// 每次操作的平均耗时（ns）：std::unordered_map 对比 lzstl::flat_hash_map，键是随机的 64 位整数
+// insert 不预先 reserve（包含扩容）；hit/miss 是命中/不命中的查找；erase 删除全部键
+// 默认测到 1000 万个元素；1 亿个元素时 std::unordered_map 需要约 5GB 内存，需要时把 sizes 改大
+static unsigned long long bench_splitmix(unsigned long long& state)
+{
+	unsigned long long z = (state += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+template <typename Map>
+static void bench_hash_workload(size_t n, const std::vector<unsigned long long>& keys,
+                                const std::vector<unsigned long long>& missing, double* t)
+{
+	long long sum = 0;
+	Map m;
+	auto start = bench_clock::now();
+	for (size_t i = 0; i < n; ++i) m[keys[i]] = (long long)i;
+	t[0] = elapsed_ms(start) * 1e6 / double(n);
+	// 查找顺序与插入顺序无关
+	start = bench_clock::now();
+	for (size_t i = 0; i < n; ++i)
+	{
+		auto it = m.find(keys[(i * 7919) % n]);
+		sum += it->second;
+	}
+	t[1] = elapsed_ms(start) * 1e6 / double(n);
+	start = bench_clock::now();
+	for (size_t i = 0; i < n; ++i) sum += (long long)m.count(missing[i]);
+	t[2] = elapsed_ms(start) * 1e6 / double(n);
+	start = bench_clock::now();
+	for (size_t i = 0; i < n; ++i) sum += (long long)m.erase(keys[i]);
+	t[3] = elapsed_ms(start) * 1e6 / double(n);
+	volatile long long sink = sum;
+	(void)sink;
+}
+
+void bench_flat_hash_map()
+{
+	cout << "=== flat_hash_map 每次操作耗时（ns）===" << endl;
+	cout << setw(10) << "n" << setw(8) << "op" << setw(12) << "std" << setw(12) << "lzstl" << setw(10) << "speedup" << endl;
+	const size_t sizes[] = {1000, 100000, 10000000};
+	const char* ops[] = {"insert", "hit", "miss", "erase"};
+	for (size_t n : sizes)
+	{
+		std::vector<unsigned long long> keys(n), missing(n);
+		unsigned long long state = n;
+		for (size_t i = 0; i < n; ++i) { keys[i] = bench_splitmix(state); missing[i] = bench_splitmix(state); }
+		// 小规模重复多轮，取总平均
+		size_t rounds = n < 100000 ? 200 : 1;
+		double ts[4] = {0, 0, 0, 0}, tl[4] = {0, 0, 0, 0};
+		for (size_t r = 0; r < rounds; ++r)
+		{
+			double a[4], b[4];
+			bench_hash_workload<std::unordered_map<unsigned long long, long long>>(n, keys, missing, a);
+			bench_hash_workload<lzstl::flat_hash_map<unsigned long long, long long>>(n, keys, missing, b);
+			for (int k = 0; k < 4; ++k) { ts[k] += a[k] / double(rounds); tl[k] += b[k] / double(rounds); }
+		}
+		for (int k = 0; k < 4; ++k)
+			cout << setw(10) << n << setw(8) << ops[k] << setw(12) << fixed << setprecision(1) << ts[k]
+			     << setw(12) << tl[k] << setw(9) << setprecision(2) << ts[k] / tl[k] << "x" << endl;
+	}
+	cout << endl;
+}
+
+// -------------------------- flat_map --------------------------
+// 随机查找（ns/次）：std::map、flat_map + 自定义比较器（无分支二分）、flat_map<int>（二分 + SIMD 窗口）
+// build：n 个随机键的建表时间（std::map 逐个插入，flat_map 一次批量插入）
+struct bench_int_less
+{
+	bool operator()(int a, int b) const { return a < b; }
+};
+
+void bench_flat_map()
+{
+	cout << "=== flat_map 查找（ns/次）与建表（ms）===" << endl;
+	cout << setw(10) << "n" << setw(12) << "std::map" << setw(12) << "branchless" << setw(10) << "simd"
+	     << setw(10) << "speedup" << setw(14) << "build std" << setw(12) << "build flat" << endl;
+	const size_t sizes[] = {1000, 65536, size_t(1) << 20, size_t(1) << 23};
+	for (size_t n : sizes)
+	{
+		std::vector<int> keys(n);
+		unsigned long long state = n;
+		for (size_t i = 0; i < n; ++i) keys[i] = int(bench_splitmix(state) >> 33);
+		std::vector<std::pair<int, int>> kv(n);
+		for (size_t i = 0; i < n; ++i) kv[i] = std::make_pair(keys[i], int(i));
+
+		auto start = bench_clock::now();
+		std::map<int, int> sm(kv.begin(), kv.end());
+		double build_std = elapsed_ms(start);
+		start = bench_clock::now();
+		lzstl::flat_map<int, int> fm(kv.begin(), kv.end());
+		double build_flat = elapsed_ms(start);
+		lzstl::flat_map<int, int, bench_int_less> gm(kv.begin(), kv.end());
+
+		const size_t lookups = size_t(1) << 22;
+		std::vector<int> probe(lookups);
+		for (size_t i = 0; i < lookups; ++i) probe[i] = keys[bench_splitmix(state) % n];
+		long long sum = 0;
+		start = bench_clock::now();
+		for (size_t i = 0; i < lookups; ++i) sum += sm.find(probe[i])->second;
+		double t_std = elapsed_ms(start) * 1e6 / double(lookups);
+		start = bench_clock::now();
+		for (size_t i = 0; i < lookups; ++i) sum += gm.find(probe[i])->second;
+		double t_bl = elapsed_ms(start) * 1e6 / double(lookups);
+		start = bench_clock::now();
+		for (size_t i = 0; i < lookups; ++i) sum += fm.find(probe[i])->second;
+		double t_simd = elapsed_ms(start) * 1e6 / double(lookups);
+		volatile long long sink = sum;
+		(void)sink;
+
+		cout << setw(10) << n << setw(12) << fixed << setprecision(1) << t_std << setw(12) << t_bl << setw(10) << t_simd
+		     << setw(9) << setprecision(2) << t_std / t_simd << "x" << setw(14) << setprecision(1) << build_std
+		     << setw(12) << build_flat << endl;
+	}
+	cout << endl;
+}
+
+// 同一组键分别插入 std::map 和 btree_map：插入、查找按 ns/次，顺序遍历按 ms
+static void bench_btree_workload(const char* name, const std::vector<int>& keys)
+{
+	size_t n = keys.size();
+	auto start = bench_clock::now();
+	std::map<int, int> sm;
+	for (size_t i = 0; i < n; ++i) sm.emplace(keys[i], int(i));
+	double ins_std = elapsed_ms(start) * 1e6 / double(n);
+	start = bench_clock::now();
+	lzstl::btree_map<int, int> bm;
+	for (size_t i = 0; i < n; ++i) bm.insert(std::pair<const int, int>(keys[i], int(i)));
+	double ins_bt = elapsed_ms(start) * 1e6 / double(n);
+
+	const size_t lookups = size_t(1) << 22;
+	std::vector<int> probe(lookups);
+	unsigned long long state = n + 1;
+	for (size_t i = 0; i < lookups; ++i) probe[i] = keys[bench_splitmix(state) % n];
+	long long sum = 0;
+	start = bench_clock::now();
+	for (size_t i = 0; i < lookups; ++i) sum += sm.find(probe[i])->second;
+	double find_std = elapsed_ms(start) * 1e6 / double(lookups);
+	start = bench_clock::now();
+	for (size_t i = 0; i < lookups; ++i) sum += bm.find(probe[i])->second;
+	double find_bt = elapsed_ms(start) * 1e6 / double(lookups);
+
+	start = bench_clock::now();
+	for (std::map<int, int>::const_iterator it = sm.begin(); it != sm.end(); ++it) sum += it->second;
+	double scan_std = elapsed_ms(start);
+	start = bench_clock::now();
+	for (lzstl::btree_map<int, int>::const_iterator it = bm.begin(); it != bm.end(); ++it) sum += it->second;
+	double scan_bt = elapsed_ms(start);
+	volatile long long sink = sum;
+	(void)sink;
+
+	cout << setw(12) << name << setw(12) << fixed << setprecision(1) << ins_std << setw(12) << ins_bt
+	     << setw(12) << find_std << setw(12) << find_bt << setw(12) << scan_std << setw(12) << scan_bt
+	     << setw(8) << bm.height() << endl;
+}
+
+void bench_btree()
+{
+	const size_t n = 10000000;
+	cout << "=== btree_map vs std::map，" << n << " 个 int 键（插入/查找 ns/次，遍历 ms）===" << endl;
+	cout << setw(12) << "keys" << setw(12) << "ins std" << setw(12) << "ins btree" << setw(12) << "find std"
+	     << setw(12) << "find btree" << setw(12) << "scan std" << setw(12) << "scan btree" << setw(8) << "height" << endl;
+	std::vector<int> keys(n);
+	unsigned long long state = 42;
+	for (size_t i = 0; i < n; ++i) keys[i] = int(bench_splitmix(state) >> 33);
+	bench_btree_workload("random", keys);
+	for (size_t i = 0; i < n; ++i) keys[i] = int(i);
+	bench_btree_workload("sequential", keys);
+
+	// 有序输入的批量插入：追加到最右边，节点全满
+	std::vector<std::pair<int, int>> kv(n);
+	for (size_t i = 0; i < n; ++i) kv[i] = std::make_pair(int(i), int(i));
+	auto start = bench_clock::now();
+	std::map<int, int> sm(kv.begin(), kv.end());
+	double bulk_std = elapsed_ms(start);
+	start = bench_clock::now();
+	lzstl::btree_map<int, int> bm(kv.begin(), kv.end());
+	double bulk_bt = elapsed_ms(start);
+	cout << "有序批量构造: std::map " << setprecision(1) << bulk_std << " ms, btree_map " << bulk_bt
+	     << " ms（树高 " << bm.height() << "）" << endl << endl;
+}
+
+// -------------------------- spsc_ring --------------------------
+// 一个生产者线程交给一个消费者线程 n 个整数，返回每秒百万个（Mops/s）；对方没准备好时 yield
+static double bench_spsc_throughput(int kind, size_t n)
+{
+	long long sum = 0;
+	auto start = bench_clock::now();
+	if (kind == 0)
+	{
+		std::deque<size_t> dq;
+		std::mutex mtx;
+		std::thread producer([&]() {
+			for (size_t i = 0; i < n; ++i)
+			{
+				lock_guard<std::mutex> lock(mtx);
+				dq.push_back(i);
+			}
+		});
+		for (size_t got = 0; got < n; )
+		{
+			bool popped = false;
+			{
+				lock_guard<std::mutex> lock(mtx);
+				if (!dq.empty())
+				{
+					sum += dq.front();
+					dq.pop_front();
+					popped = true;
+				}
+			}
+			if (popped) ++got;
+			else std::this_thread::yield();
+		}
+		producer.join();
+	}
+	else if (kind == 1)
+	{
+		lzstl::spsc_ring<size_t> ring(4096);
+		std::thread producer([&]() {
+			for (size_t i = 0; i < n; )
+			{
+				if (ring.try_push(i)) ++i;
+				else std::this_thread::yield();
+			}
+		});
+		size_t v;
+		for (size_t got = 0; got < n; )
+		{
+			if (ring.try_pop(v)) { sum += v; ++got; }
+			else std::this_thread::yield();
+		}
+		producer.join();
+	}
+	else
+	{
+		const size_t batch = 64;
+		lzstl::spsc_ring<size_t> ring(4096);
+		std::thread producer([&]() {
+			size_t buf[batch];
+			for (size_t i = 0; i < n; )
+			{
+				size_t k = n - i < batch ? n - i : batch;
+				for (size_t j = 0; j < k; ++j) buf[j] = i + j;
+				size_t put = ring.push_n(buf, k);
+				i += put;
+				if (put < k) std::this_thread::yield();
+			}
+		});
+		size_t buf[batch];
+		for (size_t got = 0; got < n; )
+		{
+			size_t k = ring.pop_n(buf, batch);
+			for (size_t j = 0; j < k; ++j) sum += buf[j];
+			got += k;
+			if (k == 0) std::this_thread::yield();
+		}
+		producer.join();
+	}
+	double ms = elapsed_ms(start);
+	volatile long long sink = sum;
+	(void)sink;
+	return double(n) / ms / 1000.0;
+}
+
+// 两个环一来一回，返回往返一次的平均 ns
+static double bench_spsc_latency(size_t rounds)
+{
+	lzstl::spsc_ring<size_t> ping(64), pong(64);
+	std::thread echo([&]() {
+		size_t v;
+		for (size_t i = 0; i < rounds; ++i)
+		{
+			while (!ping.try_pop(v)) std::this_thread::yield();
+			while (!pong.try_push(v)) std::this_thread::yield();
+		}
+	});
+	auto start = bench_clock::now();
+	size_t v;
+	for (size_t i = 0; i < rounds; ++i)
+	{
+		while (!ping.try_push(i)) std::this_thread::yield();
+		while (!pong.try_pop(v)) std::this_thread::yield();
+	}
+	double ns = elapsed_ms(start) * 1e6 / double(rounds);
+	echo.join();
+	return ns;
+}
+
+void bench_spsc_ring()
+{
+	const size_t n = 20000000;
+	cout << "=== spsc_ring 单生产者单消费者，" << n << " 个元素（Mops/s）===" << endl;
+	cout << setw(18) << "mutex+deque" << setw(18) << "spsc try_push" << setw(18) << "spsc push_n(64)" << endl;
+	double t0 = bench_spsc_throughput(0, n);
+	double t1 = bench_spsc_throughput(1, n);
+	double t2 = bench_spsc_throughput(2, n);
+	cout << setw(18) << fixed << setprecision(1) << t0 << setw(18) << t1 << setw(18) << t2 << endl;
+	cout << "往返延迟: " << setprecision(0) << bench_spsc_latency(200000) << " ns" << endl << endl;
+}
+
+// -------------------------- mpmc_queue --------------------------
+// nthreads 个线程，每个线程交替入队一个、出队一个，共 total 对；返回每秒百万次操作（入队和出队各算一次）
+static double bench_mpmc_workload(bool lockfree, unsigned nthreads, size_t total)
+{
+	size_t per = total / nthreads;
+	lzstl::mpmc_queue<size_t> q(1024);
+	std::deque<size_t> dq;
+	std::mutex mtx;
+	std::atomic<size_t> checksum(0);
+	std::vector<thread> workers;
+	auto start = bench_clock::now();
+	for (unsigned t = 0; t < nthreads; ++t)
+		workers.emplace_back([&, t]() {
+			size_t sum = 0, v = 0;
+			for (size_t i = 0; i < per; ++i)
+			{
+				if (lockfree)
+				{
+					q.push(t + i);
+					q.pop(v);
+				}
+				else
+				{
+					lock_guard<std::mutex> lock(mtx);
+					dq.push_back(t + i);
+					v = dq.front();
+					dq.pop_front();
+				}
+				sum += v;
+			}
+			checksum.fetch_add(sum);
+		});
+	for (auto& w : workers) w.join();
+	double ms = elapsed_ms(start);
+	volatile size_t sink = checksum.load();
+	(void)sink;
+	return 2.0 * double(per * nthreads) / ms / 1000.0;
+}
+
+void bench_mpmc_queue()
+{
+	const size_t total = 2000000;
+	cout << "=== mpmc_queue 多线程争用，每线程交替入队/出队（Mops/s）===" << endl;
+	cout << setw(8) << "threads" << setw(16) << "mutex+deque" << setw(14) << "mpmc_queue" << setw(10) << "speedup" << endl;
+	for (unsigned t = 1; t <= 64; t *= 2)
+	{
+		double m = bench_mpmc_workload(false, t, total);
+		double l = bench_mpmc_workload(true, t, total);
+		cout << setw(8) << t << setw(16) << fixed << setprecision(1) << m << setw(14) << l
+		     << setw(9) << setprecision(2) << l / m << "x" << endl;
+	}
+	cout << endl;
+}
+
+// -------------------------- priority_queue --------------------------
+// 逐个 push n 个随机数再全部 pop；返回毫秒
+template <typename Q>
+static double bench_heap_push_pop(const std::vector<unsigned>& keys)
+{
+	auto start = bench_clock::now();
+	Q q;
+	for (unsigned k : keys) q.push(k);
+	unsigned long long sum = 0;
+	while (!q.empty())
+	{
+		sum += q.top();
+		q.pop();
+	}
+	double ms = elapsed_ms(start);
+	volatile unsigned long long sink = sum;
+	(void)sink;
+	return ms;
+}
+
+// std::priority_queue 只能先 pop 再 push；lzstl 用 replace_top 一次下滤
+static void bench_heap_replace(std::priority_queue<unsigned>& q, unsigned v)
+{
+	q.pop();
+	q.push(v);
+}
+
+template <size_t Arity>
+static void bench_heap_replace(lzstl::priority_queue<unsigned, std::less<unsigned>, Arity>& q, unsigned v)
+{
+	q.replace_top(v);
+}
+
+// 保持堆的大小不变，反复取出堆顶、放入一个比它小的新键（事件模拟的"hold"模型）；返回毫秒
+template <typename Q>
+static double bench_heap_hold(const std::vector<unsigned>& keys, size_t ops)
+{
+	Q q;
+	for (unsigned k : keys) q.push(k);
+	unsigned long long state = 7, sum = 0;
+	auto start = bench_clock::now();
+	for (size_t i = 0; i < ops; ++i)
+	{
+		unsigned t = q.top();
+		unsigned next = t - unsigned(bench_splitmix(state) % 1024);
+		bench_heap_replace(q, next);
+		sum += t;
+	}
+	double ms = elapsed_ms(start);
+	volatile unsigned long long sink = sum;
+	(void)sink;
+	return ms;
+}
+
+void bench_priority_queue()
+{
+	typedef std::priority_queue<unsigned> std_heap;
+	typedef lzstl::priority_queue<unsigned, std::less<unsigned>, 2> heap2;
+	typedef lzstl::priority_queue<unsigned, std::less<unsigned>, 4> heap4;
+	typedef lzstl::priority_queue<unsigned, std::less<unsigned>, 8> heap8;
+	cout << "=== priority_queue d 叉堆 vs std::priority_queue（ms）===" << endl;
+	cout << setw(22) << "workload" << setw(10) << "n" << setw(10) << "std" << setw(10) << "lz 2"
+	     << setw(10) << "lz 4" << setw(10) << "lz 8" << endl;
+	const size_t sizes[] = {100000, 1000000, 4000000};
+	for (size_t n : sizes)
+	{
+		std::vector<unsigned> keys(n);
+		unsigned long long state = n;
+		for (size_t i = 0; i < n; ++i) keys[i] = unsigned(bench_splitmix(state));
+		cout << setw(22) << "push all + pop all" << setw(10) << n << fixed << setprecision(1)
+		     << setw(10) << bench_heap_push_pop<std_heap>(keys) << setw(10) << bench_heap_push_pop<heap2>(keys)
+		     << setw(10) << bench_heap_push_pop<heap4>(keys) << setw(10) << bench_heap_push_pop<heap8>(keys) << endl;
+		const size_t ops = 2000000;
+		cout << setw(22) << "hold (replace_top)" << setw(10) << n
+		     << setw(10) << bench_heap_hold<std_heap>(keys, ops) << setw(10) << bench_heap_hold<heap2>(keys, ops)
+		     << setw(10) << bench_heap_hold<heap4>(keys, ops) << setw(10) << bench_heap_hold<heap8>(keys, ops) << endl;
+	}
+	cout << endl;
+}
+
+// -------------------------- string --------------------------
+// 长度在 [lo, hi] 的随机串，逐个复制构造进 vector 再全部析构；返回毫秒
+template <typename Str, typename Vec>
+static double bench_string_copy(const std::vector<std::string>& src)
+{
+	auto start = bench_clock::now();
+	size_t total = 0;
+	for (int round = 0; round < 5; ++round)
+	{
+		Vec v;
+		v.reserve(src.size());
+		for (const std::string& s : src) v.push_back(Str(s.data(), s.size()));
+		total += v.back().size();
+	}
+	double ms = elapsed_ms(start);
+	volatile size_t sink = total;
+	(void)sink;
+	return ms;
+}
+
+// 每个串从空开始一小段一小段 append 到 len 字节，扩容时长串走 reallocate；返回毫秒
+template <typename Str>
+static double bench_string_append(size_t count, size_t len)
+{
+	const char piece[] = "0123456789abcdef";
+	auto start = bench_clock::now();
+	size_t total = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		Str s;
+		while (s.size() < len) s.append(piece, 1 + (i + s.size()) % 16);
+		total += s.size();
+	}
+	double ms = elapsed_ms(start);
+	volatile size_t sink = total;
+	(void)sink;
+	return ms;
+}
+
+// 在 text 里从头到尾数 needle 出现的次数；返回毫秒
+template <typename Str>
+static double bench_string_find(const Str& text, const char* needle, size_t& hits)
+{
+	auto start = bench_clock::now();
+	size_t n = std::strlen(needle);
+	hits = 0;
+	for (int round = 0; round < 5; ++round)
+		for (size_t pos = text.find(needle, 0, n); pos != Str::npos; pos = text.find(needle, pos + 1, n))
+			++hits;
+	return elapsed_ms(start);
+}
+
+// 不预留容量，逐个 push_back：扩容时每个元素都要搬一次；返回毫秒
+template <typename Str, typename Vec>
+static double bench_string_vector_growth(const std::vector<std::string>& src)
+{
+	auto start = bench_clock::now();
+	Vec v;
+	for (const std::string& s : src) v.push_back(Str(s.data(), s.size()));
+	size_t total = v.size();
+	double ms = elapsed_ms(start);
+	volatile size_t sink = total;
+	(void)sink;
+	return ms;
+}
+
+void bench_string()
+{
+	typedef std::vector<std::string> std_vec;
+	typedef lzstl::vector<lzstl::string> lz_vec;
+	cout << "=== string（SSO 23 字节 + 二级配置器）vs std::string（ms）===" << endl;
+	cout << setw(34) << "workload" << setw(14) << "std::string" << setw(14) << "lzstl::string" << endl;
+	unsigned long long state = 99;
+	const size_t ranges[][2] = {{4, 15}, {16, 23}, {24, 120}, {200, 1000}};
+	for (const auto& r : ranges)
+	{
+		std::vector<std::string> src(1000000);
+		for (std::string& s : src) s.assign(r[0] + bench_splitmix(state) % (r[1] - r[0] + 1), 'a' + char(state % 26));
+		char name[64];
+		std::snprintf(name, sizeof(name), "copy 1M, len %zu..%zu", r[0], r[1]);
+		cout << setw(34) << name << fixed << setprecision(1)
+		     << setw(14) << bench_string_copy<std::string, std_vec>(src)
+		     << setw(14) << bench_string_copy<lzstl::string, lz_vec>(src) << endl;
+		std::snprintf(name, sizeof(name), "vector growth 1M, len %zu..%zu", r[0], r[1]);
+		cout << setw(34) << name
+		     << setw(14) << bench_string_vector_growth<std::string, std_vec>(src)
+		     << setw(14) << bench_string_vector_growth<lzstl::string, lz_vec>(src) << endl;
+	}
+	const size_t lens[] = {64, 120, 4096};
+	for (size_t len : lens)
+	{
+		char name[64];
+		std::snprintf(name, sizeof(name), "append to %zu bytes x 200k", len);
+		cout << setw(34) << name
+		     << setw(14) << bench_string_append<std::string>(200000, len)
+		     << setw(14) << bench_string_append<lzstl::string>(200000, len) << endl;
+	}
+	// 16MB 随机小写文本，找单字符、短子串、长子串
+	std::string stext(16 << 20, ' ');
+	for (char& c : stext) c = char('a' + bench_splitmix(state) % 26);
+	lzstl::string ltext(stext.data(), stext.size());
+	const char* needles[] = {"q", "xyz", "needle in a haystack"};
+	for (const char* nd : needles)
+	{
+		size_t h1 = 0, h2 = 0;
+		double t1 = bench_string_find(stext, nd, h1);
+		double t2 = bench_string_find(ltext, nd, h2);
+		char name[64];
+		std::snprintf(name, sizeof(name), "find \"%s\" in 16MB", nd);
+		cout << setw(34) << name << setw(14) << t1 << setw(14) << t2 << (h1 == h2 ? "" : "  (结果不一致)") << endl;
+	}
+	cout << endl;
+}
+
+// -------------------------- static_vector --------------------------
+// n 个节点，每个节点有 0..8 个邻居：建表再遍历求和；返回 {建表毫秒, 遍历毫秒}
+template <typename Outer>
+static std::pair<double, double> bench_fanout(size_t n)
+{
+	unsigned long long state = 5;
+	auto start = bench_clock::now();
+	Outer adj(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		size_t deg = bench_splitmix(state) % 9;
+		for (size_t k = 0; k < deg; ++k) adj[i].push_back(int(bench_splitmix(state) % n));
+	}
+	double build = elapsed_ms(start);
+	start = bench_clock::now();
+	const Outer& cadj = adj;
+	unsigned long long sum = 0;
+	for (int round = 0; round < 5; ++round)
+		for (size_t i = 0; i < n; ++i)
+			for (int x : cadj[i]) sum += size_t(x) ^ i;
+	double walk = elapsed_ms(start);
+	volatile unsigned long long sink = sum;
+	(void)sink;
+	return std::make_pair(build, walk);
+}
+
+void bench_static_vector()
+{
+	const size_t n = 2000000;
+	cout << "=== static_vector 小扇出邻接表：" << n << " 个节点，每个 0..8 个邻居（ms）===" << endl;
+	cout << setw(34) << "inner container" << setw(10) << "build" << setw(10) << "walk x5" << endl;
+	std::pair<double, double> r = bench_fanout<std::vector<std::vector<int>>>(n);
+	cout << setw(34) << "std::vector<int>" << fixed << setprecision(1) << setw(10) << r.first << setw(10) << r.second << endl;
+	r = bench_fanout<lzstl::vector<lzstl::vector<int>>>(n);
+	cout << setw(34) << "lzstl::vector<int>" << setw(10) << r.first << setw(10) << r.second << endl;
+	r = bench_fanout<lzstl::vector<lzstl::static_vector<int, 8>>>(n);
+	cout << setw(34) << "lzstl::static_vector<int, 8>" << setw(10) << r.first << setw(10) << r.second << endl;
+	cout << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	struct bench_entry
+	{
+		const char* name;
+		void (*run)();
+	};
+	const bench_entry benches[] = {
+		{"concurrent_vector", bench_concurrent_vector},
+		{"sort", bench_sort},
+		{"fill", bench_fill},
+		{"copy", bench_copy},
+		{"ready", bench_ready},
+		{"algorithm", bench_algorithm},
+		{"deque", bench_deque},
+		{"list", bench_list},
+		{"flat_hash_map", bench_flat_hash_map},
+		{"flat_map", bench_flat_map},
+		{"btree", bench_btree},
+		{"spsc_ring", bench_spsc_ring},
+		{"mpmc_queue", bench_mpmc_queue},
+		{"priority_queue", bench_priority_queue},
+		{"string", bench_string},
+		{"static_vector", bench_static_vector},
+	};
+
+	for (const bench_entry& b : benches)
+	{
+		bool selected = (argc == 1);
+		for (int i = 1; i < argc; ++i)
+			if (strcmp(argv[i], b.name) == 0)
+				selected = true;
+		if (selected)
+			b.run();
+	}
+	return 0;
+}
@@ -0,0 +1,996 @@
+#ifndef LZ_STL_BTREE_H
+#define LZ_STL_BTREE_H
+
+#include "type_traits.h"
+#include "alloc.h"
+#include "iterator.h"
+#include "construct.h"
+#include "flat_map.h"
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/*
+btree_map / btree_set：B 树实现的有序关联容器
+为什么需要？
+std::map 每个元素一个红黑树节点，查找要走 log2(n) 层，每层一次不连续的访存；1000 万个元素就是二十多次缓存未命中
+flat_map 查找快，但插入要挪动后面所有元素，写多的大表用不了
+
+做法：
+1.每个节点放一批有序的槽，叶子节点按 256 字节（4 条 cache line）来定槽数：
+  btree_set<int> 一个节点 60 个键，btree_map<int,int> 30 个；树高只有 std::map 的 1/5 左右
+2.内部节点 = 叶子节点 + 孩子指针数组；叶子节点不分配孩子指针那一段
+  两种节点各是一个固定大小，直接向 Alloc 申请/归还
+3.节点内查找：btree_set 的键连续存放，复用 flat_map 的无分支/SIMD lower_bound；btree_map 的槽是 pair，无分支二分
+4.插入：满了就分裂，中间的槽上移到父节点（父节点满了先分裂父节点）
+  在节点末尾插入时（顺序插入）左边留满，在开头插入时右边留满，顺序插入的树几乎每个节点都是满的
+5.删除：内部节点的元素用前驱顶替；节点少于半满时与兄弟合并，合并不下就从兄弟匀过来几个
+6.批量插入 insert(first, last)：比当前最大键还大的元素直接追加到最右的叶子，不走查找也不分裂
+  叶子满了，这个元素就作为分隔键放进最右边第一个不满的祖先，下面挂新的节点；有序输入因此得到全满的节点
+  结束时把最右一条链上不够半满的节点从左兄弟匀一些过来
+7.槽的搬动（插入/删除时挪位置、分裂、合并）按"搬迁"处理：移动构造到新位置再析构旧的，
+  键和值都是平凡可复制的类型时直接 memmove
+
+btree_map 的槽实际存放 std::pair<K,V>，对外以 std::pair<const K,V> 的引用给出（两者布局相同）
+迭代器是（节点，下标），双向；插入和删除使所有迭代器失效；默认的 alloc 不是线程安全的
+*/
+
+namespace lzstl
+{
+	enum {__BTREE_NODE_BYTES = 256};	// 叶子节点的目标大小
+
+	// 一个节点的槽数：256 字节扣掉节点头（父指针、下标、个数、叶子标记），至少 3 个，至多 255 个
+	constexpr size_t __btree_node_slots(size_t slot_size)
+	{
+		return (__BTREE_NODE_BYTES - 2 * sizeof(void*)) / slot_size < 3 ? 3 :
+			   (__BTREE_NODE_BYTES - 2 * sizeof(void*)) / slot_size > 255 ? 255 :
+			   (__BTREE_NODE_BYTES - 2 * sizeof(void*)) / slot_size;
+	}
+
+	template <typename Slot>
+	struct __btree_node
+	{
+		enum {SLOTS = __btree_node_slots(sizeof(Slot))};
+
+		__btree_node*	parent;			// 根节点为 nullptr
+		unsigned short	position;		// 在父节点 children 中的下标
+		unsigned short	count;			// 槽的个数
+		bool			leaf;
+		typename std::aligned_storage<sizeof(Slot) * SLOTS,alignof(Slot)>::type storage;
+		__btree_node*	children[SLOTS + 1];	// 只有内部节点分配了这一段
+
+		Slot* slots() {return reinterpret_cast<Slot*>(&storage);}
+		Slot& slot(size_t i) {return slots()[i];}
+
+		static size_t leaf_bytes() {return offsetof(__btree_node,children);}
+		static size_t internal_bytes() {return sizeof(__btree_node);}
+	};
+
+	template <typename K>
+	struct __btree_set_policy
+	{
+		typedef K key_type;
+		typedef K slot_type;
+		typedef K value_type;
+		enum {constant_iterator = 1};		// 集合的元素就是键，不能通过迭代器修改
+		enum {trivially_relocatable = is_trivially_copyable<K>::value};
+
+		static const key_type& key(const slot_type& s) {return s;}
+		static value_type& element(slot_type& s) {return s;}
+
+		// 键连续存放：算术类型 + std::less 时走 SIMD
+		template <typename Compare>
+		static size_t lower_bound(const slot_type* s,size_t n,const key_type& key,const Compare& comp)
+		{
+			return __flat_lower_bound(s,n,key,comp) - s;
+		}
+
+		template <typename Compare>
+		static size_t upper_bound(const slot_type* s,size_t n,const key_type& key,const Compare& comp)
+		{
+			return __branchless_upper_bound(s,n,key,comp) - s;
+		}
+	};
+
+	template <typename K,typename V>
+	struct __btree_map_policy
+	{
+		typedef K key_type;
+		typedef std::pair<K,V> slot_type;
+		typedef std::pair<const K,V> value_type;
+		enum {constant_iterator = 0};
+		enum {trivially_relocatable = is_trivially_copyable<K>::value && is_trivially_copyable<V>::value};
+
+		static const key_type& key(const slot_type& s) {return s.first;}
+		static value_type& element(slot_type& s) {return reinterpret_cast<value_type&>(s);}
+
+		// 槽是 (键, 值)，按 .first 无分支二分
+		template <typename Compare>
+		static size_t lower_bound(const slot_type* s,size_t n,const key_type& key,const Compare& comp)
+		{
+			if(n == 0)
+				return 0;
+			const slot_type* base = s;
+			while(n > 1)
+			{
+				size_t half = n / 2;
+				base = comp(base[half - 1].first,key) ? base + half : base;
+				n -= half;
+			}
+			return base - s + comp(base->first,key);
+		}
+
+		template <typename Compare>
+		static size_t upper_bound(const slot_type* s,size_t n,const key_type& key,const Compare& comp)
+		{
+			if(n == 0)
+				return 0;
+			const slot_type* base = s;
+			while(n > 1)
+			{
+				size_t half = n / 2;
+				base = comp(key,base[half - 1].first) ? base : base + half;
+				n -= half;
+			}
+			return base - s + !comp(key,base->first);
+		}
+	};
+
+	template <typename Policy,bool IsConst>
+	struct __btree_iterator
+	{
+		typedef __btree_node<typename Policy::slot_type>	node_type;
+		typedef bidirectional_iterator_tag					iterator_category;
+		typedef typename Policy::value_type					value_type;
+		typedef ptrdiff_t									difference_type;
+		typedef typename std::conditional<IsConst || Policy::constant_iterator,const value_type*,value_type*>::type pointer;
+		typedef typename std::conditional<IsConst || Policy::constant_iterator,const value_type&,value_type&>::type reference;
+
+		node_type*	node;
+		int			position;
+
+		__btree_iterator():node(nullptr),position(0){}
+		__btree_iterator(node_type* n,int pos):node(n),position(pos){}
+		// iterator 可隐式转换为 const_iterator（模板形式，不会成为拷贝构造函数）
+		template <bool C,typename = typename std::enable_if<IsConst && !C>::type>
+		__btree_iterator(const __btree_iterator<Policy,C>& rhs):node(rhs.node),position(rhs.position){}
+
+		reference operator*() const {return Policy::element(node->slot(position));}
+		pointer operator->() const {return &Policy::element(node->slot(position));}
+
+		// 叶子里走到头就沿父指针上爬；已经是最后一个元素时停在 end()（最右叶子的末尾）
+		__btree_iterator& operator++()
+		{
+			if(node->leaf)
+			{
+				if(++position < node->count)
+					return *this;
+				node_type* n = node;
+				int pos = position;
+				while(pos == n->count && n->parent)
+				{
+					pos = n->position;
+					n = n->parent;
+				}
+				if(pos < n->count)
+				{
+					node = n;
+					position = pos;
+				}
+				return *this;
+			}
+			node = node->children[position + 1];
+			while(!node->leaf)
+				node = node->children[0];
+			position = 0;
+			return *this;
+		}
+		__btree_iterator operator++(int) {__btree_iterator tmp = *this;++*this;return tmp;}
+
+		__btree_iterator& operator--()
+		{
+			if(node->leaf)
+			{
+				if(--position >= 0)
+					return *this;
+				node_type* n = node;
+				int pos = position;
+				while(pos < 0 && n->parent)
+				{
+					pos = n->position - 1;
+					n = n->parent;
+				}
+				if(pos >= 0)
+				{
+					node = n;
+					position = pos;
+				}
+				return *this;
+			}
+			node = node->children[position];
+			while(!node->leaf)
+				node = node->children[node->count];
+			position = node->count - 1;
+			return *this;
+		}
+		__btree_iterator operator--(int) {__btree_iterator tmp = *this;--*this;return tmp;}
+
+		bool operator==(const __btree_iterator& x) const {return node == x.node && position == x.position;}
+		bool operator!=(const __btree_iterator& x) const {return !(*this == x);}
+	};
+
+	// btree_map / btree_set 共用的树，Policy 决定槽里存什么、键从哪里取
+	template <typename Policy,typename Compare,typename Alloc>
+	class __btree
+	{
+	public:
+		typedef typename Policy::key_type	key_type;
+		typedef typename Policy::value_type	value_type;
+		typedef Compare						key_compare;
+		typedef size_t						size_type;
+		typedef ptrdiff_t					difference_type;
+		typedef Alloc						allocator_type;
+		typedef __btree_iterator<Policy,false>	iterator;
+		typedef __btree_iterator<Policy,true>	const_iterator;
+	protected:
+		typedef typename Policy::slot_type	slot_type;
+		typedef __btree_node<slot_type>		node_type;
+		enum {SLOTS = node_type::SLOTS};
+		enum {MIN_SLOTS = SLOTS / 2};		// 非根节点少于这个数就与兄弟合并或从兄弟匀
+
+		node_type*	_root;
+		node_type*	_leftmost;		// 最左的叶子，begin()
+		node_type*	_rightmost;		// 最右的叶子，end() 是它的末尾
+		size_type	_size;
+		Compare		_comp;
+
+		// -------------------------- 节点 --------------------------
+		static node_type* _new_node(bool leaf,node_type* parent)
+		{
+			node_type* n = static_cast<node_type*>(Alloc::allocate(leaf ? node_type::leaf_bytes() : node_type::internal_bytes()));
+			n->parent = parent;
+			n->position = 0;
+			n->count = 0;
+			n->leaf = leaf;
+			return n;
+		}
+
+		static void _free_node(node_type* n)
+		{
+			Alloc::deallocate(n,n->leaf ? node_type::leaf_bytes() : node_type::internal_bytes());
+		}
+
+		static void _set_child(node_type* n,size_t i,node_type* c)
+		{
+			n->children[i] = c;
+			c->parent = n;
+			c->position = static_cast<unsigned short>(i);
+		}
+
+		// 把 [src, src+n) 的元素搬到 dst（可以重叠），搬完后 src 处不再有对象
+		static void _relocate(slot_type* dst,slot_type* src,size_t n)
+		{
+			_relocate(dst,src,n,typename __bool_type<Policy::trivially_relocatable>::type());
+		}
+
+		static void _relocate(slot_type* dst,slot_type* src,size_t n,true_type)
+		{
+			if(n)
+				std::memmove(static_cast<void*>(dst),static_cast<const void*>(src),n * sizeof(slot_type));
+		}
+
+		static void _relocate(slot_type* dst,slot_type* src,size_t n,false_type)
+		{
+			if(dst < src)
+			{
+				for(size_t i = 0;i<n;++i)
+				{
+					lzstl::construct(dst + i,std::move(src[i]));
+					lzstl::destroy(src + i);
+				}
+			}
+			else
+			{
+				for(size_t i = n;i-- > 0;)
+				{
+					lzstl::construct(dst + i,std::move(src[i]));
+					lzstl::destroy(src + i);
+				}
+			}
+		}
+
+		void _destroy_subtree(node_type* n)
+		{
+			if(!n->leaf)
+				for(size_t i = 0;i<=n->count;++i)
+					_destroy_subtree(n->children[i]);
+			lzstl::destroy(n->slots(),n->slots() + n->count);
+			_free_node(n);
+		}
+
+		void _reset()
+		{
+			_root = nullptr;
+			_leftmost = nullptr;
+			_rightmost = nullptr;
+			_size = 0;
+		}
+
+		void _init_root()
+		{
+			_root = _leftmost = _rightmost = _new_node(true,nullptr);
+		}
+
+		// -------------------------- 查找 --------------------------
+		iterator _begin() const {return iterator(_leftmost,0);}
+		iterator _end() const {return _rightmost ? iterator(_rightmost,_rightmost->count) : iterator();}
+
+		// (n, i) 可能停在节点末尾：上爬到第一个真正的元素，没有则是 end()
+		iterator _normalize(node_type* n,size_t i) const
+		{
+			while(i == n->count)
+			{
+				if(!n->parent)
+					return _end();
+				i = n->position;
+				n = n->parent;
+			}
+			return iterator(n,int(i));
+		}
+
+		iterator _find(const key_type& key) const
+		{
+			node_type* n = _root;
+			while(n)
+			{
+				size_t i = Policy::lower_bound(n->slots(),n->count,key,_comp);
+				if(i < n->count && !_comp(key,Policy::key(n->slot(i))))
+					return iterator(n,int(i));
+				if(n->leaf)
+					break;
+				n = n->children[i];
+			}
+			return _end();
+		}
+
+		iterator _lower_bound(const key_type& key) const
+		{
+			node_type* n = _root;
+			if(!n)
+				return _end();
+			for(;;)
+			{
+				size_t i = Policy::lower_bound(n->slots(),n->count,key,_comp);
+				if(n->leaf)
+					return _normalize(n,i);
+				n = n->children[i];
+			}
+		}
+
+		iterator _upper_bound(const key_type& key) const
+		{
+			node_type* n = _root;
+			if(!n)
+				return _end();
+			for(;;)
+			{
+				size_t i = Policy::upper_bound(n->slots(),n->count,key,_comp);
+				if(n->leaf)
+					return _normalize(n,i);
+				n = n->children[i];
+			}
+		}
+
+		// -------------------------- 插入 --------------------------
+		// n 已满，接下来要在 n 的第 i 个位置插入：分成两半，中间的槽上移到父节点，返回新的右兄弟
+		// 在末尾插入时左边留 SLOTS-1 个，在开头插入时右边留 SLOTS-1 个，其余从正中间分
+		node_type* _split(node_type* n,size_t i)
+		{
+			node_type* parent = n->parent;
+			if(parent && parent->count == SLOTS)
+			{
+				_split(parent,n->position);
+				parent = n->parent;
+			}
+			if(!parent)
+			{
+				parent = _new_node(false,nullptr);
+				_set_child(parent,0,n);
+				_root = parent;
+			}
+			node_type* right = _new_node(n->leaf,parent);
+
+			size_t mid = i == SLOTS ? SLOTS - 1 : i == 0 ? 0 : SLOTS / 2;
+			size_t moved = n->count - mid - 1;
+			_relocate(right->slots(),n->slots() + mid + 1,moved);
+			if(!n->leaf)
+				for(size_t j = 0;j<=moved;++j)
+					_set_child(right,j,n->children[mid + 1 + j]);
+			right->count = static_cast<unsigned short>(moved);
+
+			// 中间的槽放到父节点 n->position 处，新节点是它右边的孩子
+			size_t p = n->position;
+			slot_type* ps = parent->slots();
+			_relocate(ps + p + 1,ps + p,parent->count - p);
+			_relocate(ps + p,n->slots() + mid,1);
+			for(size_t j = parent->count;j>p;--j)
+				_set_child(parent,j + 1,parent->children[j]);
+			_set_child(parent,p + 1,right);
+			++parent->count;
+			n->count = static_cast<unsigned short>(mid);
+			if(_rightmost == n)
+				_rightmost = right;
+			return right;
+		}
+
+		// 在叶子 n 的第 i 个位置构造元素；构造失败时把挪开的元素搬回去
+		template <typename... Args>
+		iterator _insert_at(node_type* n,size_t i,Args&&... args)
+		{
+			if(n->count == SLOTS)
+			{
+				node_type* right = _split(n,i);
+				if(i > n->count)
+				{
+					i -= n->count + 1;
+					n = right;
+				}
+			}
+			slot_type* s = n->slots();
+			_relocate(s + i + 1,s + i,n->count - i);
+			try
+			{
+				::new (static_cast<void*>(s + i)) slot_type(std::forward<Args>(args)...);
+			}
+			catch(...)
+			{
+				_relocate(s + i,s + i + 1,n->count - i);
+				throw;
+			}
+			++n->count;
+			++_size;
+			return iterator(n,int(i));
+		}
+
+		// 插入：键已存在时返回已有元素和 false
+		template <typename... Args>
+		std::pair<iterator,bool> _emplace_key(const key_type& key,Args&&... args)
+		{
+			if(!_root)
+				_init_root();
+			node_type* n = _root;
+			size_t i;
+			for(;;)
+			{
+				i = Policy::lower_bound(n->slots(),n->count,key,_comp);
+				if(i < n->count && !_comp(key,Policy::key(n->slot(i))))
+					return std::pair<iterator,bool>(iterator(n,int(i)),false);
+				if(n->leaf)
+					break;
+				n = n->children[i];
+			}
+			return std::pair<iterator,bool>(_insert_at(n,i,std::forward<Args>(args)...),true);
+		}
+
+		// 最后一个元素的键；树非空
+		const key_type& _back_key() const
+		{
+			iterator it = _end();
+			--it;
+			return Policy::key(it.node->slot(it.position));
+		}
+
+		static void _free_chain(node_type* top)
+		{
+			while(top)
+			{
+				node_type* next = top->leaf ? nullptr : top->children[0];
+				_free_node(top);
+				top = next;
+			}
+		}
+
+		// 追加一个比现有元素都大的元素：最右叶子有空位就直接放
+		// 满了就让它当分隔键，放进最右边第一个不满的祖先，下面挂一串新的空节点（最后一个是叶子）
+		template <typename... Args>
+		void _append_back(Args&&... args)
+		{
+			if(!_root)
+				_init_root();
+			node_type* n = _rightmost;
+			if(n->count < SLOTS)
+			{
+				::new (static_cast<void*>(n->slots() + n->count)) slot_type(std::forward<Args>(args)...);
+				++n->count;
+				++_size;
+				return;
+			}
+			size_t height = 1;
+			node_type* a = n->parent;
+			while(a && a->count == SLOTS)
+			{
+				a = a->parent;
+				++height;
+			}
+			if(!a)
+			{
+				a = _new_node(false,nullptr);
+				_set_child(a,0,_root);
+				_root = a;
+			}
+
+			// 先把新的一串节点都申请好，再构造元素，失败时树不变
+			node_type* top = nullptr;
+			node_type* bottom = nullptr;
+			try
+			{
+				for(size_t h = height;h-- > 0;)
+				{
+					node_type* c = _new_node(h == 0,bottom);
+					if(bottom)
+						_set_child(bottom,0,c);
+					else
+						top = c;
+					bottom = c;
+				}
+				::new (static_cast<void*>(a->slots() + a->count)) slot_type(std::forward<Args>(args)...);
+			}
+			catch(...)
+			{
+				_free_chain(top);
+				throw;
+			}
+			++a->count;
+			_set_child(a,a->count,top);
+			_rightmost = bottom;
+			++_size;
+		}
+
+		// 批量追加后，最右一条链上的节点可能不满：从上往下，不够半满的节点与左兄弟合并或从左兄弟匀一些过来
+		void _fix_right_spine()
+		{
+			node_type* n = _root;
+			while(n && !n->leaf)
+			{
+				node_type* c = n->children[n->count];
+				if(c->count < MIN_SLOTS && n->count > 0)
+				{
+					node_type* left = n->children[n->count - 1];
+					if(left->count + 1 + c->count <= SLOTS)
+					{
+						_merge(left,c);
+						if(n == _root && n->count == 0)
+						{
+							_collapse_root();
+							n = _root;
+							continue;
+						}
+					}
+					else
+						_rotate_right(left,c,(left->count - c->count + 1) / 2);
+				}
+				n = n->children[n->count];
+			}
+		}
+
+		// -------------------------- 删除 --------------------------
+		// left 末尾的 k 个槽经过父节点移到 right 开头（right 是 left 右边的兄弟）
+		void _rotate_right(node_type* left,node_type* right,size_t k)
+		{
+			node_type* parent = left->parent;
+			size_t s = left->position;
+			slot_type* ls = left->slots();
+			slot_type* rs = right->slots();
+			slot_type* ps = parent->slots();
+			_relocate(rs + k,rs,right->count);
+			_relocate(rs + k - 1,ps + s,1);
+			_relocate(rs,ls + left->count - k + 1,k - 1);
+			_relocate(ps + s,ls + left->count - k,1);
+			if(!right->leaf)
+			{
+				for(size_t j = right->count + 1;j-- > 0;)
+					_set_child(right,j + k,right->children[j]);
+				for(size_t j = 0;j<k;++j)
+					_set_child(right,j,left->children[left->count - k + 1 + j]);
+			}
+			left->count = static_cast<unsigned short>(left->count - k);
+			right->count = static_cast<unsigned short>(right->count + k);
+		}
+
+		// right 开头的 k 个槽经过父节点移到 left 末尾
+		void _rotate_left(node_type* left,node_type* right,size_t k)
+		{
+			node_type* parent = left->parent;
+			size_t s = left->position;
+			slot_type* ls = left->slots();
+			slot_type* rs = right->slots();
+			slot_type* ps = parent->slots();
+			_relocate(ls + left->count,ps + s,1);
+			_relocate(ls + left->count + 1,rs,k - 1);
+			_relocate(ps + s,rs + k - 1,1);
+			_relocate(rs,rs + k,right->count - k);
+			if(!left->leaf)
+			{
+				for(size_t j = 0;j<k;++j)
+					_set_child(left,left->count + 1 + j,right->children[j]);
+				for(size_t j = 0;j + k<=right->count;++j)
+					_set_child(right,j,right->children[j + k]);
+			}
+			left->count = static_cast<unsigned short>(left->count + k);
+			right->count = static_cast<unsigned short>(right->count - k);
+		}
+
+		// 分隔槽和 right 的全部槽并入 left，父节点去掉分隔槽和 right
+		void _merge(node_type* left,node_type* right)
+		{
+			node_type* parent = left->parent;
+			size_t s = left->position;
+			slot_type* ls = left->slots();
+			slot_type* ps = parent->slots();
+			_relocate(ls + left->count,ps + s,1);
+			_relocate(ls + left->count + 1,right->slots(),right->count);
+			if(!left->leaf)
+				for(size_t j = 0;j<=right->count;++j)
+					_set_child(left,left->count + 1 + j,right->children[j]);
+			left->count = static_cast<unsigned short>(left->count + 1 + right->count);
+
+			_relocate(ps + s,ps + s + 1,parent->count - s - 1);
+			for(size_t j = s + 2;j<=parent->count;++j)
+				_set_child(parent,j - 1,parent->children[j]);
+			--parent->count;
+			if(_rightmost == right)
+				_rightmost = left;
+			_free_node(right);
+		}
+
+		// 根节点没有槽了：叶子根说明树空了，内部根换成它唯一的孩子
+		void _collapse_root()
+		{
+			node_type* old = _root;
+			if(old->leaf)
+			{
+				_free_node(old);
+				_reset();
+				return;
+			}
+			_root = old->children[0];
+			_root->parent = nullptr;
+			_root->position = 0;
+			_free_node(old);
+		}
+
+		// cur 不够半满：能与兄弟合并就合并，否则从较满的兄弟匀一半差值过来
+		// (n, i) 是删除位置，元素被搬到别的节点时随之更新
+		void _merge_or_rotate(node_type* cur,node_type*& n,size_t& i)
+		{
+			node_type* parent = cur->parent;
+			size_t p = cur->position;
+			node_type* left = p > 0 ? parent->children[p - 1] : nullptr;
+			node_type* right = p < parent->count ? parent->children[p + 1] : nullptr;
+			if(left && left->count + 1 + cur->count <= SLOTS)
+			{
+				if(n == cur)
+				{
+					i += left->count + 1;
+					n = left;
+				}
+				_merge(left,cur);
+			}
+			else if(right && cur->count + 1 + right->count <= SLOTS)
+				_merge(cur,right);
+			else if(left)
+			{
+				size_t k = (left->count - cur->count + 1) / 2;
+				if(n == cur)
+					i += k;
+				_rotate_right(left,cur,k);
+			}
+			else
+				_rotate_left(cur,right,(right->count - cur->count + 1) / 2);
+		}
+
+		// 删除 pos 处的元素，返回下一个元素
+		iterator _erase(iterator pos)
+		{
+			node_type* n = pos.node;
+			size_t i = pos.position;
+			bool internal = !n->leaf;
+			lzstl::destroy(n->slots() + i);
+			if(internal)
+			{
+				// 内部节点的元素用前驱（左子树最大的元素，一定在叶子里）顶替
+				node_type* leaf = n->children[i];
+				while(!leaf->leaf)
+					leaf = leaf->children[leaf->count];
+				_relocate(n->slots() + i,leaf->slots() + leaf->count - 1,1);
+				n = leaf;
+				i = leaf->count - 1;
+			}
+			else
+				_relocate(n->slots() + i,n->slots() + i + 1,n->count - i - 1);
+			--n->count;
+			--_size;
+
+			for(node_type* cur = n;cur != _root && cur->count < MIN_SLOTS;)
+			{
+				node_type* parent = cur->parent;
+				_merge_or_rotate(cur,n,i);
+				cur = parent;
+			}
+			if(_root->count == 0)
+			{
+				bool empty = _root->leaf;
+				_collapse_root();
+				if(empty)
+					return iterator();
+			}
+			// (n, i) 现在指向被删元素的后一个位置；删的是内部节点的元素时，这里是顶替它的前驱，再往后走一个
+			iterator next = _normalize(n,i);
+			if(internal)
+				++next;
+			return next;
+		}
+
+		// 逐个追加 [first, last)（已按键有序且不重复），用于复制
+		template <typename InputIterator>
+		void _append_sorted(InputIterator first,InputIterator last)
+		{
+			for(;first != last;++first)
+				_append_back(reinterpret_cast<const slot_type&>(*first));
+			_fix_right_spine();
+		}
+
+		void _clear_all()
+		{
+			if(_root)
+				_destroy_subtree(_root);
+			_reset();
+		}
+
+	public:
+		// -------------------------- 构造函数/析构函数/赋值运算符 --------------------------
+		__btree():_comp()
+		{
+			_reset();
+		}
+
+		explicit __btree(const Compare& comp):_comp(comp)
+		{
+			_reset();
+		}
+
+		template <typename InputIterator>
+		__btree(InputIterator first,InputIterator last,const Compare& comp = Compare()):_comp(comp)
+		{
+			_reset();
+			try
+			{
+				insert(first,last);
+			}
+			catch(...)
+			{
+				_clear_all();
+				throw;
+			}
+		}
+
+		// 源树按序追加，每个节点都是满的
+		__btree(const __btree& rhs):_comp(rhs._comp)
+		{
+			_reset();
+			try
+			{
+				_append_sorted(rhs.begin(),rhs.end());
+			}
+			catch(...)
+			{
+				_clear_all();
+				throw;
+			}
+		}
+
+		__btree(__btree&& rhs) noexcept :_comp(rhs._comp)
+		{
+			_reset();
+			swap(rhs);
+		}
+
+		~__btree()
+		{
+			_clear_all();
+		}
+
+		__btree& operator=(const __btree& rhs)
+		{
+			if(this != &rhs)
+			{
+				__btree tmp(rhs);
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		__btree& operator=(__btree&& rhs) noexcept
+		{
+			if(this != &rhs)
+				swap(rhs);
+			return *this;
+		}
+
+		// -------------------------- 迭代器接口 --------------------------
+		iterator begin() {return _begin();}
+		const_iterator begin() const {return _begin();}
+		iterator end() {return _end();}
+		const_iterator end() const {return _end();}
+
+		// -------------------------- 容量与大小操作 --------------------------
+		size_type size() const {return _size;}
+		bool empty() const {return _size == 0;}
+		void clear() {_clear_all();}
+
+		// 树高：空树为 0，只有一个叶子为 1
+		size_type height() const
+		{
+			size_type h = 0;
+			for(node_type* n = _root;n;n = n->leaf ? nullptr : n->children[0])
+				++h;
+			return h;
+		}
+
+		void swap(__btree& rhs) noexcept
+		{
+			std::swap(_root,rhs._root);
+			std::swap(_leftmost,rhs._leftmost);
+			std::swap(_rightmost,rhs._rightmost);
+			std::swap(_size,rhs._size);
+			std::swap(_comp,rhs._comp);
+		}
+
+		// -------------------------- 查找 --------------------------
+		iterator find(const key_type& key) {return _find(key);}
+		const_iterator find(const key_type& key) const {return _find(key);}
+		size_type count(const key_type& key) const {return _find(key) != _end();}
+		iterator lower_bound(const key_type& key) {return _lower_bound(key);}
+		const_iterator lower_bound(const key_type& key) const {return _lower_bound(key);}
+		iterator upper_bound(const key_type& key) {return _upper_bound(key);}
+		const_iterator upper_bound(const key_type& key) const {return _upper_bound(key);}
+
+		std::pair<iterator,iterator> equal_range(const key_type& key)
+		{
+			return std::pair<iterator,iterator>(_lower_bound(key),_upper_bound(key));
+		}
+		std::pair<const_iterator,const_iterator> equal_range(const key_type& key) const
+		{
+			return std::pair<const_iterator,const_iterator>(_lower_bound(key),_upper_bound(key));
+		}
+
+		// -------------------------- 插入/删除 --------------------------
+		std::pair<iterator,bool> insert(const value_type& value)
+		{
+			return _emplace_key(Policy::key(reinterpret_cast<const slot_type&>(value)),value);
+		}
+
+		std::pair<iterator,bool> insert(value_type&& value)
+		{
+			return _emplace_key(Policy::key(reinterpret_cast<const slot_type&>(value)),std::move(value));
+		}
+
+		// 比当前最大键大的元素直接追加到最右边，有序输入因此建出全满的节点；其余元素正常插入
+		template <typename InputIterator>
+		void insert(InputIterator first,InputIterator last)
+		{
+			bool appended = false;
+			for(;first != last;++first)
+			{
+				const value_type& value = *first;
+				const key_type& key = Policy::key(reinterpret_cast<const slot_type&>(value));
+				if(_size == 0 || _comp(_back_key(),key))
+				{
+					_append_back(value);
+					appended = true;
+				}
+				else
+					_emplace_key(key,value);
+			}
+			if(appended)
+				_fix_right_spine();
+		}
+
+		// 先构造出元素才能知道键：构造一个临时对象，键不存在时再移动进槽
+		template <typename... Args>
+		std::pair<iterator,bool> emplace(Args&&... args)
+		{
+			slot_type tmp(std::forward<Args>(args)...);
+			return _emplace_key(Policy::key(tmp),std::move(tmp));
+		}
+
+		iterator erase(const_iterator pos) {return _erase(iterator(pos.node,pos.position));}
+		iterator erase(iterator pos) {return _erase(pos);}
+
+		// 删除会合并节点，last 可能失效：先数出个数再逐个删
+		iterator erase(const_iterator first,const_iterator last)
+		{
+			if(first == begin() && last == end())
+			{
+				clear();
+				return end();
+			}
+			size_type n = lzstl::distance(first,last);
+			iterator it(first.node,first.position);
+			while(n--)
+				it = _erase(it);
+			return it;
+		}
+
+		size_type erase(const key_type& key)
+		{
+			iterator it = _find(key);
+			if(it == _end())
+				return 0;
+			_erase(it);
+			return 1;
+		}
+
+		// -------------------------- 其他 --------------------------
+		key_compare key_comp() const {return _comp;}
+		allocator_type get_allocator() const {return allocator_type();}
+	};
+
+	template <typename K,typename Compare = std::less<K>,typename Alloc = alloc>
+	class btree_set :public __btree<__btree_set_policy<K>,Compare,Alloc>
+	{
+		typedef __btree<__btree_set_policy<K>,Compare,Alloc> base;
+	public:
+		using base::base;
+		btree_set() {}
+	};
+
+	template <typename K,typename V,typename Compare = std::less<K>,typename Alloc = alloc>
+	class btree_map :public __btree<__btree_map_policy<K,V>,Compare,Alloc>
+	{
+		typedef __btree<__btree_map_policy<K,V>,Compare,Alloc> base;
+	public:
+		typedef V mapped_type;
+		typedef typename base::key_type key_type;
+		typedef typename base::iterator iterator;
+
+		using base::base;
+		btree_map() {}
+
+		// 键不存在时才用 args 构造值；键存在时 args 不被移动
+		template <typename... Args>
+		std::pair<iterator,bool> try_emplace(const key_type& key,Args&&... args)
+		{
+			return this->_emplace_key(key,std::piecewise_construct,std::forward_as_tuple(key),
+									  std::forward_as_tuple(std::forward<Args>(args)...));
+		}
+
+		template <typename... Args>
+		std::pair<iterator,bool> try_emplace(key_type&& key,Args&&... args)
+		{
+			return this->_emplace_key(key,std::piecewise_construct,std::forward_as_tuple(std::move(key)),
+									  std::forward_as_tuple(std::forward<Args>(args)...));
+		}
+
+		// 键不存在时插入值初始化的 V
+		mapped_type& operator[](const key_type& key) {return try_emplace(key).first->second;}
+		mapped_type& operator[](key_type&& key) {return try_emplace(std::move(key)).first->second;}
+	};
+
+	template <typename K,typename Compare,typename Alloc>
+	inline void swap(btree_set<K,Compare,Alloc>& lhs,btree_set<K,Compare,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+	template <typename K,typename V,typename Compare,typename Alloc>
+	inline void swap(btree_map<K,V,Compare,Alloc>& lhs,btree_map<K,V,Compare,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
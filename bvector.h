@@ -0,0 +1,562 @@
+#ifndef LZ_STL_BVECTOR_H
+#define LZ_STL_BVECTOR_H
+
+/*
+vector<bool> 特化：按位压缩存储（bit_vector）
+为什么需要？
+通用 vector<bool> 每个标志占 1 字节，几十亿个标志的位图要多花 8 倍内存
+
+做法：
+1.每 64 个标志压进一个 64 位字（word），内存缩小到 1/8
+2.单个位无法取地址，operator[] 返回代理对象 __bit_reference（字指针 + 掩码）
+3.约定：最后一个字中超过 size() 的位始终为 0
+  这样 count/find/与或异 都可以按整字处理，不必单独处理尾部
+4.批量操作按字进行：
+	count       逐字 popcount；运行时检测 CPU，支持 popcnt 指令时用单独编译的内核
+	            （不加 -mpopcnt 时 __builtin_popcountll 会编译成 libgcc 的 __popcountdi2 调用）
+	insert/erase 整字移位，相邻字之间用进位拼接，不逐位搬动
+	find_first  跳过全 0 字，再用 ctz 找到最低位的 1
+	&= |= ^=    逐字运算，循环简单，编译器可以自动向量化（SIMD）
+	resize      新增的整字直接 memset
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "alloc.h"
+#include "iterator.h"
+#include "simd.h"
+#include "vector.h"
+
+namespace lzstl
+{
+	typedef unsigned long long __bit_word;
+	enum {__WORD_BIT = int(sizeof(__bit_word) * 8)};	// 每个字 64 位
+
+	// 0. popcount 内核：和 simd.h 一样，第一次调用时按 CPU 选定，之后只是一次函数指针调用
+	typedef size_t (*__popcount_kernel)(const __bit_word* words,size_t nwords);
+
+	// 4 个累加器互不依赖；强制内联到各内核里，__builtin_popcountll 按调用者的 target 展开
+	__attribute__((always_inline))
+	inline size_t __popcount_loop(const __bit_word* words,size_t nwords)
+	{
+		size_t c0 = 0,c1 = 0,c2 = 0,c3 = 0;
+		size_t w = 0;
+		for(;w+4<=nwords;w+=4)
+		{
+			c0 += __builtin_popcountll(words[w]);
+			c1 += __builtin_popcountll(words[w+1]);
+			c2 += __builtin_popcountll(words[w+2]);
+			c3 += __builtin_popcountll(words[w+3]);
+		}
+		for(;w<nwords;++w)
+			c0 += __builtin_popcountll(words[w]);
+		return c0 + c1 + c2 + c3;
+	}
+
+	inline size_t __popcount_kernel_scalar(const __bit_word* words,size_t nwords)
+	{
+		return __popcount_loop(words,nwords);
+	}
+
+#ifdef LZ_STL_SIMD_X86
+	__attribute__((target("popcnt")))
+	inline size_t __popcount_kernel_popcnt(const __bit_word* words,size_t nwords)
+	{
+		return __popcount_loop(words,nwords);
+	}
+#endif
+
+	inline __popcount_kernel __select_popcount_kernel()
+	{
+#ifdef LZ_STL_SIMD_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("popcnt"))
+			return &__popcount_kernel_popcnt;
+#endif
+		return &__popcount_kernel_scalar;
+	}
+
+	inline __popcount_kernel __popcount_kernel_for_cpu()
+	{
+		static const __popcount_kernel kernel = __select_popcount_kernel();
+		return kernel;
+	}
+
+	// 1. 位引用代理：模拟 bool&
+	struct __bit_reference
+	{
+		__bit_word* _p;
+		__bit_word  _mask;
+
+		__bit_reference(__bit_word* p,__bit_word mask):_p(p),_mask(mask){}
+
+		operator bool() const {return (*_p & _mask) != 0;}
+		__bit_reference& operator=(bool x)
+		{
+			if(x) *_p |= _mask;
+			else  *_p &= ~_mask;
+			return *this;
+		}
+		// 位引用之间赋值：复制的是位的值，而不是引用本身
+		__bit_reference& operator=(const __bit_reference& x) {return *this = bool(x);}
+		bool operator==(const __bit_reference& x) const {return bool(*this) == bool(x);}
+		bool operator<(const __bit_reference& x) const {return !bool(*this) && bool(x);}
+		void flip() {*_p ^= _mask;}
+	};
+
+	inline void swap(__bit_reference x,__bit_reference y)
+	{
+		bool tmp = x;
+		x = y;
+		y = tmp;
+	}
+
+	// 2. 位迭代器：字指针 + 字内偏移，随机访问
+	template <bool IsConst>
+	struct __bit_iterator
+	{
+		typedef random_access_iterator_tag	iterator_category;
+		typedef bool						value_type;
+		typedef ptrdiff_t					difference_type;
+		typedef void						pointer;
+		typedef typename std::conditional<IsConst,bool,__bit_reference>::type reference;
+
+		__bit_word*  _p;
+		unsigned     _offset;		// [0, 64)
+
+		__bit_iterator():_p(nullptr),_offset(0){}
+		__bit_iterator(__bit_word* p,unsigned offset):_p(p),_offset(offset){}
+		// iterator 可隐式转换为 const_iterator
+		__bit_iterator(const __bit_iterator<false>& rhs):_p(rhs._p),_offset(rhs._offset){}
+
+		reference operator*() const {return __bit_reference(_p,__bit_word(1) << _offset);}
+		reference operator[](difference_type n) const {return *(*this + n);}
+
+		__bit_iterator& operator++()
+		{
+			if(++_offset == (unsigned)__WORD_BIT)
+			{
+				_offset = 0;
+				++_p;
+			}
+			return *this;
+		}
+		__bit_iterator operator++(int) {__bit_iterator tmp = *this;++*this;return tmp;}
+		__bit_iterator& operator--()
+		{
+			if(_offset-- == 0)
+			{
+				_offset = __WORD_BIT - 1;
+				--_p;
+			}
+			return *this;
+		}
+		__bit_iterator operator--(int) {__bit_iterator tmp = *this;--*this;return tmp;}
+
+		__bit_iterator& operator+=(difference_type n)
+		{
+			difference_type bits = n + _offset;
+			_p += bits / __WORD_BIT;
+			bits %= __WORD_BIT;
+			if(bits < 0)
+			{
+				bits += __WORD_BIT;
+				--_p;
+			}
+			_offset = (unsigned)bits;
+			return *this;
+		}
+		__bit_iterator& operator-=(difference_type n) {return *this += -n;}
+		__bit_iterator operator+(difference_type n) const {__bit_iterator tmp = *this;return tmp += n;}
+		__bit_iterator operator-(difference_type n) const {__bit_iterator tmp = *this;return tmp -= n;}
+		difference_type operator-(const __bit_iterator& rhs) const
+		{
+			return (_p - rhs._p) * __WORD_BIT + (difference_type)_offset - (difference_type)rhs._offset;
+		}
+
+		bool operator==(const __bit_iterator& rhs) const {return _p == rhs._p && _offset == rhs._offset;}
+		bool operator!=(const __bit_iterator& rhs) const {return !(*this == rhs);}
+		bool operator<(const __bit_iterator& rhs) const {return _p < rhs._p || (_p == rhs._p && _offset < rhs._offset);}
+		bool operator>(const __bit_iterator& rhs) const {return rhs < *this;}
+		bool operator<=(const __bit_iterator& rhs) const {return !(rhs < *this);}
+		bool operator>=(const __bit_iterator& rhs) const {return !(*this < rhs);}
+	};
+
+	// 3. vector<bool, Alloc> 偏特化
+	template <typename Alloc>
+	class vector<bool,Alloc>
+	{
+	public:
+		typedef bool						value_type;
+		typedef __bit_iterator<false>		iterator;
+		typedef __bit_iterator<true>		const_iterator;
+		typedef __bit_reference				reference;
+		typedef bool						const_reference;
+		typedef size_t						size_type;
+		typedef ptrdiff_t					difference_type;
+		typedef Alloc						allocator_type;
+		typedef __bit_word					word_type;
+
+		// find_first/find_next 找不到时的返回值
+		static const size_type npos = size_type(-1);
+
+	private:
+		word_type* _words;			// 位存储
+		size_type  _size;			// 位数
+		size_type  _word_capacity;	// 已分配的字数
+
+		// -------------------------- 内部辅助函数 --------------------------
+		static size_type _words_for(size_type bits) {return (bits + __WORD_BIT - 1) / __WORD_BIT;}
+		size_type _word_count() const {return _words_for(_size);}
+
+		static word_type* _allocate(size_type nwords)
+		{
+			return nwords == 0 ? nullptr : static_cast<word_type*>(Alloc::allocate(nwords*sizeof(word_type)));
+		}
+
+		void _deallocate()
+		{
+			if(_words)
+				Alloc::deallocate(_words,_word_capacity*sizeof(word_type));
+		}
+
+		// 扩容到至少 nwords 个字，原有位原样保留
+		void _reallocate(size_type nwords)
+		{
+			if(nwords <= _word_capacity) return;
+			word_type* new_words = _allocate(nwords);
+			if(_word_count())
+				std::memcpy(new_words,_words,_word_count()*sizeof(word_type));
+			_deallocate();
+			_words = new_words;
+			_word_capacity = nwords;
+		}
+
+		// 与 vector 相同：2倍扩容
+		void _ensure_capacity(size_type bits)
+		{
+			size_type need = _words_for(bits);
+			if(need > _word_capacity)
+			{
+				size_type new_cap = (_word_capacity == 0) ? 1 : _word_capacity * 2;
+				if(new_cap < need)
+					new_cap = need;
+				_reallocate(new_cap);
+			}
+		}
+
+		// 把最后一个字中超出 size() 的位清零，维持 “尾部为 0” 的约定
+		void _clear_tail()
+		{
+			unsigned rem = (unsigned)(_size % __WORD_BIT);
+			if(rem)
+				_words[_size / __WORD_BIT] &= (word_type(1) << rem) - 1;
+		}
+
+		static word_type _mask(size_type pos) {return word_type(1) << (pos % __WORD_BIT);}
+
+		// 从第 pos 位起的 64 位拼成一个字（跨两个字），超出前 nwords 个字的部分按 0 算
+		word_type _bits_at(size_type pos,size_type nwords) const
+		{
+			size_type w = pos / __WORD_BIT;
+			unsigned r = (unsigned)(pos % __WORD_BIT);
+			word_type bits = w < nwords ? _words[w] >> r : 0;
+			if(r && w+1 < nwords)
+				bits |= _words[w+1] << (__WORD_BIT - r);
+			return bits;
+		}
+
+		// 从字 w 开始找第一个非 0 字，返回其中最低位 1 的位置
+		size_type _scan_from(size_type w) const
+		{
+			size_type nwords = _word_count();
+			for(;w<nwords;++w)
+				if(_words[w])
+					return w * __WORD_BIT + (size_type)__builtin_ctzll(_words[w]);
+			return npos;
+		}
+
+	public:
+		// -------------------------- 构造函数/析构函数/赋值运算符 --------------------------
+		vector():_words(nullptr),_size(0),_word_capacity(0){}
+
+		explicit vector(size_type n,bool value = false):_words(nullptr),_size(0),_word_capacity(0)
+		{
+			resize(n,value);
+		}
+
+		vector(const vector& rhs):_words(nullptr),_size(0),_word_capacity(0)
+		{
+			_reallocate(rhs._word_count());
+			if(rhs._word_count())
+				std::memcpy(_words,rhs._words,rhs._word_count()*sizeof(word_type));
+			_size = rhs._size;
+		}
+
+		vector(vector&& rhs):_words(rhs._words),_size(rhs._size),_word_capacity(rhs._word_capacity)
+		{
+			rhs._words = nullptr;
+			rhs._size = rhs._word_capacity = 0;
+		}
+
+		~vector() {_deallocate();}
+
+		vector& operator=(const vector& rhs)
+		{
+			if(this != &rhs)
+			{
+				vector tmp(rhs);
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		vector& operator=(vector&& rhs)
+		{
+			if(this != &rhs)
+			{
+				vector tmp(std::move(rhs));
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		void swap(vector& rhs)
+		{
+			std::swap(_words,rhs._words);
+			std::swap(_size,rhs._size);
+			std::swap(_word_capacity,rhs._word_capacity);
+		}
+
+		// -------------------------- 迭代器接口 --------------------------
+		iterator begin() {return iterator(_words,0);}
+		const_iterator begin() const {return const_iterator(_words,0);}
+		iterator end() {return begin() + _size;}
+		const_iterator end() const {return begin() + _size;}
+
+		// -------------------------- 容量与大小操作 --------------------------
+		size_type size() const {return _size;}
+		size_type capacity() const {return _word_capacity * __WORD_BIT;}
+		bool empty() const {return _size == 0;}
+
+		void reserve(size_type n)
+		{
+			_reallocate(_words_for(n));
+		}
+
+		// 扩大时：先补齐当前最后一个字的尾部，再整字 memset
+		void resize(size_type n,bool value = false)
+		{
+			if(n < _size)
+			{
+				_size = n;
+				_clear_tail();
+				return;
+			}
+			if(n == _size) return;
+
+			_ensure_capacity(n);
+			size_type old_words = _word_count();
+			unsigned rem = (unsigned)(_size % __WORD_BIT);
+			if(rem && value)
+				_words[old_words-1] |= ~word_type(0) << rem;
+			size_type new_words = _words_for(n);
+			if(new_words > old_words)
+				std::memset(_words + old_words,value ? 0xFF : 0,(new_words-old_words)*sizeof(word_type));
+			_size = n;
+			_clear_tail();
+		}
+
+		void clear() {_size = 0;}
+
+		// -------------------------- 元素访问 --------------------------
+		reference operator[](size_type idx) {return reference(_words + idx / __WORD_BIT,_mask(idx));}
+		const_reference operator[](size_type idx) const {return (_words[idx / __WORD_BIT] & _mask(idx)) != 0;}
+
+		reference front() {return (*this)[0];}
+		const_reference front() const {return (*this)[0];}
+		reference back() {return (*this)[_size-1];}
+		const_reference back() const {return (*this)[_size-1];}
+
+		// 底层字数组，供按字处理的代码直接使用
+		word_type* data() {return _words;}
+		const word_type* data() const {return _words;}
+		size_type word_count() const {return _word_count();}
+
+		// -------------------------- 元素插入/删除 --------------------------
+		void push_back(bool value)
+		{
+			if(_size % __WORD_BIT == 0)
+			{
+				_ensure_capacity(_size+1);
+				_words[_size / __WORD_BIT] = 0;
+			}
+			if(value)
+				_words[_size / __WORD_BIT] |= _mask(_size);
+			++_size;
+		}
+
+		void pop_back()
+		{
+			if(!empty())
+			{
+				--_size;
+				_words[_size / __WORD_BIT] &= ~_mask(_size);
+			}
+		}
+
+		// [idx, size-1) 整体后移一位：从后往前每个字左移 1，最高位进到下一个字的最低位
+		iterator insert(iterator pos,bool value)
+		{
+			size_type idx = pos - begin();
+			push_back(false);
+			size_type first = idx / __WORD_BIT;
+			for(size_type w = (_size-1) / __WORD_BIT;w>first;--w)
+				_words[w] = (_words[w] << 1) | (_words[w-1] >> (__WORD_BIT-1));
+			// idx 所在的字：低于 idx 的位不动，其余左移 1
+			word_type keep = _mask(idx) - 1;
+			_words[first] = (_words[first] & keep) | ((_words[first] & ~keep) << 1);
+			(*this)[idx] = value;
+			return begin() + idx;
+		}
+
+		iterator erase(iterator pos)
+		{
+			return erase(pos,pos+1);
+		}
+
+		// [f+n, size) 前移 n 位：每次从源位置拼出 64 位，写进目标字；只有第一个目标字要保留 f 之前的低位
+		iterator erase(iterator first,iterator last)
+		{
+			size_type f = first - begin();
+			size_type n = last - first;
+			if(n == 0)
+				return first;
+			size_type nwords = _word_count();
+			size_type new_size = _size - n;
+			for(size_type d = f;d<new_size;)
+			{
+				size_type w = d / __WORD_BIT;
+				unsigned r = (unsigned)(d % __WORD_BIT);
+				word_type bits = _bits_at(d + n,nwords);
+				word_type keep = r ? (word_type(1) << r) - 1 : 0;
+				_words[w] = (_words[w] & keep) | (bits << r);
+				d += __WORD_BIT - r;
+			}
+			_size = new_size;
+			_clear_tail();
+			return begin() + f;
+		}
+
+		// -------------------------- 按字的批量操作 --------------------------
+		// 置 1 的位数：逐字 popcount（按 CPU 选定的内核）
+		size_type count() const
+		{
+			return __popcount_kernel_for_cpu()(_words,_word_count());
+		}
+
+		bool any() const {return _scan_from(0) != npos;}
+		bool none() const {return !any();}
+
+		// 第一个为 1 的位，没有则返回 npos
+		size_type find_first() const {return _scan_from(0);}
+
+		// pos 之后（不含 pos）第一个为 1 的位，没有则返回 npos
+		size_type find_next(size_type pos) const
+		{
+			++pos;
+			if(pos >= _size) return npos;
+			size_type w = pos / __WORD_BIT;
+			// 当前字中屏蔽掉 pos 之前的位
+			word_type cur = _words[w] & (~word_type(0) << (pos % __WORD_BIT));
+			if(cur)
+				return w * __WORD_BIT + (size_type)__builtin_ctzll(cur);
+			return _scan_from(w+1);
+		}
+
+		// 所有位取反
+		void flip()
+		{
+			size_type nwords = _word_count();
+			for(size_type w = 0;w<nwords;++w)
+				_words[w] = ~_words[w];
+			_clear_tail();
+		}
+
+		// 两个位图按字做与/或/异或，长度以较短者为准（*this 多出的部分：& 清零，| ^ 不变）
+		vector& operator&=(const vector& rhs)
+		{
+			size_type n = _word_count() < rhs._word_count() ? _word_count() : rhs._word_count();
+			word_type* a = _words;
+			const word_type* b = rhs._words;
+			for(size_type w = 0;w<n;++w)
+				a[w] &= b[w];
+			if(_word_count() > n)
+				std::memset(_words + n,0,(_word_count()-n)*sizeof(word_type));
+			_clear_tail();
+			return *this;
+		}
+
+		vector& operator|=(const vector& rhs)
+		{
+			size_type n = _word_count() < rhs._word_count() ? _word_count() : rhs._word_count();
+			word_type* a = _words;
+			const word_type* b = rhs._words;
+			for(size_type w = 0;w<n;++w)
+				a[w] |= b[w];
+			_clear_tail();
+			return *this;
+		}
+
+		vector& operator^=(const vector& rhs)
+		{
+			size_type n = _word_count() < rhs._word_count() ? _word_count() : rhs._word_count();
+			word_type* a = _words;
+			const word_type* b = rhs._words;
+			for(size_type w = 0;w<n;++w)
+				a[w] ^= b[w];
+			_clear_tail();
+			return *this;
+		}
+
+		bool operator==(const vector& rhs) const
+		{
+			return _size == rhs._size &&
+				(_size == 0 || std::memcmp(_words,rhs._words,_word_count()*sizeof(word_type)) == 0);
+		}
+		bool operator!=(const vector& rhs) const {return !(*this == rhs);}
+
+		// -------------------------- 分配器相关 --------------------------
+		allocator_type get_allocator() const {return allocator_type();}
+	};
+
+	template <typename Alloc>
+	const size_t vector<bool,Alloc>::npos;
+
+	template <typename Alloc>
+	inline vector<bool,Alloc> operator&(const vector<bool,Alloc>& a,const vector<bool,Alloc>& b)
+	{
+		vector<bool,Alloc> res(a);
+		return res &= b;
+	}
+
+	template <typename Alloc>
+	inline vector<bool,Alloc> operator|(const vector<bool,Alloc>& a,const vector<bool,Alloc>& b)
+	{
+		vector<bool,Alloc> res(a);
+		return res |= b;
+	}
+
+	template <typename Alloc>
+	inline vector<bool,Alloc> operator^(const vector<bool,Alloc>& a,const vector<bool,Alloc>& b)
+	{
+		vector<bool,Alloc> res(a);
+		return res ^= b;
+	}
+
+	typedef vector<bool,alloc> bit_vector;
+}
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef LZ_STL_CONCURRENT_VECTOR_H
+#define LZ_STL_CONCURRENT_VECTOR_H
+
+/*
+concurrent_vector：多线程只追加（append-only）的 vector
+为什么需要？
+多个线程往同一个 lzstl::vector 里 push_back 时只能加互斥锁，锁成了最大的争用点
+而且 vector 扩容会搬动所有元素，别的线程手里的引用会失效
+
+做法：
+1.用一个原子计数器 _size 领取下标：fetch_add(n) 一次就拿到 [idx, idx+n)，不需要锁
+2.数据存放在按几何级数增长的段（segment）里，第 k 段容量为 __FIRST_SEGMENT << k
+	段0: [0,8)  段1: [8,24)  段2: [24,56) ...
+  下标 -> (段号, 段内偏移) 用一次 clz 算出，已有元素永远不会被移动
+3.段指针是原子的：谁先用 CAS 把空段改成"分配中"标记谁就负责分配，分配好后再发布真正的指针
+  其它线程看到"分配中"就 yield 等待，一个段只分配一次（段越往后越大，多个线程各分配一整段再还回去太浪费）
+4.每个元素有一个 ready 标志，构造完成后 release 写入
+  读线程用 ready(i) acquire 读取后即可安全访问已完成的元素
+
+注意：二级配置器的自由链表不是线程安全的，所以默认用 malloc_alloc
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <utility>
+#include "alloc.h"
+#include "construct.h"
+
+namespace lzstl
+{
+	template <typename T,typename Alloc = malloc_alloc>
+	class concurrent_vector
+	{
+	public:
+		typedef T			value_type;
+		typedef T&			reference;
+		typedef const T&	const_reference;
+		typedef size_t		size_type;
+		typedef ptrdiff_t	difference_type;
+		typedef Alloc		allocator_type;
+
+	private:
+		enum {__FIRST_SEGMENT = 8};		// 第0段的元素个数
+		enum {__MAX_SEGMENTS = 48};		// 8 * (2^48 - 1) 个元素，足够用了
+
+		// 段的内存布局：[T 元素 * cap][ready 标志 * cap]
+		std::atomic<T*>	  _segments[__MAX_SEGMENTS];
+		std::atomic<size_type> _size;		// 已领取的下标个数（可能还在构造中）
+
+		// -------------------------- 下标 <-> 段 --------------------------
+		static size_type _segment_of(size_type idx)
+		{
+			return 63 - __builtin_clzll((unsigned long long)(idx / __FIRST_SEGMENT + 1));
+		}
+
+		static size_type _segment_base(size_type k)
+		{
+			return (size_type)__FIRST_SEGMENT * (((size_type)1 << k) - 1);
+		}
+
+		static size_type _segment_capacity(size_type k)
+		{
+			return (size_type)__FIRST_SEGMENT << k;
+		}
+
+		static size_type _segment_bytes(size_type k)
+		{
+			return _segment_capacity(k) * (sizeof(T) + sizeof(std::atomic<bool>));
+		}
+
+		static std::atomic<bool>* _flags(T* seg,size_type k)
+		{
+			return reinterpret_cast<std::atomic<bool>*>(seg + _segment_capacity(k));
+		}
+
+		// 段正在被某个线程分配时的标记，不是合法地址
+		static T* _pending() {return reinterpret_cast<T*>(uintptr_t(1));}
+
+		// 取得第 k 段，不存在则分配；只有把空段 CAS 成 _pending() 的线程去分配，其它线程等它发布
+		T* _get_segment(size_type k)
+		{
+			for(;;)
+			{
+				T* seg = _segments[k].load(std::memory_order_acquire);
+				if(seg && seg != _pending())
+					return seg;
+				if(!seg && _segments[k].compare_exchange_strong(seg,_pending(),std::memory_order_acquire))
+				{
+					T* fresh;
+					try
+					{
+						fresh = static_cast<T*>(Alloc::allocate(_segment_bytes(k)));
+					}
+					catch(...)
+					{
+						// 分配失败：把段还原为空，等待的线程会自己重试
+						_segments[k].store(nullptr,std::memory_order_release);
+						throw;
+					}
+					std::atomic<bool>* flags = _flags(fresh,k);
+					for(size_type i = 0;i<_segment_capacity(k);++i)
+						new (flags+i) std::atomic<bool>(false);
+					_segments[k].store(fresh,std::memory_order_release);
+					return fresh;
+				}
+				if(seg == _pending())
+					std::this_thread::yield();
+			}
+		}
+
+		// 确保 [first, last) 涉及的段都已存在
+		void _ensure_segments(size_type first,size_type last)
+		{
+			if(first == last) return;
+			for(size_type k = _segment_of(first);k<=_segment_of(last-1);++k)
+				_get_segment(k);
+		}
+
+		T* _slot(size_type idx) const
+		{
+			size_type k = _segment_of(idx);
+			return _segments[k].load(std::memory_order_acquire) + (idx - _segment_base(k));
+		}
+
+		void _publish(size_type idx)
+		{
+			size_type k = _segment_of(idx);
+			T* seg = _segments[k].load(std::memory_order_relaxed);
+			_flags(seg,k)[idx - _segment_base(k)].store(true,std::memory_order_release);
+		}
+
+		concurrent_vector(const concurrent_vector&);
+		concurrent_vector& operator=(const concurrent_vector&);
+
+	public:
+		// -------------------------- 构造函数/析构函数 --------------------------
+		concurrent_vector():_size(0)
+		{
+			for(size_type k = 0;k<__MAX_SEGMENTS;++k)
+				_segments[k].store(nullptr,std::memory_order_relaxed);
+		}
+
+		// 析构时要求没有其它线程再访问
+		~concurrent_vector()
+		{
+			clear();
+			for(size_type k = 0;k<__MAX_SEGMENTS;++k)
+			{
+				T* seg = _segments[k].load(std::memory_order_relaxed);
+				if(seg)
+					Alloc::deallocate(seg,_segment_bytes(k));
+			}
+		}
+
+		// -------------------------- 无锁追加 --------------------------
+		// 返回新元素的下标
+		size_type push_back(const value_type& value)
+		{
+			size_type idx = _size.fetch_add(1,std::memory_order_relaxed);
+			size_type k = _segment_of(idx);
+			lzstl::construct(_get_segment(k) + (idx - _segment_base(k)),value);
+			_publish(idx);
+			return idx;
+		}
+
+		size_type push_back(value_type&& value)
+		{
+			size_type idx = _size.fetch_add(1,std::memory_order_relaxed);
+			size_type k = _segment_of(idx);
+			lzstl::construct(_get_segment(k) + (idx - _segment_base(k)),std::move(value));
+			_publish(idx);
+			return idx;
+		}
+
+		// 一次领取 n 个连续下标并构造为 value，返回第一个下标
+		// [idx, idx+n) 可能跨段：按段切成连续的几截，每截用 construct_n 批量构造后再逐个发布
+		size_type grow_by(size_type n,const value_type& value = value_type())
+		{
+			size_type idx = _size.fetch_add(n,std::memory_order_relaxed);
+			_ensure_segments(idx,idx+n);
+			size_type last = idx + n;
+			for(size_type i = idx;i<last;)
+			{
+				size_type k = _segment_of(i);
+				size_type off = i - _segment_base(k);
+				size_type run = _segment_capacity(k) - off;
+				if(run > last - i)
+					run = last - i;
+				lzstl::construct_n(_segments[k].load(std::memory_order_acquire) + off,run,value);
+				for(size_type j = i;j<i+run;++j)
+					_publish(j);
+				i += run;
+			}
+			return idx;
+		}
+
+		// 预先分配能容纳 n 个元素的段，避免追加时的分配竞争
+		void reserve(size_type n)
+		{
+			_ensure_segments(0,n);
+		}
+
+		// -------------------------- 读访问 --------------------------
+		// 已领取的下标个数；其中可能有元素还在构造中，配合 ready() 使用
+		size_type size() const {return _size.load(std::memory_order_acquire);}
+		bool empty() const {return size() == 0;}
+
+		// 第 idx 个元素是否已构造完成（acquire：之后读到的一定是完整对象）
+		bool ready(size_type idx) const
+		{
+			if(idx >= size()) return false;
+			size_type k = _segment_of(idx);
+			T* seg = _segments[k].load(std::memory_order_acquire);
+			return seg && seg != _pending() && _flags(seg,k)[idx - _segment_base(k)].load(std::memory_order_acquire);
+		}
+
+		// 调用方需保证该元素已完成（ready 为真，或由 push_back 的返回值同步得到）
+		reference operator[](size_type idx) {return *_slot(idx);}
+		const_reference operator[](size_type idx) const {return *_slot(idx);}
+
+		// 已分配的总容量（所有已存在段之和）
+		size_type capacity() const
+		{
+			size_type cap = 0;
+			for(size_type k = 0;k<__MAX_SEGMENTS;++k)
+			{
+				T* seg = _segments[k].load(std::memory_order_acquire);
+				if(seg && seg != _pending())
+					cap += _segment_capacity(k);
+			}
+			return cap;
+		}
+
+		// 非并发操作：析构所有已完成的元素，段保留以便复用
+		// 构造时抛异常的下标没有 ready 标志，这里跳过
+		void clear()
+		{
+			size_type n = _size.load(std::memory_order_relaxed);
+			for(size_type i = 0;i<n;++i)
+			{
+				size_type k = _segment_of(i);
+				T* seg = _segments[k].load(std::memory_order_relaxed);
+				if(!seg) continue;
+				std::atomic<bool>& flag = _flags(seg,k)[i - _segment_base(k)];
+				if(flag.load(std::memory_order_relaxed))
+				{
+					lzstl::destroy(seg + (i - _segment_base(k)));
+					flag.store(false,std::memory_order_relaxed);
+				}
+			}
+			_size.store(0,std::memory_order_relaxed);
+		}
+
+		allocator_type get_allocator() const {return allocator_type();}
+	};
+}
+
+#endif
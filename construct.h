@@ -1,6 +1,7 @@
 #ifndef LZ_STL_CONSTRUCT_H
 #define LZ_STL_CONSTRUCT_H
 
+#include <cstring>
 #include <new>
 #include <utility>
 #include "alloc.h"
@@ -29,11 +30,11 @@ namespace lzstl
 		new(ptr) T(std::forward<Value>(value));
 	}
 	
+	// 调用方保证 ptr 非空，热路径上不再逐个判空
 	template <typename T>
 	inline void construct(T* ptr)
 	{
-		if(!ptr) return ;
-		new(ptr) T();       
+		new(ptr) T();
 	}
 	
 	// 2. 析构函数：销毁对象（不释放内存）
@@ -42,8 +43,7 @@ namespace lzstl
 	inline void destroy(T* ptr)
 	{
 		// 显式调用 析构函数 默认或者 用户自定义都可以
-		if(ptr!= nullptr)
-			ptr-> ~T();
+		ptr->~T();
 	}
 	
 	// 2.2 销毁范围内的对象
@@ -58,9 +58,10 @@ namespace lzstl
 	template <typename ForwardIter>
 	inline void __destroy_range(ForwardIter first,ForwardIter last,false_type)
 	{
-		// 解引用迭代器 再获取对象地址，调用单个析构
+		// 解引用迭代器 再获取对象地址，直接调用析构
+		typedef typename iterator_traits<ForwardIter>::value_type value_type;
 		for(;first != last;++first)
-			destroy(&*first) ;
+			(&*first)->~value_type();
 	}
 	
 	// 辅助函数 平凡 true_type
@@ -82,6 +83,89 @@ namespace lzstl
 	{
 		__destroy_range(first, last, true_type());
 	}
+
+	// 3. 批量析构：销毁从 first 开始的 n 个对象，返回 first+n
+	// 平凡析构直接跳过；否则是一个没有判空、没有分支的紧凑循环
+	template <typename T,typename Size>
+	inline T* __destroy_n(T* first,Size n,true_type)
+	{
+		return first + n;
+	}
+
+	template <typename ForwardIter,typename Size>
+	inline ForwardIter __destroy_n(ForwardIter first,Size n,true_type)
+	{
+		for(;n>0;--n)
+			++first;
+		return first;
+	}
+
+	template <typename ForwardIter,typename Size>
+	inline ForwardIter __destroy_n(ForwardIter first,Size n,false_type)
+	{
+		typedef typename iterator_traits<ForwardIter>::value_type value_type;
+		for(;n>0;--n,++first)
+			(&*first)->~value_type();
+		return first;
+	}
+
+	template <typename ForwardIter,typename Size>
+	inline ForwardIter destroy_n(ForwardIter first,Size n)
+	{
+		typedef typename iterator_traits<ForwardIter>::value_type value_type;
+		return __destroy_n(first,n,typename type_traits<value_type>::has_trivial_destructor());
+	}
+
+	// 4. 批量构造：用同一组参数在从 first 开始的 n 个位置上构造对象，返回 first+n
+	// 构造中途抛异常时，已构造的对象全部析构后再把异常抛出（要么全成功，要么什么都没做）
+	// args 要用 n 次，所以按 const 引用传，不做完美转发
+
+	// POD + 无参数：值初始化就是全 0，一次 memset
+	template <typename T,typename Size>
+	inline T* __construct_n(T* first,Size n,true_type)
+	{
+		if(n > 0)
+			std::memset(static_cast<void*>(first),0,size_t(n) * sizeof(T));
+		return first + n;
+	}
+
+	// POD + 一个参数：逐个赋值不会抛异常，循环体足够简单，编译器可以向量化
+	template <typename ForwardIter,typename Size,typename Value>
+	inline ForwardIter __construct_n(ForwardIter first,Size n,true_type,const Value& value)
+	{
+		typedef typename iterator_traits<ForwardIter>::value_type value_type;
+		const value_type v(value);
+		for(;n>0;--n,++first)
+			*first = v;
+		return first;
+	}
+
+	// 一般情况：placement new，失败时回滚
+	template <typename ForwardIter,typename Size,typename IsPOD,typename... Args>
+	ForwardIter __construct_n(ForwardIter first,Size n,IsPOD,const Args&... args)
+	{
+		typedef typename iterator_traits<ForwardIter>::value_type value_type;
+		ForwardIter cur = first;
+		Size done = 0;
+		try
+		{
+			for(;done<n;++done,++cur)
+				new (static_cast<void*>(&*cur)) value_type(args...);
+			return cur;
+		}
+		catch(...)
+		{
+			lzstl::destroy_n(first,done);
+			throw;
+		}
+	}
+
+	template <typename ForwardIter,typename Size,typename... Args>
+	inline ForwardIter construct_n(ForwardIter first,Size n,const Args&... args)
+	{
+		typedef typename iterator_traits<ForwardIter>::value_type value_type;
+		return __construct_n(first,n,typename type_traits<value_type>::is_POD_type(),args...);
+	}
 }
 
 #endif
@@ -0,0 +1,798 @@
+#ifndef LZ_STL_DEQUE_H
+#define LZ_STL_DEQUE_H
+
+#include "type_traits.h"
+#include "alloc.h"
+#include "iterator.h"
+#include "construct.h"
+#include "uninitialized.h"
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+/*
+deque：双端队列，两端插入/删除均摊 O(1)
+为什么需要？
+工作队列在两端进出，vector 头部插入要把所有元素后移一位，O(n)
+
+做法（与 SGI 相同的分块结构）：
+1.元素存放在固定大小的块里，每块 __deque_buf_size(sizeof(T)) 个元素（约 512 字节）
+2.中控器 map 是一段连续的块指针数组，[_start.node, _finish.node] 指向正在使用的块
+  map 的一端用完时：已用的块指针不到一半就在原 map 里居中，否则换一个更大的 map
+  两种情况都只搬块指针，元素不动，所以两端插入不会使元素的引用失效
+3.迭代器保存 cur/first/last/node，走出当前块时通过 node 找到相邻的块，是随机访问迭代器
+4.块的复用：弹空的块先放进一个小的空闲块栈（最多 __DEQUE_MAX_SPARE 块），要新块时先从这里取
+  队列负载（push_back + pop_front）在块边界上不再反复分配、归还
+5.块和 map 都从 Alloc 分配（默认是二级配置器 alloc），小 map 正好落在自由链表里
+  和 vector 一样，默认的 alloc 不是线程安全的
+
+不变式：_finish.cur 总是指向某个已分配块里的空位
+	所以 push_back 写满一块的最后一个位置之前，就要先准备好下一块
+*/
+
+namespace lzstl
+{
+	// 每块的元素个数：元素小于 512 字节时一块约 512 字节，否则一块一个元素
+	inline size_t __deque_buf_size(size_t sz)
+	{
+		return sz < 512 ? 512 / sz : 1;
+	}
+
+	enum {__DEQUE_MAX_SPARE = 4};			// 最多缓存的空闲块数
+	enum {__DEQUE_INITIAL_MAP_SIZE = 8};	// map 的最小长度
+
+	template <typename T,bool IsConst>
+	struct __deque_iterator
+	{
+		typedef random_access_iterator_tag	iterator_category;
+		typedef T							value_type;
+		typedef ptrdiff_t					difference_type;
+		typedef typename std::conditional<IsConst,const T*,T*>::type pointer;
+		typedef typename std::conditional<IsConst,const T&,T&>::type reference;
+		typedef T**							map_pointer;
+
+		T* cur;				// 当前元素
+		T* first;			// 当前块的起点
+		T* last;			// 当前块的终点（尾后）
+		map_pointer node;	// 当前块在 map 中的位置
+
+		static difference_type buffer_size() {return difference_type(__deque_buf_size(sizeof(T)));}
+
+		__deque_iterator():cur(nullptr),first(nullptr),last(nullptr),node(nullptr){}
+		__deque_iterator(T* x,map_pointer y):cur(x),first(*y),last(*y + buffer_size()),node(y){}
+		// iterator 可隐式转换为 const_iterator
+		// 写成模板，拷贝构造/拷贝赋值就仍是编译器生成的平凡版本（否则 -Wextra 报 -Wdeprecated-copy）
+		template <bool C,typename = typename std::enable_if<IsConst && !C>::type>
+		__deque_iterator(const __deque_iterator<T,C>& rhs):cur(rhs.cur),first(rhs.first),last(rhs.last),node(rhs.node){}
+
+		// 切换到 new_node 指向的块，cur 由调用方设置
+		void set_node(map_pointer new_node)
+		{
+			node = new_node;
+			first = *new_node;
+			last = first + buffer_size();
+		}
+
+		reference operator*() const {return *cur;}
+		pointer operator->() const {return cur;}
+
+		difference_type operator-(const __deque_iterator& x) const
+		{
+			if(node == x.node)
+				return cur - x.cur;
+			return buffer_size() * (node - x.node - 1) + (cur - first) + (x.last - x.cur);
+		}
+
+		__deque_iterator& operator++()
+		{
+			++cur;
+			if(cur == last)
+			{
+				set_node(node + 1);
+				cur = first;
+			}
+			return *this;
+		}
+		__deque_iterator operator++(int) {__deque_iterator tmp = *this;++*this;return tmp;}
+
+		__deque_iterator& operator--()
+		{
+			if(cur == first)
+			{
+				set_node(node - 1);
+				cur = last;
+			}
+			--cur;
+			return *this;
+		}
+		__deque_iterator operator--(int) {__deque_iterator tmp = *this;--*this;return tmp;}
+
+		// 目标仍在当前块内只移动 cur；否则先算出跨过几块，再定位块内偏移
+		__deque_iterator& operator+=(difference_type n)
+		{
+			difference_type offset = n + (cur - first);
+			if(offset >= 0 && offset < buffer_size())
+				cur += n;
+			else
+			{
+				difference_type node_offset = offset > 0 ? offset / buffer_size()
+														 : -difference_type((-offset - 1) / buffer_size()) - 1;
+				set_node(node + node_offset);
+				cur = first + (offset - node_offset * buffer_size());
+			}
+			return *this;
+		}
+		__deque_iterator& operator-=(difference_type n) {return *this += -n;}
+		__deque_iterator operator+(difference_type n) const {__deque_iterator tmp = *this;return tmp += n;}
+		__deque_iterator operator-(difference_type n) const {__deque_iterator tmp = *this;return tmp -= n;}
+		reference operator[](difference_type n) const {return *(*this + n);}
+
+		bool operator==(const __deque_iterator& x) const {return cur == x.cur;}
+		bool operator!=(const __deque_iterator& x) const {return cur != x.cur;}
+		bool operator<(const __deque_iterator& x) const {return node == x.node ? cur < x.cur : node < x.node;}
+		bool operator>(const __deque_iterator& x) const {return x < *this;}
+		bool operator<=(const __deque_iterator& x) const {return !(x < *this);}
+		bool operator>=(const __deque_iterator& x) const {return !(*this < x);}
+	};
+
+	template <typename T,typename Alloc = alloc>
+	class deque
+	{
+	public:
+		typedef T 							value_type;
+		typedef __deque_iterator<T,false>	iterator;
+		typedef __deque_iterator<T,true>	const_iterator;
+		typedef T&							reference;
+		typedef const T&					const_reference;
+		typedef size_t						size_type;
+		typedef ptrdiff_t 					difference_type;
+		typedef Alloc 						allocator_type;
+	private:
+		typedef T** map_pointer;
+
+		iterator	_start;			// 第一个元素
+		iterator	_finish;		// 最后一个元素的下一个位置
+		map_pointer	_map;			// 块指针数组
+		size_type	_map_size;		// map 的长度
+		T*			_spare;			// 空闲块栈：每块开头存放下一块的地址
+		size_type	_nspare;
+
+		static size_type _buffer_size() {return __deque_buf_size(sizeof(T));}
+
+		// -------------------------- 块与 map 的分配 --------------------------
+		T* _allocate_node()
+		{
+			if(_spare)
+			{
+				T* p = _spare;
+				std::memcpy(&_spare,static_cast<const void*>(p),sizeof(T*));
+				--_nspare;
+				return p;
+			}
+			return static_cast<T*>(Alloc::allocate(_buffer_size()*sizeof(T)));
+		}
+
+		// 先放回空闲块栈，栈满了才还给 Alloc
+		void _deallocate_node(T* p)
+		{
+			if(_nspare < __DEQUE_MAX_SPARE)
+			{
+				std::memcpy(static_cast<void*>(p),&_spare,sizeof(T*));
+				_spare = p;
+				++_nspare;
+			}
+			else
+				Alloc::deallocate(p,_buffer_size()*sizeof(T));
+		}
+
+		void _release_spare()
+		{
+			while(_spare)
+			{
+				T* next;
+				std::memcpy(&next,static_cast<const void*>(_spare),sizeof(T*));
+				Alloc::deallocate(_spare,_buffer_size()*sizeof(T));
+				_spare = next;
+			}
+			_nspare = 0;
+		}
+
+		map_pointer _allocate_map(size_type n) {return static_cast<map_pointer>(Alloc::allocate(n*sizeof(T*)));}
+		void _deallocate_map(map_pointer p,size_type n) {Alloc::deallocate(p,n*sizeof(T*));}
+
+		// 建立只有一块的空 deque，这块放在 map 中间，两端都留出增长的余地
+		void _initialize_map()
+		{
+			_map_size = __DEQUE_INITIAL_MAP_SIZE;
+			_map = _allocate_map(_map_size);
+			map_pointer node = _map + _map_size / 2;
+			try
+			{
+				*node = _allocate_node();
+			}
+			catch(...)
+			{
+				_deallocate_map(_map,_map_size);
+				throw;
+			}
+			_start.set_node(node);
+			_start.cur = _start.first;
+			_finish = _start;
+		}
+
+		// 归还所有块和 map（调用前元素已析构）
+		void _destroy_storage()
+		{
+			for(map_pointer node = _start.node;node <= _finish.node;++node)
+				Alloc::deallocate(*node,_buffer_size()*sizeof(T));
+			_release_spare();
+			_deallocate_map(_map,_map_size);
+		}
+
+		// 析构 [first, last) 的元素，按块批量调用 destroy_n
+		void _destroy(iterator first,iterator last)
+		{
+			if(first.node == last.node)
+			{
+				lzstl::destroy_n(first.cur,last.cur - first.cur);
+				return;
+			}
+			lzstl::destroy_n(first.cur,first.last - first.cur);
+			for(map_pointer node = first.node + 1;node < last.node;++node)
+				lzstl::destroy_n(*node,_buffer_size());
+			lzstl::destroy_n(last.first,last.cur - last.first);
+		}
+
+		// map 尾部至少还能再放 nodes_to_add 个块指针
+		void _reserve_map_at_back(size_type nodes_to_add = 1)
+		{
+			if(nodes_to_add + 1 > _map_size - size_type(_finish.node - _map))
+				_reallocate_map(nodes_to_add,false);
+		}
+
+		// map 头部至少还能再放 nodes_to_add 个块指针
+		void _reserve_map_at_front(size_type nodes_to_add = 1)
+		{
+			if(nodes_to_add > size_type(_start.node - _map))
+				_reallocate_map(nodes_to_add,true);
+		}
+
+		// 原 map 足够长（超过所需的两倍）就把块指针居中，否则换一个更大的 map
+		void _reallocate_map(size_type nodes_to_add,bool add_at_front)
+		{
+			size_type old_num_nodes = _finish.node - _start.node + 1;
+			size_type new_num_nodes = old_num_nodes + nodes_to_add;
+			map_pointer new_nstart;
+			if(_map_size > 2 * new_num_nodes)
+			{
+				new_nstart = _map + (_map_size - new_num_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+				std::memmove(new_nstart,_start.node,old_num_nodes*sizeof(T*));
+			}
+			else
+			{
+				size_type new_map_size = _map_size + (_map_size > nodes_to_add ? _map_size : nodes_to_add) + 2;
+				map_pointer new_map = _allocate_map(new_map_size);
+				new_nstart = new_map + (new_map_size - new_num_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+				std::memcpy(new_nstart,_start.node,old_num_nodes*sizeof(T*));
+				_deallocate_map(_map,_map_size);
+				_map = new_map;
+				_map_size = new_map_size;
+			}
+			_start.set_node(new_nstart);
+			_finish.set_node(new_nstart + old_num_nodes - 1);
+		}
+
+		// 为尾部再放 n 个元素准备好块，返回 _finish + n
+		iterator _reserve_elements_at_back(size_type n)
+		{
+			size_type vacancies = _finish.last - _finish.cur - 1;
+			if(n > vacancies)
+				_new_elements_at_back(n - vacancies);
+			return _finish + difference_type(n);
+		}
+
+		void _new_elements_at_back(size_type new_elements)
+		{
+			size_type new_nodes = (new_elements + _buffer_size() - 1) / _buffer_size();
+			_reserve_map_at_back(new_nodes);
+			size_type i = 1;
+			try
+			{
+				for(;i<=new_nodes;++i)
+					*(_finish.node + i) = _allocate_node();
+			}
+			catch(...)
+			{
+				for(size_type j = 1;j<i;++j)
+					_deallocate_node(*(_finish.node + j));
+				throw;
+			}
+		}
+
+		// 追加失败时归还 _finish.node 之后、到 last_node 为止的块
+		void _free_nodes_after_finish(map_pointer last_node)
+		{
+			for(map_pointer node = _finish.node + 1;node <= last_node;++node)
+				_deallocate_node(*node);
+		}
+
+		// 在尾部构造 n 个元素（args 为空时值初始化），按块批量调用 construct_n
+		// 中途抛异常时回滚到调用前的状态
+		template <typename... Args>
+		void _append_n(size_type n,const Args&... args)
+		{
+			iterator new_finish = _reserve_elements_at_back(n);
+			iterator cur = _finish;
+			try
+			{
+				while(cur != new_finish)
+				{
+					difference_type k = (cur.node == new_finish.node ? new_finish.cur : cur.last) - cur.cur;
+					lzstl::construct_n(cur.cur,k,args...);
+					cur += k;
+				}
+			}
+			catch(...)
+			{
+				_destroy(_finish,cur);
+				_free_nodes_after_finish(new_finish.node);
+				throw;
+			}
+			_finish = new_finish;
+		}
+
+		// 在尾部复制从 first 开始的 n 个元素，每块一次 uninitialized_copy
+		template <typename RandomAccessIterator>
+		void _append_copy(RandomAccessIterator first,size_type n)
+		{
+			iterator new_finish = _reserve_elements_at_back(n);
+			iterator cur = _finish;
+			try
+			{
+				while(cur != new_finish)
+				{
+					difference_type k = (cur.node == new_finish.node ? new_finish.cur : cur.last) - cur.cur;
+					lzstl::uninitialized_copy(first,first + k,cur.cur);
+					first += k;
+					cur += k;
+				}
+			}
+			catch(...)
+			{
+				_destroy(_finish,cur);
+				_free_nodes_after_finish(new_finish.node);
+				throw;
+			}
+			_finish = new_finish;
+		}
+
+		// 随机访问迭代器：个数已知，按块复制
+		template <typename InputIterator>
+		void _append_range(InputIterator first,InputIterator last,true_type)
+		{
+			_append_copy(first,size_type(last - first));
+		}
+
+		// 其余迭代器：逐个追加
+		template <typename InputIterator>
+		void _append_range(InputIterator first,InputIterator last,false_type)
+		{
+			for(;first != last;++first)
+				emplace_back(*first);
+		}
+
+		// 整数：实际是 (n, value)
+		template <typename Integer>
+		void _range_initialize(Integer n,Integer value,true_type)
+		{
+			_append_n(size_type(n),value_type(value));
+		}
+
+		template <typename InputIterator>
+		void _range_initialize(InputIterator first,InputIterator last,false_type)
+		{
+			_append_range(first,last,typename __is_random_access_iterator<InputIterator>::type());
+		}
+
+		// 当前块已满时的 push_back：先准备好下一块，再在当前块的最后一个位置构造
+		template <typename... Args>
+		void _push_back_aux(Args&&... args)
+		{
+			_reserve_map_at_back();
+			*(_finish.node + 1) = _allocate_node();
+			try
+			{
+				::new (static_cast<void*>(_finish.cur)) value_type(std::forward<Args>(args)...);
+			}
+			catch(...)
+			{
+				_deallocate_node(*(_finish.node + 1));
+				throw;
+			}
+			_finish.set_node(_finish.node + 1);
+			_finish.cur = _finish.first;
+		}
+
+		// 第一块已经用到开头时的 push_front：在前面新增一块，构造在它的最后一个位置
+		template <typename... Args>
+		void _push_front_aux(Args&&... args)
+		{
+			_reserve_map_at_front();
+			*(_start.node - 1) = _allocate_node();
+			try
+			{
+				::new (static_cast<void*>(*(_start.node - 1) + _buffer_size() - 1)) value_type(std::forward<Args>(args)...);
+			}
+			catch(...)
+			{
+				_deallocate_node(*(_start.node - 1));
+				throw;
+			}
+			_start.set_node(_start.node - 1);
+			_start.cur = _start.last - 1;
+		}
+
+	public:
+		// -------------------------- 构造函数/析构函数/赋值运算符 --------------------------
+		// 默认构造：分配 map 和一个块（_finish 总要指向一个已分配的块）
+		deque():_map(nullptr),_map_size(0),_spare(nullptr),_nspare(0)
+		{
+			_initialize_map();
+		}
+
+		// 构造n个值初始化的元素（POD 为 0）
+		explicit deque(size_type n):_map(nullptr),_map_size(0),_spare(nullptr),_nspare(0)
+		{
+			_initialize_map();
+			try
+			{
+				_append_n(n);
+			}
+			catch(...)
+			{
+				_destroy_storage();
+				throw;
+			}
+		}
+
+		// 构造n个值为value的元素
+		deque(size_type n,const value_type& value):_map(nullptr),_map_size(0),_spare(nullptr),_nspare(0)
+		{
+			_initialize_map();
+			try
+			{
+				_append_n(n,value);
+			}
+			catch(...)
+			{
+				_destroy_storage();
+				throw;
+			}
+		}
+
+		// 迭代器范围构造，deque<int> d(10, 1) 用 is_integral 分派回 (n, value)
+		template <typename InputIterator>
+		deque(InputIterator first,InputIterator last):_map(nullptr),_map_size(0),_spare(nullptr),_nspare(0)
+		{
+			_initialize_map();
+			try
+			{
+				_range_initialize(first,last,is_integral<InputIterator>());
+			}
+			catch(...)
+			{
+				_destroy(_start,_finish);
+				_destroy_storage();
+				throw;
+			}
+		}
+
+		deque(const deque& rhs):_map(nullptr),_map_size(0),_spare(nullptr),_nspare(0)
+		{
+			_initialize_map();
+			try
+			{
+				_append_copy(rhs.begin(),rhs.size());
+			}
+			catch(...)
+			{
+				_destroy_storage();
+				throw;
+			}
+		}
+
+		// 移动构造：先建一个空 deque 再交换，rhs 留下的空 deque 仍然可用
+		// 和 libstdc++ 一样，为此要分配一个块，所以不是 noexcept
+		deque(deque&& rhs):_map(nullptr),_map_size(0),_spare(nullptr),_nspare(0)
+		{
+			_initialize_map();
+			swap(rhs);
+		}
+
+		~deque()
+		{
+			_destroy(_start,_finish);
+			_destroy_storage();
+		}
+
+		// 复制后交换：复制失败时 *this 不变
+		deque& operator=(const deque& rhs)
+		{
+			if(this != &rhs)
+			{
+				deque tmp(rhs);
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		deque& operator=(deque&& rhs)
+		{
+			if(this != &rhs)
+				swap(rhs);
+			return *this;
+		}
+
+		// -------------------------- 迭代器接口 --------------------------
+		iterator begin() {return _start;}
+		const_iterator begin() const {return _start;}
+		iterator end() {return _finish;}
+		const_iterator end() const {return _finish;}
+
+		// -------------------------- 容量与大小操作 --------------------------
+		size_type size() const {return _finish - _start;}
+		bool empty() const {return _finish == _start;}
+
+		void resize(size_type n)
+		{
+			if(n < size())
+				erase(_start + difference_type(n),_finish);
+			else
+				_append_n(n - size());
+		}
+
+		void resize(size_type n,const value_type& value)
+		{
+			if(n < size())
+				erase(_start + difference_type(n),_finish);
+			else
+				_append_n(n - size(),value);
+		}
+
+		// 归还缓存的空闲块
+		void shrink_to_fit()
+		{
+			_release_spare();
+		}
+
+		void swap(deque& rhs)
+		{
+			std::swap(_start,rhs._start);
+			std::swap(_finish,rhs._finish);
+			std::swap(_map,rhs._map);
+			std::swap(_map_size,rhs._map_size);
+			std::swap(_spare,rhs._spare);
+			std::swap(_nspare,rhs._nspare);
+		}
+
+		// -------------------------- 元素访问 --------------------------
+		reference operator[](size_type idx) {return _start[difference_type(idx)];}
+		const_reference operator[](size_type idx) const {return _start[difference_type(idx)];}
+
+		reference front() {return *_start.cur;}
+		const_reference front() const {return *_start.cur;}
+		reference back() {iterator tmp = _finish;--tmp;return *tmp;}
+		const_reference back() const {iterator tmp = _finish;--tmp;return *tmp;}
+
+		// -------------------------- 元素插入/删除 --------------------------
+		void push_back(const value_type& value) {emplace_back(value);}
+		void push_back(value_type&& value) {emplace_back(std::move(value));}
+		void push_front(const value_type& value) {emplace_front(value);}
+		void push_front(value_type&& value) {emplace_front(std::move(value));}
+
+		// 元素不会因为两端插入而移动，args 引用本 deque 的元素也是安全的
+		template <typename... Args>
+		reference emplace_back(Args&&... args)
+		{
+			if(_finish.cur != _finish.last - 1)
+			{
+				::new (static_cast<void*>(_finish.cur)) value_type(std::forward<Args>(args)...);
+				++_finish.cur;
+			}
+			else
+				_push_back_aux(std::forward<Args>(args)...);
+			return back();
+		}
+
+		template <typename... Args>
+		reference emplace_front(Args&&... args)
+		{
+			if(_start.cur != _start.first)
+			{
+				::new (static_cast<void*>(_start.cur - 1)) value_type(std::forward<Args>(args)...);
+				--_start.cur;
+			}
+			else
+				_push_front_aux(std::forward<Args>(args)...);
+			return *_start.cur;
+		}
+
+		// 弹空的块放回空闲块栈
+		void pop_back()
+		{
+			if(_finish.cur == _finish.first)
+			{
+				_deallocate_node(_finish.first);
+				_finish.set_node(_finish.node - 1);
+				_finish.cur = _finish.last;
+			}
+			--_finish.cur;
+			lzstl::destroy(_finish.cur);
+		}
+
+		void pop_front()
+		{
+			lzstl::destroy(_start.cur);
+			if(_start.cur != _start.last - 1)
+				++_start.cur;
+			else
+			{
+				_deallocate_node(_start.first);
+				_start.set_node(_start.node + 1);
+				_start.cur = _start.first;
+			}
+		}
+
+		// 只保留一个块
+		void clear()
+		{
+			_destroy(_start,_finish);
+			for(map_pointer node = _start.node + 1;node <= _finish.node;++node)
+				_deallocate_node(*node);
+			_finish = _start;
+		}
+
+		// 在 pos 前插入：离哪一端近就挪哪一端
+		template <typename... Args>
+		iterator emplace(iterator pos,Args&&... args)
+		{
+			if(pos.cur == _start.cur)
+			{
+				emplace_front(std::forward<Args>(args)...);
+				return _start;
+			}
+			if(pos.cur == _finish.cur)
+			{
+				emplace_back(std::forward<Args>(args)...);
+				return _finish - 1;
+			}
+
+			difference_type idx = pos - _start;
+			value_type tmp(std::forward<Args>(args)...);
+			iterator target;
+			if(size_type(idx) < size() / 2)
+			{
+				// 复制一份头元素放到最前面，[1, idx) 前移一位
+				emplace_front(std::move(front()));
+				target = _start + idx;
+				iterator dst = _start + 1;
+				while(dst != target)
+				{
+					iterator src = dst;
+					++src;
+					*dst = std::move(*src);
+					dst = src;
+				}
+			}
+			else
+			{
+				// 复制一份尾元素放到最后面，[idx, size-1) 后移一位
+				emplace_back(std::move(back()));
+				target = _start + idx;
+				iterator dst = _finish - 2;
+				while(dst != target)
+				{
+					iterator src = dst;
+					--src;
+					*dst = std::move(*src);
+					dst = src;
+				}
+			}
+			*target = std::move(tmp);
+			return target;
+		}
+
+		iterator insert(iterator pos,const value_type& value)
+		{
+			return emplace(pos,value);
+		}
+
+		iterator insert(iterator pos,value_type&& value)
+		{
+			return emplace(pos,std::move(value));
+		}
+
+		// 删除 pos：离哪一端近就挪哪一端
+		iterator erase(iterator pos)
+		{
+			difference_type idx = pos - _start;
+			if(size_type(idx) < size() / 2)
+			{
+				iterator dst = pos;
+				while(dst != _start)
+				{
+					iterator src = dst;
+					--src;
+					*dst = std::move(*src);
+					dst = src;
+				}
+				pop_front();
+			}
+			else
+			{
+				iterator dst = pos;
+				iterator src = pos;
+				for(++src;src != _finish;++src,++dst)
+					*dst = std::move(*src);
+				pop_back();
+			}
+			return _start + idx;
+		}
+
+		iterator erase(iterator first,iterator last)
+		{
+			// 空区间什么也不做，否则下面会把元素移动赋值给自己
+			if(first == last)
+				return first;
+			if(first.cur == _start.cur && last.cur == _finish.cur)
+			{
+				clear();
+				return _finish;
+			}
+			difference_type n = last - first;
+			difference_type before = first - _start;
+			if(size_type(before) < (size() - n) / 2)
+			{
+				// 前面的元素后移 n 位，再析构头部多出来的 n 个并归还空出的块
+				iterator dst = last;
+				iterator src = first;
+				while(src != _start)
+				{
+					--src;
+					--dst;
+					*dst = std::move(*src);
+				}
+				iterator new_start = _start + n;
+				_destroy(_start,new_start);
+				for(map_pointer node = _start.node;node < new_start.node;++node)
+					_deallocate_node(*node);
+				_start = new_start;
+			}
+			else
+			{
+				// 后面的元素前移 n 位，再析构尾部多出来的 n 个并归还空出的块
+				iterator dst = first;
+				for(iterator src = last;src != _finish;++src,++dst)
+					*dst = std::move(*src);
+				iterator new_finish = _finish - n;
+				_destroy(new_finish,_finish);
+				for(map_pointer node = new_finish.node + 1;node <= _finish.node;++node)
+					_deallocate_node(*node);
+				_finish = new_finish;
+			}
+			return _start + before;
+		}
+
+		// -------------------------- 分配器相关 --------------------------
+		allocator_type get_allocator() const {return allocator_type();}
+	};
+
+	template <typename T,typename Alloc>
+	inline void swap(deque<T,Alloc>& lhs,deque<T,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -0,0 +1,638 @@
+#ifndef LZ_STL_FLAT_HASH_MAP_H
+#define LZ_STL_FLAT_HASH_MAP_H
+
+#include "type_traits.h"
+#include "alloc.h"
+#include "iterator.h"
+#include "construct.h"
+#include "uninitialized.h"
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+flat_hash_map / flat_hash_set：开放寻址哈希表（Swiss table 的做法）
+为什么需要？
+std::unordered_map 每个元素一个节点，桶里挂链表：查找一次至少两次不连续的访存（桶 -> 节点）
+元素多了以后几乎每次查找都是缓存未命中
+
+做法：
+1.元素直接存放在连续的槽数组 _slots 里，没有节点
+2.另有一个控制字节数组 _ctrl，每个槽一个字节：
+	0~127   该槽有元素，值是哈希值的低 7 位（H2）
+	-128    空（kEmpty）
+	-2      已删除（kDeleted，墓碑）
+	-1      哨兵（kSentinel），放在 _ctrl[capacity]，迭代到这里结束
+3.查找：哈希值的其余位（H1）决定起点，每次取 16 个控制字节（一组），SSE2 一条比较得到 H2 相同的槽
+  只有 H2 相同的槽才去比较键（误判率 1/128）；组里出现空槽就说明键不存在
+  组之间按三角数跳跃（16, 32, 48 ...），容量是 2^k-1 时能走遍所有组
+4.capacity 为 2^k-1，_ctrl 末尾复制一份前 15 个字节，从任何位置起读 16 字节都不用回绕
+5.删除尽量不留墓碑：如果包含该槽的每个 16 字节窗口里都还有空槽，说明从没有查找越过这里，直接置空
+  否则置为 kDeleted。墓碑占着 growth_left，太多时原容量重新哈希一次清掉
+6.负载因子上限 7/8；扩容/rehash 时用 uninitialized_move 把元素搬进新槽，POD 走按字节复制
+7.哈希值先乘一个奇数常数再折叠，std::hash<int> 这种恒等哈希也能把低位打散
+
+flat_hash_map 的槽实际存放 std::pair<K,V>，对外以 std::pair<const K,V> 的引用给出
+（两者布局相同），这样 rehash 时键也能被移动，而不是复制
+插入（以及 rehash）使所有迭代器和元素的引用失效；默认的 alloc 不是线程安全的
+*/
+
+namespace lzstl
+{
+	enum {__HASH_GROUP_WIDTH = 16};		// 一组控制字节的个数
+
+	enum __hash_ctrl
+	{
+		__HASH_EMPTY = -128,
+		__HASH_DELETED = -2,
+		__HASH_SENTINEL = -1
+	};
+
+	// 空表共用的一组控制字节：哨兵 + 15 个空，查找读到它立即结束
+	inline signed char* __hash_empty_group()
+	{
+		alignas(16) static const signed char group[__HASH_GROUP_WIDTH] = {
+			__HASH_SENTINEL,__HASH_EMPTY,__HASH_EMPTY,__HASH_EMPTY,__HASH_EMPTY,__HASH_EMPTY,__HASH_EMPTY,__HASH_EMPTY,
+			__HASH_EMPTY,__HASH_EMPTY,__HASH_EMPTY,__HASH_EMPTY,__HASH_EMPTY,__HASH_EMPTY,__HASH_EMPTY,__HASH_EMPTY};
+		return const_cast<signed char*>(group);
+	}
+
+	// 从 ctrl 开始的 16 个控制字节，各种查询返回 16 位掩码（第 i 位对应 ctrl[i]）
+	struct __hash_group
+	{
+#if defined(__SSE2__)
+		__m128i ctrl;
+
+		explicit __hash_group(const signed char* p):ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))){}
+
+		unsigned match(signed char h2) const
+		{
+			return unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl,_mm_set1_epi8(h2))));
+		}
+		unsigned mask_empty() const
+		{
+			return unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl,_mm_set1_epi8(char(__HASH_EMPTY)))));
+		}
+		// 空或墓碑：小于哨兵的值
+		unsigned mask_empty_or_deleted() const
+		{
+			return unsigned(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(char(__HASH_SENTINEL)),ctrl)));
+		}
+#else
+		const signed char* ctrl;
+
+		explicit __hash_group(const signed char* p):ctrl(p){}
+
+		unsigned match(signed char h2) const
+		{
+			unsigned mask = 0;
+			for(int i = 0;i<__HASH_GROUP_WIDTH;++i)
+				mask |= unsigned(ctrl[i] == h2) << i;
+			return mask;
+		}
+		unsigned mask_empty() const {return match(static_cast<signed char>(__HASH_EMPTY));}
+		unsigned mask_empty_or_deleted() const
+		{
+			unsigned mask = 0;
+			for(int i = 0;i<__HASH_GROUP_WIDTH;++i)
+				mask |= unsigned(ctrl[i] < __HASH_SENTINEL) << i;
+			return mask;
+		}
+#endif
+	};
+
+	// 打散哈希值：乘以 2^64/φ 后把高位折叠到低位
+	inline size_t __hash_mix(size_t h)
+	{
+		unsigned long long m = (unsigned long long)h * 0x9E3779B97F4A7C15ull;
+		return size_t(m ^ (m >> 32));
+	}
+
+	// 能容纳 n 个元素（负载因子 7/8）的最小容量 2^k-1，至少 15
+	inline size_t __hash_capacity_for(size_t n)
+	{
+		size_t cap = __HASH_GROUP_WIDTH - 1;
+		while(cap - cap / 8 < n)
+			cap = cap * 2 + 1;
+		return cap;
+	}
+
+	template <typename K>
+	struct __flat_set_policy
+	{
+		typedef K key_type;
+		typedef K slot_type;
+		typedef K value_type;
+		enum {constant_iterator = 1};		// 集合的元素就是键，不能通过迭代器修改
+
+		static const key_type& key(const slot_type& s) {return s;}
+		static value_type& element(slot_type& s) {return s;}
+	};
+
+	template <typename K,typename V>
+	struct __flat_map_policy
+	{
+		typedef K key_type;
+		typedef std::pair<K,V> slot_type;
+		typedef std::pair<const K,V> value_type;
+		enum {constant_iterator = 0};
+
+		static const key_type& key(const slot_type& s) {return s.first;}
+		static value_type& element(slot_type& s) {return reinterpret_cast<value_type&>(s);}
+	};
+
+	template <typename Policy,bool IsConst>
+	struct __hash_iterator
+	{
+		typedef typename Policy::slot_type	slot_type;
+		typedef forward_iterator_tag		iterator_category;
+		typedef typename Policy::value_type	value_type;
+		typedef ptrdiff_t					difference_type;
+		typedef typename std::conditional<IsConst || Policy::constant_iterator,const value_type*,value_type*>::type pointer;
+		typedef typename std::conditional<IsConst || Policy::constant_iterator,const value_type&,value_type&>::type reference;
+
+		signed char* ctrl;
+		slot_type* slot;
+
+		__hash_iterator():ctrl(nullptr),slot(nullptr){}
+		__hash_iterator(signed char* c,slot_type* s):ctrl(c),slot(s){}
+		// iterator 可隐式转换为 const_iterator；用模板是为了不顶替拷贝构造函数，拷贝仍由编译器生成
+		template <bool C,typename = typename std::enable_if<IsConst && !C>::type>
+		__hash_iterator(const __hash_iterator<Policy,C>& rhs):ctrl(rhs.ctrl),slot(rhs.slot){}
+
+		// 跳过空槽和墓碑，停在下一个元素或末尾的哨兵上
+		void skip_empty_or_deleted()
+		{
+			while(*ctrl < __HASH_SENTINEL)
+			{
+				++ctrl;
+				++slot;
+			}
+		}
+
+		reference operator*() const {return Policy::element(*slot);}
+		pointer operator->() const {return &Policy::element(*slot);}
+
+		__hash_iterator& operator++()
+		{
+			++ctrl;
+			++slot;
+			skip_empty_or_deleted();
+			return *this;
+		}
+		__hash_iterator operator++(int) {__hash_iterator tmp = *this;++*this;return tmp;}
+
+		bool operator==(const __hash_iterator& x) const {return ctrl == x.ctrl;}
+		bool operator!=(const __hash_iterator& x) const {return ctrl != x.ctrl;}
+	};
+
+	// flat_hash_map / flat_hash_set 共用的表，Policy 决定槽里存什么、键从哪里取
+	template <typename Policy,typename Hash,typename KeyEqual,typename Alloc>
+	class __raw_hash_table
+	{
+	public:
+		typedef typename Policy::key_type	key_type;
+		typedef typename Policy::value_type	value_type;
+		typedef Hash						hasher;
+		typedef KeyEqual					key_equal;
+		typedef size_t						size_type;
+		typedef ptrdiff_t					difference_type;
+		typedef Alloc						allocator_type;
+		typedef __hash_iterator<Policy,false>	iterator;
+		typedef __hash_iterator<Policy,true>	const_iterator;
+	protected:
+		typedef typename Policy::slot_type	slot_type;
+
+		signed char*	_ctrl;			// capacity + 16 个控制字节：[capacity] 是哨兵，其后 15 个是开头的副本
+		slot_type*		_slots;
+		size_type		_size;
+		size_type		_capacity;		// 0 或 2^k-1
+		size_type		_growth_left;	// 还能占用多少个空槽（墓碑不算空槽）
+		hasher			_hash;
+		key_equal		_eq;
+
+		static signed char _h2(size_t hash) {return static_cast<signed char>(hash & 0x7F);}
+		static size_t _h1(size_t hash) {return hash >> 7;}
+
+		size_t _hash_of(const key_type& key) const {return __hash_mix(_hash(key));}
+
+		// 写第 i 个控制字节，同时维护末尾的副本
+		void _set_ctrl(size_type i,signed char h)
+		{
+			_ctrl[i] = h;
+			_ctrl[((i - (__HASH_GROUP_WIDTH - 1)) & _capacity) + (__HASH_GROUP_WIDTH - 1)] = h;
+		}
+
+		static size_type _ctrl_bytes(size_type cap) {return cap + __HASH_GROUP_WIDTH;}
+
+		// 找到 key 所在的槽，不存在时返回 _capacity
+		size_type _find_index(const key_type& key,size_t hash) const
+		{
+			size_type pos = _h1(hash) & _capacity;
+			size_type step = 0;
+			for(;;)
+			{
+				__hash_group g(_ctrl + pos);
+				for(unsigned m = g.match(_h2(hash));m;m &= m - 1)
+				{
+					size_type i = (pos + __builtin_ctz(m)) & _capacity;
+					if(_eq(Policy::key(_slots[i]),key))
+						return i;
+				}
+				if(g.mask_empty())
+					return _capacity;
+				step += __HASH_GROUP_WIDTH;
+				pos = (pos + step) & _capacity;
+			}
+		}
+
+		// 沿 hash 的探测序列找第一个空槽或墓碑
+		size_type _find_first_non_full(size_t hash) const
+		{
+			size_type pos = _h1(hash) & _capacity;
+			size_type step = 0;
+			for(;;)
+			{
+				unsigned m = __hash_group(_ctrl + pos).mask_empty_or_deleted();
+				if(m)
+					return (pos + __builtin_ctz(m)) & _capacity;
+				step += __HASH_GROUP_WIDTH;
+				pos = (pos + step) & _capacity;
+			}
+		}
+
+		void _deallocate(signed char* ctrl,slot_type* slots,size_type cap)
+		{
+			if(cap == 0)
+				return;
+			Alloc::deallocate(ctrl,_ctrl_bytes(cap));
+			Alloc::deallocate(slots,cap * sizeof(slot_type));
+		}
+
+		void _destroy_slots()
+		{
+			for(size_type i = 0;i<_capacity;++i)
+				if(_ctrl[i] >= 0)
+					lzstl::destroy(_slots + i);
+		}
+
+		// 换成容量为 new_cap 的新表，元素按新容量重新定位后 uninitialized_move 过去
+		void _resize(size_type new_cap)
+		{
+			signed char* old_ctrl = _ctrl;
+			slot_type* old_slots = _slots;
+			size_type old_cap = _capacity;
+
+			signed char* ctrl = static_cast<signed char*>(Alloc::allocate(_ctrl_bytes(new_cap)));
+			slot_type* slots;
+			try
+			{
+				slots = static_cast<slot_type*>(Alloc::allocate(new_cap * sizeof(slot_type)));
+			}
+			catch(...)
+			{
+				Alloc::deallocate(ctrl,_ctrl_bytes(new_cap));
+				throw;
+			}
+			std::memset(ctrl,__HASH_EMPTY,_ctrl_bytes(new_cap));
+			ctrl[new_cap] = __HASH_SENTINEL;
+			_ctrl = ctrl;
+			_slots = slots;
+			_capacity = new_cap;
+			_growth_left = new_cap - new_cap / 8 - _size;
+
+			for(size_type i = 0;i<old_cap;++i)
+			{
+				if(old_ctrl[i] < 0)
+					continue;
+				size_t hash = _hash_of(Policy::key(old_slots[i]));
+				size_type j = _find_first_non_full(hash);
+				lzstl::uninitialized_move(old_slots + i,old_slots + i + 1,_slots + j);
+				lzstl::destroy(old_slots + i);
+				_set_ctrl(j,_h2(hash));
+			}
+			_deallocate(old_ctrl,old_slots,old_cap);
+		}
+
+		// 没有可用的空槽了：墓碑多（元素不到容量的 25/32）就原容量重建，否则翻倍
+		void _rehash_and_grow()
+		{
+			if(_capacity > __HASH_GROUP_WIDTH - 1 && _size * 32 <= _capacity * 25)
+				_resize(_capacity);
+			else
+				_resize(_capacity == 0 ? __HASH_GROUP_WIDTH - 1 : _capacity * 2 + 1);
+		}
+
+		// 为 hash 准备一个槽并在其中构造元素，返回槽的下标；构造失败时表不变
+		template <typename... Args>
+		size_type _insert_new(size_t hash,Args&&... args)
+		{
+			size_type i = _find_first_non_full(hash);
+			if(_growth_left == 0 && _ctrl[i] != __HASH_DELETED)
+			{
+				_rehash_and_grow();
+				i = _find_first_non_full(hash);
+			}
+			::new (static_cast<void*>(_slots + i)) slot_type(std::forward<Args>(args)...);
+			_growth_left -= (_ctrl[i] == __HASH_EMPTY);
+			_set_ctrl(i,_h2(hash));
+			++_size;
+			return i;
+		}
+
+		// 删除第 i 个槽：包含它的每个 16 字节窗口里都有空槽时，从没有探测越过它，可以直接置空
+		void _erase_at(size_type i)
+		{
+			lzstl::destroy(_slots + i);
+			--_size;
+			size_type before = (i - __HASH_GROUP_WIDTH) & _capacity;
+			unsigned empty_after = __hash_group(_ctrl + i).mask_empty();
+			unsigned empty_before = __hash_group(_ctrl + before).mask_empty();
+			bool was_never_full = empty_before && empty_after &&
+				size_type(__builtin_ctz(empty_after) + (__builtin_clz(empty_before) - 16)) < __HASH_GROUP_WIDTH;
+			_set_ctrl(i,was_never_full ? static_cast<signed char>(__HASH_EMPTY) : static_cast<signed char>(__HASH_DELETED));
+			_growth_left += was_never_full;
+		}
+
+		iterator _iterator_at(size_type i) {return iterator(_ctrl + i,_slots + i);}
+		const_iterator _iterator_at(size_type i) const {return const_iterator(_ctrl + i,_slots + i);}
+
+		void _reset()
+		{
+			_ctrl = __hash_empty_group();
+			_slots = nullptr;
+			_size = 0;
+			_capacity = 0;
+			_growth_left = 0;
+		}
+
+		// 插入：键已存在时返回已有元素和 false
+		template <typename... Args>
+		std::pair<iterator,bool> _emplace_key(const key_type& key,Args&&... args)
+		{
+			size_t hash = _hash_of(key);
+			size_type i = _find_index(key,hash);
+			if(i != _capacity)
+				return std::pair<iterator,bool>(_iterator_at(i),false);
+			return std::pair<iterator,bool>(_iterator_at(_insert_new(hash,std::forward<Args>(args)...)),true);
+		}
+
+	public:
+		// -------------------------- 构造函数/析构函数/赋值运算符 --------------------------
+		__raw_hash_table():_hash(),_eq()
+		{
+			_reset();
+		}
+
+		explicit __raw_hash_table(size_type n,const hasher& hash = hasher(),const key_equal& eq = key_equal()):_hash(hash),_eq(eq)
+		{
+			_reset();
+			reserve(n);
+		}
+
+		template <typename InputIterator>
+		__raw_hash_table(InputIterator first,InputIterator last):_hash(),_eq()
+		{
+			_reset();
+			try
+			{
+				insert(first,last);
+			}
+			catch(...)
+			{
+				_destroy_slots();
+				_deallocate(_ctrl,_slots,_capacity);
+				throw;
+			}
+		}
+
+		__raw_hash_table(const __raw_hash_table& rhs):_hash(rhs._hash),_eq(rhs._eq)
+		{
+			_reset();
+			try
+			{
+				reserve(rhs._size);
+				for(const_iterator it = rhs.begin();it != rhs.end();++it)
+					_insert_new(_hash_of(Policy::key(*it.slot)),*it.slot);
+			}
+			catch(...)
+			{
+				_destroy_slots();
+				_deallocate(_ctrl,_slots,_capacity);
+				throw;
+			}
+		}
+
+		__raw_hash_table(__raw_hash_table&& rhs) noexcept :_hash(rhs._hash),_eq(rhs._eq)
+		{
+			_reset();
+			swap(rhs);
+		}
+
+		~__raw_hash_table()
+		{
+			_destroy_slots();
+			_deallocate(_ctrl,_slots,_capacity);
+		}
+
+		__raw_hash_table& operator=(const __raw_hash_table& rhs)
+		{
+			if(this != &rhs)
+			{
+				__raw_hash_table tmp(rhs);
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		__raw_hash_table& operator=(__raw_hash_table&& rhs) noexcept
+		{
+			if(this != &rhs)
+				swap(rhs);
+			return *this;
+		}
+
+		// -------------------------- 迭代器接口 --------------------------
+		iterator begin()
+		{
+			iterator it(_ctrl,_slots);
+			it.skip_empty_or_deleted();
+			return it;
+		}
+		const_iterator begin() const
+		{
+			const_iterator it(_ctrl,_slots);
+			it.skip_empty_or_deleted();
+			return it;
+		}
+		iterator end() {return _iterator_at(_capacity);}
+		const_iterator end() const {return _iterator_at(_capacity);}
+
+		// -------------------------- 容量与大小操作 --------------------------
+		size_type size() const {return _size;}
+		bool empty() const {return _size == 0;}
+		size_type capacity() const {return _capacity;}
+		float load_factor() const {return _capacity ? float(_size) / float(_capacity) : 0.0f;}
+		float max_load_factor() const {return 7.0f / 8.0f;}
+
+		// 保证再插入到 n 个元素之前不会 rehash
+		void reserve(size_type n)
+		{
+			if(n > _size + _growth_left)
+				_resize(__hash_capacity_for(n));
+		}
+
+		// 按 max(n, size()) 重建表，同时清掉所有墓碑；rehash(0) 收缩到刚好够用
+		void rehash(size_type n)
+		{
+			if(n == 0 && _size == 0)
+			{
+				_deallocate(_ctrl,_slots,_capacity);
+				_reset();
+				return;
+			}
+			_resize(__hash_capacity_for(n > _size ? n : _size));
+		}
+
+		void swap(__raw_hash_table& rhs) noexcept
+		{
+			std::swap(_ctrl,rhs._ctrl);
+			std::swap(_slots,rhs._slots);
+			std::swap(_size,rhs._size);
+			std::swap(_capacity,rhs._capacity);
+			std::swap(_growth_left,rhs._growth_left);
+			std::swap(_hash,rhs._hash);
+			std::swap(_eq,rhs._eq);
+		}
+
+		// -------------------------- 查找 --------------------------
+		iterator find(const key_type& key) {return _iterator_at(_find_index(key,_hash_of(key)));}
+		const_iterator find(const key_type& key) const {return _iterator_at(_find_index(key,_hash_of(key)));}
+		size_type count(const key_type& key) const {return _find_index(key,_hash_of(key)) != _capacity;}
+
+		// -------------------------- 插入/删除 --------------------------
+		std::pair<iterator,bool> insert(const value_type& value)
+		{
+			return _emplace_key(Policy::key(reinterpret_cast<const slot_type&>(value)),value);
+		}
+
+		std::pair<iterator,bool> insert(value_type&& value)
+		{
+			return _emplace_key(Policy::key(reinterpret_cast<const slot_type&>(value)),std::move(value));
+		}
+
+		template <typename InputIterator>
+		void insert(InputIterator first,InputIterator last)
+		{
+			for(;first != last;++first)
+				insert(*first);
+		}
+
+		// 先构造出元素才能知道键：构造一个临时对象，键不存在时再移动进槽
+		template <typename... Args>
+		std::pair<iterator,bool> emplace(Args&&... args)
+		{
+			slot_type tmp(std::forward<Args>(args)...);
+			return _emplace_key(Policy::key(tmp),std::move(tmp));
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			size_type i = pos.ctrl - _ctrl;
+			_erase_at(i);
+			iterator next = _iterator_at(i);
+			next.skip_empty_or_deleted();
+			return next;
+		}
+
+		iterator erase(iterator pos) {return erase(const_iterator(pos));}
+
+		size_type erase(const key_type& key)
+		{
+			size_type i = _find_index(key,_hash_of(key));
+			if(i == _capacity)
+				return 0;
+			_erase_at(i);
+			return 1;
+		}
+
+		// 保留容量，控制字节全部置空（墓碑也一并清掉）
+		void clear()
+		{
+			if(_capacity == 0)
+				return;
+			_destroy_slots();
+			std::memset(_ctrl,__HASH_EMPTY,_ctrl_bytes(_capacity));
+			_ctrl[_capacity] = __HASH_SENTINEL;
+			_size = 0;
+			_growth_left = _capacity - _capacity / 8;
+		}
+
+		// -------------------------- 其他 --------------------------
+		hasher hash_function() const {return _hash;}
+		key_equal key_eq() const {return _eq;}
+		allocator_type get_allocator() const {return allocator_type();}
+	};
+
+	template <typename K,typename Hash = std::hash<K>,typename KeyEqual = std::equal_to<K>,typename Alloc = alloc>
+	class flat_hash_set :public __raw_hash_table<__flat_set_policy<K>,Hash,KeyEqual,Alloc>
+	{
+		typedef __raw_hash_table<__flat_set_policy<K>,Hash,KeyEqual,Alloc> base;
+	public:
+		using base::base;
+		flat_hash_set() {}
+	};
+
+	template <typename K,typename V,typename Hash = std::hash<K>,typename KeyEqual = std::equal_to<K>,typename Alloc = alloc>
+	class flat_hash_map :public __raw_hash_table<__flat_map_policy<K,V>,Hash,KeyEqual,Alloc>
+	{
+		typedef __raw_hash_table<__flat_map_policy<K,V>,Hash,KeyEqual,Alloc> base;
+	public:
+		typedef V mapped_type;
+		typedef typename base::key_type key_type;
+		typedef typename base::iterator iterator;
+
+		using base::base;
+		flat_hash_map() {}
+
+		// 键不存在时才用 args 构造值；键存在时 args 不被移动
+		template <typename... Args>
+		std::pair<iterator,bool> try_emplace(const key_type& key,Args&&... args)
+		{
+			return this->_emplace_key(key,std::piecewise_construct,std::forward_as_tuple(key),
+									  std::forward_as_tuple(std::forward<Args>(args)...));
+		}
+
+		template <typename... Args>
+		std::pair<iterator,bool> try_emplace(key_type&& key,Args&&... args)
+		{
+			return this->_emplace_key(key,std::piecewise_construct,std::forward_as_tuple(std::move(key)),
+									  std::forward_as_tuple(std::forward<Args>(args)...));
+		}
+
+		// 键不存在时插入值初始化的 V
+		mapped_type& operator[](const key_type& key) {return try_emplace(key).first->second;}
+		mapped_type& operator[](key_type&& key) {return try_emplace(std::move(key)).first->second;}
+	};
+
+	template <typename K,typename Hash,typename KeyEqual,typename Alloc>
+	inline void swap(flat_hash_set<K,Hash,KeyEqual,Alloc>& lhs,flat_hash_set<K,Hash,KeyEqual,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+	template <typename K,typename V,typename Hash,typename KeyEqual,typename Alloc>
+	inline void swap(flat_hash_map<K,V,Hash,KeyEqual,Alloc>& lhs,flat_hash_map<K,V,Hash,KeyEqual,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -0,0 +1,616 @@
+#ifndef LZ_STL_FLAT_MAP_H
+#define LZ_STL_FLAT_MAP_H
+
+#include "type_traits.h"
+#include "alloc.h"
+#include "iterator.h"
+#include "vector.h"
+#include "sort.h"
+#include "algorithm.h"
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+/*
+flat_map / flat_set：有序关联容器，元素按键排好序放在 lzstl::vector 里
+为什么需要？
+以查询为主的有序字典用 std::map，每个元素一个红黑树节点（三个指针 + 颜色，再加 malloc 的开销）
+int -> int 的 map 每个元素要 40~48 字节，查找时每一层都是一次不连续的访存
+
+做法：
+1.flat_set 只有一个有序的键数组；flat_map 的键和值分别放在两个数组里（_keys / _values）
+  二分查找只碰键数组，键挨在一起，一条 cache line 装得下更多的键
+2.二分查找用无分支的写法：每一步只是条件传送（cmov），没有难以预测的跳转
+  数组很大时顺便预取下一步可能访问的两个位置
+3.键是算术类型、比较器是 std::less 时：二分只缩小到 128 字节的窗口
+  窗口里用 SIMD 数一数有多少个元素小于 key，这个个数就是 lower_bound 的偏移
+4.批量插入 insert(first, last)：新元素先追加到末尾，只对追加部分排序（稳定，相等的键保留第一个）、去重，
+  再与原有部分归并一次，O(n + k log k)；逐个插入则是每次都要挪动后面的元素，O(n*k)
+5.单个插入/删除要挪动后面的元素，O(n)；适合读多写少，写得多请用 flat_hash_map 或树
+
+迭代器：flat_set 是指向键的 const 指针；flat_map 是代理迭代器，解引用得到 std::pair<const K&, V&>
+插入/删除使迭代器失效
+*/
+
+namespace lzstl
+{
+	// -------------------------- 查找 --------------------------
+	// 无分支 lower_bound：答案始终在 [base, base+n] 中，每步用 base[half-1] 把区间减半
+	template <typename T,typename Compare>
+	inline const T* __branchless_lower_bound(const T* base,size_t n,const T& key,const Compare& comp)
+	{
+		if(n == 0)
+			return base;
+		while(n > 1)
+		{
+			size_t half = n / 2;
+			__builtin_prefetch(base + half / 2);
+			__builtin_prefetch(base + half + half / 2);
+			base = comp(base[half - 1],key) ? base + half : base;
+			n -= half;
+		}
+		return base + comp(*base,key);
+	}
+
+	// 无分支 upper_bound：找第一个 comp(key, x) 为真的位置
+	template <typename T,typename Compare>
+	inline const T* __branchless_upper_bound(const T* base,size_t n,const T& key,const Compare& comp)
+	{
+		if(n == 0)
+			return base;
+		while(n > 1)
+		{
+			size_t half = n / 2;
+			__builtin_prefetch(base + half / 2);
+			__builtin_prefetch(base + half + half / 2);
+			base = comp(key,base[half - 1]) ? base : base + half;
+			n -= half;
+		}
+		return base + !comp(key,*base);
+	}
+
+	// [p, p+n) 中小于 key 的元素个数：16 字节一组比较，比较结果每条为 -1，累加后取反
+	template <typename T>
+	inline size_t __simd_count_less(const T* p,size_t n,T key)
+	{
+		typedef T __vec __attribute__((vector_size(16)));
+		typedef decltype(__vec() < __vec()) __mask;
+		enum {LANES = 16 / sizeof(T)};
+
+		__vec k;
+		for(int j = 0;j<LANES;++j)
+			k[j] = key;
+		__mask acc = __mask();
+		size_t i = 0;
+		for(;i + LANES <= n;i += LANES)
+		{
+			__vec v;
+			std::memcpy(&v,p + i,sizeof(v));
+			acc += (v < k);
+		}
+		size_t count = 0;
+		for(int j = 0;j<LANES;++j)
+			count -= size_t(acc[j]);
+		for(;i<n;++i)
+			count += p[i] < key;
+		return count;
+	}
+
+	// 算术类型 + std::less：无分支二分缩小到 128 字节的窗口，窗口内用 SIMD 计数
+	// 窗口最多 128 个元素，8 位的累加器也不会溢出
+	template <typename T>
+	inline const T* __simd_lower_bound(const T* base,size_t n,T key)
+	{
+		enum {WINDOW = 128 / sizeof(T)};
+		while(n > WINDOW)
+		{
+			size_t half = n / 2;
+			__builtin_prefetch(base + half / 2);
+			__builtin_prefetch(base + half + half / 2);
+			base = base[half - 1] < key ? base + half : base;
+			n -= half;
+		}
+		return base + __simd_count_less(base,n,key);
+	}
+
+	template <typename T,typename Compare>
+	struct __flat_simd_ok : public false_type {};
+
+	template <typename T>
+	struct __flat_simd_ok<T,std::less<T>> : public __is_simd_arithmetic<T> {};
+
+	template <typename T,typename Compare>
+	inline const T* __flat_lower_bound(const T* base,size_t n,const T& key,const Compare& comp,false_type)
+	{
+		return __branchless_lower_bound(base,n,key,comp);
+	}
+
+	template <typename T,typename Compare>
+	inline const T* __flat_lower_bound(const T* base,size_t n,const T& key,const Compare&,true_type)
+	{
+		return __simd_lower_bound(base,n,key);
+	}
+
+	template <typename T,typename Compare>
+	inline const T* __flat_lower_bound(const T* base,size_t n,const T& key,const Compare& comp)
+	{
+		return __flat_lower_bound(base,n,key,comp,__flat_simd_ok<T,Compare>());
+	}
+
+	// 有序区间 [first, last) 中相等的元素只保留第一个，返回新的末尾
+	template <typename T,typename Compare>
+	T* __flat_unique(T* first,T* last,const Compare& comp)
+	{
+		if(first == last)
+			return last;
+		T* out = first;
+		for(T* it = first + 1;it != last;++it)
+			if(comp(*out,*it) && ++out != it)
+				*out = std::move(*it);
+		return out + 1;
+	}
+
+	// -------------------------- flat_set --------------------------
+	template <typename K,typename Compare = std::less<K>,typename Alloc = alloc>
+	class flat_set
+	{
+		static_assert(!std::is_same<K,bool>::value,"vector<bool> 按位压缩，取不到 const bool*，flat_set 的键不能是 bool");
+	public:
+		typedef K			key_type;
+		typedef K			value_type;
+		typedef Compare		key_compare;
+		typedef Compare		value_compare;
+		typedef const K*	iterator;
+		typedef const K*	const_iterator;
+		typedef const K&	reference;
+		typedef const K&	const_reference;
+		typedef size_t		size_type;
+		typedef ptrdiff_t	difference_type;
+		typedef Alloc		allocator_type;
+	private:
+		vector<K,Alloc>	_keys;
+		Compare			_comp;
+
+		const K* _data() const {return _keys.begin();}
+
+		size_type _lower_index(const K& key) const
+		{
+			return __flat_lower_bound(_data(),size(),key,_comp) - _data();
+		}
+
+		// 从 m 开始是刚追加的元素：排序、去重，再与 [0, m) 归并（已存在的键丢掉新来的）
+		void _merge_appended(size_type m)
+		{
+			K* d = _keys.data();
+			parallel_merge_sort<Alloc>(d + m,d + _keys.size(),_comp);
+			K* e = __flat_unique(d + m,d + _keys.size(),_comp);
+			_keys.erase(e,_keys.end());
+			d = _keys.data();
+			size_type n = _keys.size();
+			if(m == 0 || m == n || _comp(d[m - 1],d[m]))
+				return;
+
+			vector<K,Alloc> out;
+			out.reserve(n);
+			size_type i = 0,j = m;
+			while(i < m && j < n)
+			{
+				if(_comp(d[i],d[j]))
+					out.push_back(std::move(d[i++]));
+				else if(_comp(d[j],d[i]))
+					out.push_back(std::move(d[j++]));
+				else
+				{
+					out.push_back(std::move(d[i++]));
+					++j;
+				}
+			}
+			for(;i<m;++i)
+				out.push_back(std::move(d[i]));
+			for(;j<n;++j)
+				out.push_back(std::move(d[j]));
+			_keys.swap(out);
+		}
+
+	public:
+		// -------------------------- 构造函数 --------------------------
+		flat_set():_comp(){}
+		explicit flat_set(const Compare& comp):_comp(comp){}
+
+		template <typename InputIterator>
+		flat_set(InputIterator first,InputIterator last,const Compare& comp = Compare()):_comp(comp)
+		{
+			insert(first,last);
+		}
+
+		// -------------------------- 迭代器接口 --------------------------
+		const_iterator begin() const {return _data();}
+		const_iterator end() const {return _data() + size();}
+
+		// -------------------------- 容量与大小操作 --------------------------
+		size_type size() const {return _keys.size();}
+		bool empty() const {return _keys.size() == 0;}
+		size_type capacity() const {return _keys.capacity();}
+		void reserve(size_type n) {_keys.reserve(n);}
+		void shrink_to_fit() {_keys.shrink_to_fit();}
+		void clear() {_keys.clear();}
+
+		// 底层的有序数组
+		const vector<K,Alloc>& keys() const {return _keys;}
+
+		// -------------------------- 查找 --------------------------
+		const_iterator lower_bound(const K& key) const {return __flat_lower_bound(_data(),size(),key,_comp);}
+		const_iterator upper_bound(const K& key) const {return __branchless_upper_bound(_data(),size(),key,_comp);}
+		std::pair<const_iterator,const_iterator> equal_range(const K& key) const
+		{
+			return std::pair<const_iterator,const_iterator>(lower_bound(key),upper_bound(key));
+		}
+
+		const_iterator find(const K& key) const
+		{
+			const_iterator it = lower_bound(key);
+			return it != end() && !_comp(key,*it) ? it : end();
+		}
+
+		size_type count(const K& key) const {return find(key) != end();}
+
+		// -------------------------- 插入/删除 --------------------------
+		std::pair<iterator,bool> insert(const K& key)
+		{
+			return insert(K(key));
+		}
+
+		std::pair<iterator,bool> insert(K&& key)
+		{
+			size_type i = _lower_index(key);
+			if(i != size() && !_comp(key,_data()[i]))
+				return std::pair<iterator,bool>(_data() + i,false);
+			_keys.insert(_keys.begin() + i,std::move(key));
+			return std::pair<iterator,bool>(_data() + i,true);
+		}
+
+		template <typename... Args>
+		std::pair<iterator,bool> emplace(Args&&... args)
+		{
+			return insert(K(std::forward<Args>(args)...));
+		}
+
+		// 批量插入：追加、排序、去重、归并一次
+		template <typename InputIterator>
+		void insert(InputIterator first,InputIterator last)
+		{
+			size_type m = size();
+			try
+			{
+				for(;first != last;++first)
+					_keys.emplace_back(*first);
+			}
+			catch(...)
+			{
+				_keys.erase(_keys.begin() + m,_keys.end());
+				throw;
+			}
+			_merge_appended(m);
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			size_type i = pos - _data();
+			_keys.erase(_keys.begin() + i);
+			return _data() + i;
+		}
+
+		iterator erase(const_iterator first,const_iterator last)
+		{
+			size_type i = first - _data();
+			_keys.erase(_keys.begin() + i,_keys.begin() + (last - _data()));
+			return _data() + i;
+		}
+
+		size_type erase(const K& key)
+		{
+			const_iterator it = find(key);
+			if(it == end())
+				return 0;
+			erase(it);
+			return 1;
+		}
+
+		void swap(flat_set& rhs)
+		{
+			_keys.swap(rhs._keys);
+			std::swap(_comp,rhs._comp);
+		}
+
+		key_compare key_comp() const {return _comp;}
+		allocator_type get_allocator() const {return allocator_type();}
+	};
+
+	// -------------------------- flat_map --------------------------
+	// 代理迭代器：同一个下标上的键和值，解引用得到 std::pair<const K&, V&>
+	template <typename K,typename V,bool IsConst>
+	struct __flat_map_iterator
+	{
+		typedef typename std::conditional<IsConst,const V,V>::type mapped;
+
+		typedef random_access_iterator_tag		iterator_category;
+		typedef std::pair<K,V>					value_type;
+		typedef ptrdiff_t						difference_type;
+		typedef std::pair<const K&,mapped&>		reference;
+
+		// it->first / it->second：operator-> 返回一个装着 reference 的临时对象
+		struct pointer
+		{
+			reference ref;
+			const reference* operator->() const {return &ref;}
+		};
+
+		const K* key;
+		mapped* value;
+
+		__flat_map_iterator():key(nullptr),value(nullptr){}
+		__flat_map_iterator(const K* k,mapped* v):key(k),value(v){}
+		// iterator 可隐式转换为 const_iterator（模板形式，不会成为拷贝构造函数）
+		template <bool C,typename = typename std::enable_if<IsConst && !C>::type>
+		__flat_map_iterator(const __flat_map_iterator<K,V,C>& rhs):key(rhs.key),value(rhs.value){}
+
+		reference operator*() const {return reference(*key,*value);}
+		pointer operator->() const {pointer p = {reference(*key,*value)};return p;}
+		reference operator[](difference_type n) const {return reference(key[n],value[n]);}
+
+		__flat_map_iterator& operator++() {++key;++value;return *this;}
+		__flat_map_iterator operator++(int) {__flat_map_iterator tmp = *this;++*this;return tmp;}
+		__flat_map_iterator& operator--() {--key;--value;return *this;}
+		__flat_map_iterator operator--(int) {__flat_map_iterator tmp = *this;--*this;return tmp;}
+		__flat_map_iterator& operator+=(difference_type n) {key += n;value += n;return *this;}
+		__flat_map_iterator& operator-=(difference_type n) {key -= n;value -= n;return *this;}
+		__flat_map_iterator operator+(difference_type n) const {return __flat_map_iterator(key + n,value + n);}
+		__flat_map_iterator operator-(difference_type n) const {return __flat_map_iterator(key - n,value - n);}
+		difference_type operator-(const __flat_map_iterator& x) const {return key - x.key;}
+
+		bool operator==(const __flat_map_iterator& x) const {return key == x.key;}
+		bool operator!=(const __flat_map_iterator& x) const {return key != x.key;}
+		bool operator<(const __flat_map_iterator& x) const {return key < x.key;}
+		bool operator>(const __flat_map_iterator& x) const {return key > x.key;}
+		bool operator<=(const __flat_map_iterator& x) const {return key <= x.key;}
+		bool operator>=(const __flat_map_iterator& x) const {return key >= x.key;}
+	};
+
+	template <typename K,typename V,typename Compare = std::less<K>,typename Alloc = alloc>
+	class flat_map
+	{
+		static_assert(!std::is_same<V,bool>::value,"vector<bool> 按位压缩，取不到 bool&，flat_map 的值不能是 bool");
+	public:
+		typedef K									key_type;
+		typedef V									mapped_type;
+		typedef std::pair<K,V>						value_type;
+		typedef Compare								key_compare;
+		typedef __flat_map_iterator<K,V,false>		iterator;
+		typedef __flat_map_iterator<K,V,true>		const_iterator;
+		typedef size_t								size_type;
+		typedef ptrdiff_t							difference_type;
+		typedef Alloc								allocator_type;
+	private:
+		vector<K,Alloc>	_keys;
+		vector<V,Alloc>	_values;
+		Compare			_comp;
+
+		const K* _kdata() const {return _keys.begin();}
+
+		size_type _lower_index(const K& key) const
+		{
+			return __flat_lower_bound(_kdata(),size(),key,_comp) - _kdata();
+		}
+
+		size_type _find_index(const K& key) const
+		{
+			size_type i = _lower_index(key);
+			return i != size() && !_comp(key,_kdata()[i]) ? i : size();
+		}
+
+		iterator _iterator_at(size_type i) {return iterator(_kdata() + i,_values.data() + i);}
+		const_iterator _iterator_at(size_type i) const {return const_iterator(_kdata() + i,_values.begin() + i);}
+
+		struct __pair_key_less
+		{
+			const Compare* comp;
+			bool operator()(const value_type& a,const value_type& b) const {return (*comp)(a.first,b.first);}
+		};
+
+		// 在下标 i 处插入键和值；值构造失败时撤销键
+		template <typename KeyArg,typename... Args>
+		iterator _insert_at(size_type i,KeyArg&& key,Args&&... args)
+		{
+			_keys.insert(_keys.begin() + i,K(std::forward<KeyArg>(key)));
+			try
+			{
+				_values.insert(_values.begin() + i,V(std::forward<Args>(args)...));
+			}
+			catch(...)
+			{
+				_keys.erase(_keys.begin() + i);
+				throw;
+			}
+			return _iterator_at(i);
+		}
+
+	public:
+		// -------------------------- 构造函数 --------------------------
+		flat_map():_comp(){}
+		explicit flat_map(const Compare& comp):_comp(comp){}
+
+		template <typename InputIterator>
+		flat_map(InputIterator first,InputIterator last,const Compare& comp = Compare()):_comp(comp)
+		{
+			insert(first,last);
+		}
+
+		// -------------------------- 迭代器接口 --------------------------
+		iterator begin() {return _iterator_at(0);}
+		const_iterator begin() const {return _iterator_at(0);}
+		iterator end() {return _iterator_at(size());}
+		const_iterator end() const {return _iterator_at(size());}
+
+		// -------------------------- 容量与大小操作 --------------------------
+		size_type size() const {return _keys.size();}
+		bool empty() const {return _keys.size() == 0;}
+		size_type capacity() const {return _keys.capacity();}
+		void reserve(size_type n) {_keys.reserve(n);_values.reserve(n);}
+		void shrink_to_fit() {_keys.shrink_to_fit();_values.shrink_to_fit();}
+		void clear() {_keys.clear();_values.clear();}
+
+		// 底层的键数组 / 值数组，两者下标一一对应
+		const vector<K,Alloc>& keys() const {return _keys;}
+		const vector<V,Alloc>& values() const {return _values;}
+
+		// -------------------------- 查找 --------------------------
+		iterator lower_bound(const K& key) {return _iterator_at(_lower_index(key));}
+		const_iterator lower_bound(const K& key) const {return _iterator_at(_lower_index(key));}
+		iterator upper_bound(const K& key) {return _iterator_at(__branchless_upper_bound(_kdata(),size(),key,_comp) - _kdata());}
+		const_iterator upper_bound(const K& key) const {return _iterator_at(__branchless_upper_bound(_kdata(),size(),key,_comp) - _kdata());}
+		iterator find(const K& key) {return _iterator_at(_find_index(key));}
+		const_iterator find(const K& key) const {return _iterator_at(_find_index(key));}
+		size_type count(const K& key) const {return _find_index(key) != size();}
+
+		// 键不存在时插入值初始化的 V
+		V& operator[](const K& key)
+		{
+			return try_emplace(key).first->second;
+		}
+
+		// -------------------------- 插入/删除 --------------------------
+		// 键不存在时才用 args 构造值
+		template <typename... Args>
+		std::pair<iterator,bool> try_emplace(const K& key,Args&&... args)
+		{
+			size_type i = _lower_index(key);
+			if(i != size() && !_comp(key,_kdata()[i]))
+				return std::pair<iterator,bool>(_iterator_at(i),false);
+			return std::pair<iterator,bool>(_insert_at(i,key,std::forward<Args>(args)...),true);
+		}
+
+		template <typename... Args>
+		std::pair<iterator,bool> try_emplace(K&& key,Args&&... args)
+		{
+			size_type i = _lower_index(key);
+			if(i != size() && !_comp(key,_kdata()[i]))
+				return std::pair<iterator,bool>(_iterator_at(i),false);
+			return std::pair<iterator,bool>(_insert_at(i,std::move(key),std::forward<Args>(args)...),true);
+		}
+
+		std::pair<iterator,bool> insert(const value_type& value)
+		{
+			return try_emplace(value.first,value.second);
+		}
+
+		std::pair<iterator,bool> insert(value_type&& value)
+		{
+			return try_emplace(std::move(value.first),std::move(value.second));
+		}
+
+		// 批量插入：先收集成 (键, 值) 对，按键稳定排序、去重，再与原有元素归并一次
+		template <typename InputIterator>
+		void insert(InputIterator first,InputIterator last)
+		{
+			vector<value_type,Alloc> in;
+			for(;first != last;++first)
+				in.emplace_back(*first);
+			if(in.empty())
+				return;
+			__pair_key_less less = {&_comp};
+			value_type* p = in.data();
+			parallel_merge_sort<Alloc>(p,p + in.size(),less);
+			value_type* e = __flat_unique(p,p + in.size(),less);
+			size_type k = e - p;
+
+			size_type m = size();
+			vector<K,Alloc> keys;
+			vector<V,Alloc> values;
+			keys.reserve(m + k);
+			values.reserve(m + k);
+			K* ok = _keys.data();
+			V* ov = _values.data();
+			size_type i = 0,j = 0;
+			while(i < m && j < k)
+			{
+				if(_comp(p[j].first,ok[i]))
+				{
+					keys.push_back(std::move(p[j].first));
+					values.push_back(std::move(p[j].second));
+					++j;
+				}
+				else
+				{
+					if(!_comp(ok[i],p[j].first))
+						++j;		// 键已存在，丢掉新来的
+					keys.push_back(std::move(ok[i]));
+					values.push_back(std::move(ov[i]));
+					++i;
+				}
+			}
+			for(;i<m;++i)
+			{
+				keys.push_back(std::move(ok[i]));
+				values.push_back(std::move(ov[i]));
+			}
+			for(;j<k;++j)
+			{
+				keys.push_back(std::move(p[j].first));
+				values.push_back(std::move(p[j].second));
+			}
+			_keys.swap(keys);
+			_values.swap(values);
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			size_type i = pos.key - _kdata();
+			_keys.erase(_keys.begin() + i);
+			_values.erase(_values.begin() + i);
+			return _iterator_at(i);
+		}
+
+		iterator erase(const_iterator first,const_iterator last)
+		{
+			size_type i = first.key - _kdata(),j = last.key - _kdata();
+			_keys.erase(_keys.begin() + i,_keys.begin() + j);
+			_values.erase(_values.begin() + i,_values.begin() + j);
+			return _iterator_at(i);
+		}
+
+		size_type erase(const K& key)
+		{
+			size_type i = _find_index(key);
+			if(i == size())
+				return 0;
+			erase(_iterator_at(i));
+			return 1;
+		}
+
+		void swap(flat_map& rhs)
+		{
+			_keys.swap(rhs._keys);
+			_values.swap(rhs._values);
+			std::swap(_comp,rhs._comp);
+		}
+
+		key_compare key_comp() const {return _comp;}
+		allocator_type get_allocator() const {return allocator_type();}
+	};
+
+	template <typename K,typename Compare,typename Alloc>
+	inline void swap(flat_set<K,Compare,Alloc>& lhs,flat_set<K,Compare,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+	template <typename K,typename V,typename Compare,typename Alloc>
+	inline void swap(flat_map<K,V,Compare,Alloc>& lhs,flat_map<K,V,Compare,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
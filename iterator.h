@@ -12,6 +12,7 @@ namespace lzstl
 	struct forward_iterator_tag :public input_iterator_tag{};   //++
 	struct bidirectional_iterator_tag :public forward_iterator_tag{}; //++ -- 
 	struct random_access_iterator_tag :public bidirectional_iterator_tag{}; //+=n -=n
+	struct contiguous_iterator_tag :public random_access_iterator_tag{}; // 元素在内存中连续存放，可以用 memcpy
 	
 	// 2. 迭代器基类（供自定义迭代器继承）
 	//type int a
@@ -41,25 +42,48 @@ namespace lzstl
 		typedef typename Iterator::reference         reference;
 	};
 	
-	// 特化：原生指针（T*）视为随机访问迭代器
+	// 特化：原生指针（T*）视为连续迭代器（也是随机访问迭代器）
 	template <typename T>
 	struct iterator_traits<T*>
 	{
-		typedef  random_access_iterator_tag		iterator_category;
+		typedef  contiguous_iterator_tag		iterator_category;
 		typedef  T								value_type;
 		typedef  ptrdiff_t   					difference_type;
 		typedef  T*         					pointer;
-		typedef  T&       						eference;
+		typedef  T&       						reference;
 	};
 	
 	template <typename T>
 	struct iterator_traits<const T*>
 	{
-		typedef  random_access_iterator_tag		iterator_category;
+		typedef  contiguous_iterator_tag		iterator_category;
 		typedef  T								value_type;
 		typedef  ptrdiff_t   					difference_type;
 		typedef  const T*         				pointer;
-		typedef  const T&       				eference;
+		typedef  const T&       				reference;
+	};
+	
+	// 3.1 是否为连续迭代器：决定 uninitialized_copy 等能否直接 memcpy
+	// 只看 lzstl 的分类标签；std::vector 等容器的迭代器按非连续处理（结果正确，只是走逐个复制）
+	// 自定义的连续迭代器可以特化本模板
+	template <typename Iterator>
+	struct is_contiguous_iterator : public false_type {};
+	
+	template <typename T>
+	struct is_contiguous_iterator<T*> : public true_type {};
+	
+	template <typename T>
+	struct is_contiguous_iterator<const T*> : public true_type {};
+	
+	// 3.2 是否为随机访问迭代器（标准库迭代器的 std 标签一律视为否）
+	template <typename Iterator>
+	struct __is_random_access_iterator
+	{
+	private:
+		static true_type __test(const random_access_iterator_tag*);
+		static false_type __test(...);
+	public:
+		typedef decltype(__test(static_cast<typename iterator_traits<Iterator>::iterator_category*>(nullptr))) type;
 	};
 	
 	// 4. 迭代器辅助函数（算法中常用）
@@ -0,0 +1,725 @@
+#ifndef LZ_STL_LIST_H
+#define LZ_STL_LIST_H
+
+#include "type_traits.h"
+#include "alloc.h"
+#include "iterator.h"
+#include "construct.h"
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+/*
+list：双向循环链表，任意位置插入/删除 O(1)，splice 整段搬移 O(1)
+为什么需要？
+拼接频繁的负载（把一段元素从一个序列挪到另一个序列）用数组要搬元素，链表只改几根指针
+
+做法：
+1.哨兵节点 _head 嵌在 list 对象里：_head.next 是第一个元素，_head.prev 是最后一个
+  空 list 不分配内存，移动/交换只改指针
+2.节点从 Alloc 成批取得：每个 list 有一个小的节点缓存 _cache
+  缓存空了就调用 Alloc::allocate_batch 一次取 __LIST_BATCH 个节点大小的块
+  （二级配置器从对应规格的自由链表整段摘下，或从内存池切一段连续的块）
+  删除的节点先放回缓存（至多 __LIST_MAX_CACHE 个），多出来的才还给 Alloc
+3.每个节点都能单独 Alloc::deallocate，所以节点可以 splice 到另一个 list，由那个 list 归还
+4.sort 是自底向上的归并排序：只改 next 指针归并，最后补上 prev，不分配任何内存，稳定
+  merge 同样只搬节点，O(n+m) 次比较，不分配
+5.迭代器是双向迭代器（bidirectional_iterator_tag），advance/distance 走逐步移动的版本
+
+size() 是 O(1)：从另一个 list 按区间 splice 时要数一遍区间长度，整个 list 或单个节点的 splice 仍是 O(1)
+和 vector 一样，默认的 alloc 不是线程安全的
+*/
+
+namespace lzstl
+{
+	enum {__LIST_BATCH = 16};		// 缓存空时一次取的节点数
+	enum {__LIST_MAX_CACHE = 64};	// 缓存的节点数上限
+
+	struct __list_node_base
+	{
+		__list_node_base* prev;
+		__list_node_base* next;
+	};
+
+	template <typename T>
+	struct __list_node :public __list_node_base
+	{
+		T data;
+	};
+
+	template <typename T,bool IsConst>
+	struct __list_iterator
+	{
+		typedef bidirectional_iterator_tag	iterator_category;
+		typedef T							value_type;
+		typedef ptrdiff_t					difference_type;
+		typedef typename std::conditional<IsConst,const T*,T*>::type pointer;
+		typedef typename std::conditional<IsConst,const T&,T&>::type reference;
+
+		__list_node_base* node;
+
+		__list_iterator():node(nullptr){}
+		explicit __list_iterator(__list_node_base* x):node(x){}
+		// iterator 可隐式转换为 const_iterator；模板构造函数不算拷贝构造，拷贝操作仍隐式生成
+		template <bool C,typename = typename std::enable_if<IsConst && !C>::type>
+		__list_iterator(const __list_iterator<T,C>& rhs):node(rhs.node){}
+
+		reference operator*() const {return static_cast<__list_node<T>*>(node)->data;}
+		pointer operator->() const {return &static_cast<__list_node<T>*>(node)->data;}
+
+		__list_iterator& operator++() {node = node->next;return *this;}
+		__list_iterator operator++(int) {__list_iterator tmp = *this;node = node->next;return tmp;}
+		__list_iterator& operator--() {node = node->prev;return *this;}
+		__list_iterator operator--(int) {__list_iterator tmp = *this;node = node->prev;return tmp;}
+
+		bool operator==(const __list_iterator& x) const {return node == x.node;}
+		bool operator!=(const __list_iterator& x) const {return node != x.node;}
+	};
+
+	template <typename T,typename Alloc = alloc>
+	class list
+	{
+	public:
+		typedef T 							value_type;
+		typedef __list_iterator<T,false>	iterator;
+		typedef __list_iterator<T,true>		const_iterator;
+		typedef T&							reference;
+		typedef const T&					const_reference;
+		typedef size_t						size_type;
+		typedef ptrdiff_t 					difference_type;
+		typedef Alloc 						allocator_type;
+	private:
+		typedef __list_node_base	node_base;
+		typedef __list_node<T>		node;
+
+		node_base	_head;		// 哨兵
+		size_type	_size;
+		void*		_cache;		// 节点缓存：每块开头存放下一块的地址
+		size_type	_ncache;
+
+		static T& _value(node_base* p) {return static_cast<node*>(p)->data;}
+
+		// -------------------------- 节点的分配 --------------------------
+		void* _get_node()
+		{
+			if(!_cache)
+			{
+				int nobjs = __LIST_BATCH;
+				_cache = Alloc::allocate_batch(sizeof(node),nobjs);
+				_ncache = nobjs;
+			}
+			void* p = _cache;
+			_cache = *static_cast<void**>(p);
+			--_ncache;
+			return p;
+		}
+
+		// 先放回缓存，缓存满了才还给 Alloc
+		void _put_node(void* p)
+		{
+			if(_ncache < __LIST_MAX_CACHE)
+			{
+				*static_cast<void**>(p) = _cache;
+				_cache = p;
+				++_ncache;
+			}
+			else
+				Alloc::deallocate(p,sizeof(node));
+		}
+
+		void _release_cache()
+		{
+			while(_cache)
+			{
+				void* next = *static_cast<void**>(_cache);
+				Alloc::deallocate(_cache,sizeof(node));
+				_cache = next;
+			}
+			_ncache = 0;
+		}
+
+		template <typename... Args>
+		node* _create_node(Args&&... args)
+		{
+			node* p = static_cast<node*>(_get_node());
+			try
+			{
+				::new (static_cast<void*>(&p->data)) value_type(std::forward<Args>(args)...);
+			}
+			catch(...)
+			{
+				_put_node(p);
+				throw;
+			}
+			return p;
+		}
+
+		void _destroy_node(node_base* p)
+		{
+			lzstl::destroy(&_value(p));
+			_put_node(p);
+		}
+
+		// -------------------------- 链接操作 --------------------------
+		void _empty_initialize()
+		{
+			_head.prev = _head.next = &_head;
+			_size = 0;
+		}
+
+		// 交换/移动后，首尾节点还指着原来的哨兵，改为指向本对象的 _head
+		void _relink_head()
+		{
+			if(_size == 0)
+				_head.prev = _head.next = &_head;
+			else
+			{
+				_head.next->prev = &_head;
+				_head.prev->next = &_head;
+			}
+		}
+
+		// 把 p 挂在 pos 之前
+		static void _hook(node_base* pos,node_base* p)
+		{
+			p->next = pos;
+			p->prev = pos->prev;
+			pos->prev->next = p;
+			pos->prev = p;
+		}
+
+		static void _unhook(node_base* p)
+		{
+			p->prev->next = p->next;
+			p->next->prev = p->prev;
+		}
+
+		// 把 [first, last) 整段搬到 pos 之前（可以来自另一个 list），只改 6 根指针
+		static void _transfer(node_base* pos,node_base* first,node_base* last)
+		{
+			if(pos == last)
+				return;
+			node_base* tail = last->prev;
+			first->prev->next = last;
+			last->prev = first->prev;
+			tail->next = pos;
+			first->prev = pos->prev;
+			pos->prev->next = first;
+			pos->prev = tail;
+		}
+
+		// 归并两条以 nullptr 结尾、只用 next 串起来的有序链，a 在前，相等时先取 a（稳定）
+		template <typename Compare>
+		static node_base* _merge_chain(node_base* a,node_base* b,Compare& comp)
+		{
+			node_base dummy;
+			node_base* tail = &dummy;
+			while(a && b)
+			{
+				if(comp(_value(b),_value(a)))
+				{
+					tail->next = b;
+					b = b->next;
+				}
+				else
+				{
+					tail->next = a;
+					a = a->next;
+				}
+				tail = tail->next;
+			}
+			tail->next = a ? a : b;
+			return dummy.next;
+		}
+
+		template <typename Integer>
+		void _insert_dispatch(iterator pos,Integer n,Integer value,true_type)
+		{
+			insert(pos,size_type(n),value_type(value));
+		}
+
+		// 中途抛异常时删掉已插入的节点
+		template <typename InputIterator>
+		void _insert_dispatch(iterator pos,InputIterator first,InputIterator last,false_type)
+		{
+			size_type n = 0;
+			try
+			{
+				for(;first != last;++first,++n)
+					emplace(pos,*first);
+			}
+			catch(...)
+			{
+				for(;n>0;--n)
+					erase(iterator(pos.node->prev));
+				throw;
+			}
+		}
+
+	public:
+		// -------------------------- 构造函数/析构函数/赋值运算符 --------------------------
+		list():_cache(nullptr),_ncache(0)
+		{
+			_empty_initialize();
+		}
+
+		// n 个值初始化的元素
+		explicit list(size_type n):_cache(nullptr),_ncache(0)
+		{
+			_empty_initialize();
+			try
+			{
+				for(;n>0;--n)
+					emplace_back();
+			}
+			catch(...)
+			{
+				clear();
+				_release_cache();
+				throw;
+			}
+		}
+
+		list(size_type n,const value_type& value):_cache(nullptr),_ncache(0)
+		{
+			_empty_initialize();
+			try
+			{
+				insert(end(),n,value);
+			}
+			catch(...)
+			{
+				_release_cache();
+				throw;
+			}
+		}
+
+		// list<int> l(10, 1) 用 is_integral 分派回 (n, value)
+		template <typename InputIterator>
+		list(InputIterator first,InputIterator last):_cache(nullptr),_ncache(0)
+		{
+			_empty_initialize();
+			try
+			{
+				insert(end(),first,last);
+			}
+			catch(...)
+			{
+				_release_cache();
+				throw;
+			}
+		}
+
+		list(const list& rhs):_cache(nullptr),_ncache(0)
+		{
+			_empty_initialize();
+			try
+			{
+				insert(end(),rhs.begin(),rhs.end());
+			}
+			catch(...)
+			{
+				_release_cache();
+				throw;
+			}
+		}
+
+		// 哨兵在对象内部，移动不分配内存
+		list(list&& rhs) noexcept :_cache(nullptr),_ncache(0)
+		{
+			_empty_initialize();
+			swap(rhs);
+		}
+
+		~list()
+		{
+			clear();
+			_release_cache();
+		}
+
+		// 已有的节点直接赋值复用，多的删掉，少的补上
+		list& operator=(const list& rhs)
+		{
+			if(this != &rhs)
+			{
+				iterator first1 = begin();
+				const_iterator first2 = rhs.begin();
+				for(;first1 != end() && first2 != rhs.end();++first1,++first2)
+					*first1 = *first2;
+				if(first2 == rhs.end())
+					erase(first1,end());
+				else
+					insert(end(),first2,rhs.end());
+			}
+			return *this;
+		}
+
+		list& operator=(list&& rhs) noexcept
+		{
+			if(this != &rhs)
+			{
+				clear();
+				swap(rhs);
+			}
+			return *this;
+		}
+
+		// -------------------------- 迭代器接口 --------------------------
+		iterator begin() {return iterator(_head.next);}
+		const_iterator begin() const {return const_iterator(const_cast<node_base*>(_head.next));}
+		iterator end() {return iterator(&_head);}
+		const_iterator end() const {return const_iterator(const_cast<node_base*>(&_head));}
+
+		// -------------------------- 容量与大小操作 --------------------------
+		size_type size() const {return _size;}
+		bool empty() const {return _size == 0;}
+
+		void resize(size_type n)
+		{
+			if(n < _size)
+			{
+				while(_size > n)
+					pop_back();
+			}
+			else
+			{
+				for(size_type k = n - _size;k>0;--k)
+					emplace_back();
+			}
+		}
+
+		void resize(size_type n,const value_type& value)
+		{
+			if(n < _size)
+			{
+				while(_size > n)
+					pop_back();
+			}
+			else
+				insert(end(),n - _size,value);
+		}
+
+		// 归还缓存的空闲节点
+		void shrink_to_fit()
+		{
+			_release_cache();
+		}
+
+		void swap(list& rhs) noexcept
+		{
+			std::swap(_head,rhs._head);
+			std::swap(_size,rhs._size);
+			std::swap(_cache,rhs._cache);
+			std::swap(_ncache,rhs._ncache);
+			_relink_head();
+			rhs._relink_head();
+		}
+
+		// -------------------------- 元素访问 --------------------------
+		reference front() {return _value(_head.next);}
+		const_reference front() const {return _value(_head.next);}
+		reference back() {return _value(_head.prev);}
+		const_reference back() const {return _value(_head.prev);}
+
+		// -------------------------- 元素插入/删除 --------------------------
+		template <typename... Args>
+		iterator emplace(iterator pos,Args&&... args)
+		{
+			node* p = _create_node(std::forward<Args>(args)...);
+			_hook(pos.node,p);
+			++_size;
+			return iterator(p);
+		}
+
+		template <typename... Args>
+		reference emplace_back(Args&&... args)
+		{
+			return *emplace(end(),std::forward<Args>(args)...);
+		}
+
+		template <typename... Args>
+		reference emplace_front(Args&&... args)
+		{
+			return *emplace(begin(),std::forward<Args>(args)...);
+		}
+
+		void push_back(const value_type& value) {emplace(end(),value);}
+		void push_back(value_type&& value) {emplace(end(),std::move(value));}
+		void push_front(const value_type& value) {emplace(begin(),value);}
+		void push_front(value_type&& value) {emplace(begin(),std::move(value));}
+
+		void pop_back() {erase(iterator(_head.prev));}
+		void pop_front() {erase(iterator(_head.next));}
+
+		iterator insert(iterator pos,const value_type& value) {return emplace(pos,value);}
+		iterator insert(iterator pos,value_type&& value) {return emplace(pos,std::move(value));}
+
+		// 返回第一个新元素；中途抛异常时删掉已插入的节点
+		iterator insert(iterator pos,size_type n,const value_type& value)
+		{
+			size_type k = 0;
+			try
+			{
+				for(;k<n;++k)
+					emplace(pos,value);
+			}
+			catch(...)
+			{
+				for(;k>0;--k)
+					erase(iterator(pos.node->prev));
+				throw;
+			}
+			for(;k>0;--k)
+				--pos;
+			return pos;
+		}
+
+		template <typename InputIterator>
+		void insert(iterator pos,InputIterator first,InputIterator last)
+		{
+			_insert_dispatch(pos,first,last,is_integral<InputIterator>());
+		}
+
+		iterator erase(iterator pos)
+		{
+			node_base* next = pos.node->next;
+			_unhook(pos.node);
+			_destroy_node(pos.node);
+			--_size;
+			return iterator(next);
+		}
+
+		iterator erase(iterator first,iterator last)
+		{
+			while(first != last)
+				first = erase(first);
+			return last;
+		}
+
+		// 节点放回缓存，超出上限的还给 Alloc
+		void clear()
+		{
+			node_base* cur = _head.next;
+			while(cur != &_head)
+			{
+				node_base* next = cur->next;
+				_destroy_node(cur);
+				cur = next;
+			}
+			_empty_initialize();
+		}
+
+		// -------------------------- 链表专有操作 --------------------------
+		// 把 x 的全部元素搬到 pos 之前，O(1)
+		void splice(iterator pos,list& x)
+		{
+			if(x.empty() || &x == this)
+				return;
+			_transfer(pos.node,x._head.next,&x._head);
+			_size += x._size;
+			x._size = 0;
+		}
+
+		void splice(iterator pos,list&& x) {splice(pos,x);}
+
+		// 把 x 中的 i 搬到 pos 之前，O(1)
+		void splice(iterator pos,list& x,iterator i)
+		{
+			node_base* next = i.node->next;
+			if(pos.node == i.node || pos.node == next)
+				return;
+			_transfer(pos.node,i.node,next);
+			++_size;
+			--x._size;
+		}
+
+		void splice(iterator pos,list&& x,iterator i) {splice(pos,x,i);}
+
+		// 把 x 中的 [first, last) 搬到 pos 之前
+		// 同一个 list 内 O(1)；来自另一个 list 时要数区间长度以维护 size()
+		void splice(iterator pos,list& x,iterator first,iterator last)
+		{
+			if(first == last)
+				return;
+			if(&x != this)
+			{
+				size_type n = lzstl::distance(first,last);
+				_size += n;
+				x._size -= n;
+			}
+			_transfer(pos.node,first.node,last.node);
+		}
+
+		void splice(iterator pos,list&& x,iterator first,iterator last) {splice(pos,x,first,last);}
+
+		void remove(const value_type& value)
+		{
+			// value 可能就是某个要删的元素，它留到最后再删
+			iterator first = begin();
+			iterator extra = end();
+			while(first != end())
+			{
+				iterator next = first;
+				++next;
+				if(*first == value)
+				{
+					if(&*first != &value)
+						erase(first);
+					else
+						extra = first;
+				}
+				first = next;
+			}
+			if(extra != end())
+				erase(extra);
+		}
+
+		template <typename Predicate>
+		void remove_if(Predicate pred)
+		{
+			iterator first = begin();
+			while(first != end())
+			{
+				if(pred(*first))
+					first = erase(first);
+				else
+					++first;
+			}
+		}
+
+		// 删除连续的重复元素，只保留每组的第一个
+		void unique()
+		{
+			unique(std::equal_to<value_type>());
+		}
+
+		template <typename BinaryPredicate>
+		void unique(BinaryPredicate pred)
+		{
+			if(_size < 2)
+				return;
+			iterator first = begin();
+			iterator next = first;
+			while(++next != end())
+			{
+				if(pred(*first,*next))
+				{
+					erase(next);
+					next = first;
+				}
+				else
+					first = next;
+			}
+		}
+
+		// 两个有序 list 归并到 *this，x 变空；只搬节点，不分配，稳定
+		void merge(list& x)
+		{
+			merge(x,std::less<value_type>());
+		}
+
+		void merge(list&& x) {merge(x);}
+
+		template <typename Compare>
+		void merge(list& x,Compare comp)
+		{
+			if(&x == this)
+				return;
+			node_base* first1 = _head.next;
+			node_base* first2 = x._head.next;
+			while(first1 != &_head && first2 != &x._head)
+			{
+				if(comp(_value(first2),_value(first1)))
+				{
+					// x 中连续若干个都小于 *first1 时一次搬过去
+					node_base* last2 = first2->next;
+					while(last2 != &x._head && comp(_value(last2),_value(first1)))
+						last2 = last2->next;
+					_transfer(first1,first2,last2);
+					first2 = last2;
+				}
+				else
+					first1 = first1->next;
+			}
+			if(first2 != &x._head)
+				_transfer(&_head,first2,&x._head);
+			_size += x._size;
+			x._size = 0;
+		}
+
+		template <typename Compare>
+		void merge(list&& x,Compare comp) {merge(x,comp);}
+
+		// 自底向上归并排序：bins[i] 是长度约 2^i 的有序链，新节点像二进制加法一样逐级进位
+		// 只改指针，不分配内存，稳定，O(n log n)
+		void sort()
+		{
+			sort(std::less<value_type>());
+		}
+
+		template <typename Compare>
+		void sort(Compare comp)
+		{
+			if(_size < 2)
+				return;
+			node_base* rest = _head.next;
+			_head.prev->next = nullptr;
+			node_base* bins[64];
+			int fill = 0;
+			while(rest)
+			{
+				node_base* carry = rest;
+				rest = rest->next;
+				carry->next = nullptr;
+				int i = 0;
+				for(;i<fill && bins[i];++i)
+				{
+					carry = _merge_chain(bins[i],carry,comp);
+					bins[i] = nullptr;
+				}
+				bins[i] = carry;
+				if(i == fill)
+					++fill;
+			}
+			// 编号大的 bin 里是更早的元素，放在归并的前一个参数上保持稳定
+			node_base* result = nullptr;
+			for(int i = 0;i<fill;++i)
+				if(bins[i])
+					result = result ? _merge_chain(bins[i],result,comp) : bins[i];
+
+			// 按新的 next 顺序补上 prev，重新闭合成环
+			node_base* prev = &_head;
+			for(node_base* cur = result;cur;cur = cur->next)
+			{
+				prev->next = cur;
+				cur->prev = prev;
+				prev = cur;
+			}
+			prev->next = &_head;
+			_head.prev = prev;
+		}
+
+		// 交换每个节点（含哨兵）的 prev/next
+		void reverse()
+		{
+			node_base* cur = &_head;
+			do
+			{
+				std::swap(cur->prev,cur->next);
+				cur = cur->prev;
+			}while(cur != &_head);
+		}
+
+		// -------------------------- 分配器相关 --------------------------
+		allocator_type get_allocator() const {return allocator_type();}
+	};
+
+	template <typename T,typename Alloc>
+	inline void swap(list<T,Alloc>& lhs,list<T,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
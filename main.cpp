@@ -2,12 +2,40 @@
 #include <typeinfo>  // 用于typeid
 #include <vector>
 #include <list>
+#include <thread>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <limits>
+#include <unordered_map>
+#include <map>
+#include <set>
+#include <cstdio>
+#include <cstring>
+#include <queue>
 #include "alloc.h"  // 包含你的配置器头文件
 #include "type_traits.h"
 #include "iterator.h"
 #include "construct.h"
 #include "uninitialized.h"
 #include "vector.h"
+#include "soa_vector.h"
+#include "concurrent_vector.h"
+#include "packed_int_vector.h"
+#include "sort.h"
+#include "simd.h"
+#include "thread_pool.h"
+#include "algorithm.h"
+#include "deque.h"
+#include "list.h"
+#include "flat_hash_map.h"
+#include "flat_map.h"
+#include "btree.h"
+#include "spsc_ring.h"
+#include "mpmc_queue.h"
+#include "priority_queue.h"
+#include "basic_string.h"
+#include "static_vector.h"
 
 using namespace std;
 using namespace lzstl;
@@ -123,6 +151,21 @@ void test_type_traits()
 	cout << "long 是否为整数类型: " << (lzstl::is_integral_type<long>() ? "是" : "否") << endl;
 	cout << "float 是否为浮点类型: " << (lzstl::is_floating_point_type<float>() ? "是" : "否") << endl;
 	cout << "int* 是否为整数类型: " << (lzstl::is_integral_type<int*>() ? "是" : "否") << endl;
+	
+	// 测试自动推导：没有手写特化的用户类型
+	struct Point { int x; double y; };
+	struct Named { std::string name; int id; };
+	cout << "Point 是否为POD: " << (lzstl::is_pod_type<Point>() ? "是" : "否") << endl;      // 是
+	cout << "Named 是否为POD: " << (lzstl::is_pod_type<Named>() ? "是" : "否") << endl;      // 否
+	cout << "Named 是否有平凡析构: " << (lzstl::has_trivial_destructor<Named>() ? "是" : "否") << endl; // 否
+	cout << "Point[4] 是否可按字节复制: " << (lzstl::is_trivially_copyable<Point[4]>::value ? "是" : "否") << endl; // 是
+	cout << "int** 是否为POD: " << (lzstl::is_pod_type<int**>() ? "是" : "否") << endl;      // 是
+	
+	// 删除了拷贝的类型：复制/赋值不算平凡（旧的 __has_trivial_copy 会答 “是”）
+	struct NoCopy { NoCopy() {} NoCopy(const NoCopy&) = delete; NoCopy& operator=(const NoCopy&) = delete; int x; };
+	cout << "NoCopy 是否有平凡复制/赋值: "
+	     << (lzstl::type_traits<NoCopy>::has_trivial_copy_constructor::value || lzstl::type_traits<NoCopy>::has_trivial_assignment_operator::value ? "是" : "否")
+	     << endl; // 否
 }
 
 void test_iterator() 
@@ -172,6 +215,36 @@ public:
 	~TestObj() { cout << "~TestObj(" << val << ") 析构" << endl; }
 };
 
+// 第4次构造时抛异常，用于测试异常回滚
+struct Thrower
+{
+	static int alive;
+	Thrower() { if (alive == 3) throw 1; ++alive; }
+	~Thrower() { --alive; }
+};
+int Thrower::alive = 0;
+
+// 标成 POD 但赋值会计数：整块复制时不应调用赋值
+struct CountedPod
+{
+	static int assigns;
+	int v;
+	CountedPod& operator=(const CountedPod& other) { v = other.v; ++assigns; return *this; }
+};
+int CountedPod::assigns = 0;
+namespace lzstl
+{
+	template <>
+	struct type_traits<CountedPod>
+	{
+		typedef true_type has_trivial_default_constructor;
+		typedef true_type has_trivial_copy_constructor;
+		typedef true_type has_trivial_assignment_operator;
+		typedef true_type has_trivial_destructor;
+		typedef true_type is_POD_type;
+	};
+}
+
 void test_construct() 
 {
 	cout << "\n=== 测试 construct.h ===" << endl;
@@ -206,6 +279,29 @@ void test_construct()
 	// 释放内存
 	lzstl::alloc::deallocate(arr, n * sizeof(TestObj));
 	lzstl::alloc::deallocate(mem, sizeof(TestObj));
+	
+	// 批量构造/析构：POD 无参数为 0，带参数为同一个值
+	int* ints = static_cast<int*>(lzstl::alloc::allocate(8 * sizeof(int)));
+	int* ints_end = lzstl::construct_n(ints, 4);
+	lzstl::construct_n(ints_end, 4, 7);
+	cout << "construct_n(int): ";
+	for (int i = 0; i < 8; ++i) cout << ints[i] << " "; // 0 0 0 0 7 7 7 7
+	cout << endl;
+	cout << "destroy_n 返回 first+n: " << (lzstl::destroy_n(ints, 8) == ints + 8 ? "是" : "否") << endl; // 是
+	lzstl::alloc::deallocate(ints, 8 * sizeof(int));
+	
+	// 非POD：每个对象用同一组参数构造
+	std::string* strs = static_cast<std::string*>(lzstl::alloc::allocate(3 * sizeof(std::string)));
+	lzstl::construct_n(strs, 3, 2, 'x');
+	cout << "construct_n(string, 2, 'x'): " << strs[0] << " " << strs[1] << " " << strs[2] << endl; // xx xx xx
+	lzstl::destroy_n(strs, 3);
+	lzstl::alloc::deallocate(strs, 3 * sizeof(std::string));
+	
+	// 中途抛异常：已构造的全部析构
+	Thrower* ts = static_cast<Thrower*>(lzstl::alloc::allocate(5 * sizeof(Thrower)));
+	try { lzstl::construct_n(ts, 5); } catch (int) {}
+	cout << "construct_n 异常后存活对象数: " << Thrower::alive << endl; // 0
+	lzstl::alloc::deallocate(ts, 5 * sizeof(Thrower));
 }
 
 void test_uninitialized() 
@@ -250,8 +346,79 @@ void test_uninitialized()
 	cout << "uninitialized_move 目标对象值: " << dest4->val << endl;  // 应输出30
 	lzstl::destroy(dest4, end4);
 	lzstl::alloc::deallocate(dest4, sizeof(TestObj));
+	
+	// 测试uninitialized_copy（POD，不连续的 std::list 迭代器：不能 memcpy）
+	std::list<int> src5 = {5, 6, 7, 8, 9};
+	int dest5[5] = {0};
+	lzstl::uninitialized_copy(src5.begin(), src5.end(), dest5);
+	cout << "uninitialized_copy list<int> 结果: ";
+	for (int x : dest5) cout << x << " ";  // 应输出5 6 7 8 9
+	cout << endl;
+	cout << "int* 是连续迭代器: " << lzstl::is_contiguous_iterator<int*>::value
+	     << "，list<int>::iterator 是连续迭代器: " << lzstl::is_contiguous_iterator<std::list<int>::iterator>::value << endl; // 1，0
+	
+	// 测试uninitialized_copy（空区间 + 大块非临时复制）
+	lzstl::uninitialized_copy((int*)nullptr, (int*)nullptr, (int*)nullptr);
+	const size_t big = 100000;
+	lzstl::vector<long long> v6;
+	for (size_t i = 0; i < big; ++i) v6.push_back((long long)i * 3);
+	size_t old = lzstl::nontemporal_threshold();
+	lzstl::set_nontemporal_threshold(4096);
+	lzstl::vector<long long> v7(v6);
+	lzstl::set_nontemporal_threshold(old);
+	cout << "非临时存储复制一致: " << (std::equal(v6.begin(), v6.end(), v7.begin()) ? "是" : "否") << endl; // 是
+
+	// 连续 POD 走整块复制：不调用赋值；元素类型不同则逐个转换
+	CountedPod cp[4] = {{1}, {2}, {3}, {4}};
+	CountedPod cq[4];
+	lzstl::uninitialized_copy(cp, cp + 4, cq);
+	cout << "POD 整块复制赋值次数: " << CountedPod::assigns << "，cq[3]=" << cq[3].v << endl; // 0，cq[3]=4
+	const int ci[3] = {-1, 2, -3};
+	long long cl[3];
+	lzstl::uninitialized_copy(ci, ci + 3, cl);
+	cout << "int -> long long 复制: " << cl[0] << " " << cl[1] << " " << cl[2] << endl; // -1 2 -3
+	// 源是 POD、目标不是：必须逐个构造，不能往未构造的 string 上赋值
+	const char* cs[3] = {"alpha", "beta", "gamma"};
+	lzstl::vector<std::string> vs(cs, cs + 3);
+	lzstl::static_vector<std::string, 4> ss(cs, cs + 3);
+	cout << "const char* -> string: " << vs[0] << " " << vs[2] << " " << ss[1] << endl; // alpha gamma beta
+	
+	// 测试uninitialized_value_construct_n（POD：全部为0）/ default_construct（非POD：调用默认构造）
+	int* dest8 = static_cast<int*>(lzstl::alloc::allocate(8 * sizeof(int)));
+	std::memset(dest8, 0x7F, 8 * sizeof(int));
+	int* end8 = lzstl::uninitialized_value_construct_n(dest8, 8);
+	cout << "uninitialized_value_construct_n 结果: ";
+	for (int* p = dest8; p != end8; ++p) cout << *p << " ";  // 应输出0 0 0 0 0 0 0 0
+	cout << endl;
+	lzstl::alloc::deallocate(dest8, 8 * sizeof(int));
+	std::string* dest9 = static_cast<std::string*>(lzstl::alloc::allocate(3 * sizeof(std::string)));
+	lzstl::uninitialized_default_construct(dest9, dest9 + 3);
+	cout << "uninitialized_default_construct string 为空: " << (dest9[0].empty() && dest9[2].empty() ? "是" : "否") << endl; // 是
+	lzstl::destroy(dest9, dest9 + 3);
+	lzstl::alloc::deallocate(dest9, 3 * sizeof(std::string));
+	
+	// 非POD 构造中途抛异常：已构造的要析构
+	Thrower* dest10 = static_cast<Thrower*>(lzstl::alloc::allocate(5 * sizeof(Thrower)));
+	try { lzstl::uninitialized_value_construct_n(dest10, 5); } catch (int) {}
+	cout << "构造异常后存活对象数: " << Thrower::alive << endl; // 0
+	lzstl::alloc::deallocate(dest10, 5 * sizeof(Thrower));
+	
+	lzstl::vector<double> v11(4);
+	v11.resize(6);
+	cout << "vector<double>(4).resize(6) 全为0: " << (std::count(v11.begin(), v11.end(), 0.0) == 6 ? "是" : "否") << endl; // 是
 }
 
+// 移动构造没有 noexcept；复制在 copies_left 减到 0 时抛异常（-1 表示从不抛）
+struct grow_probe
+{
+	static int copies_left;
+	std::string s;
+	grow_probe(const char* x) : s(x) {}
+	grow_probe(const grow_probe& other) : s(other.s) { if (copies_left == 0) throw 1; if (copies_left > 0) --copies_left; }
+	grow_probe(grow_probe&& other) : s(std::move(other.s)) {}
+};
+int grow_probe::copies_left = -1;
+
 void test_vector() 
 {
 	cout << "\n=== 测试 vector.h ===" << endl;
@@ -281,6 +448,1554 @@ void test_vector()
 	// 拷贝赋值
 	lzstl::vector<int> vec2 = vec;
 	cout << "\n拷贝后vec2大小：" << vec2.size(); // 3
+	
+	// 满容量时插入 n 个自身元素：扩容前要先复制 value
+	lzstl::vector<std::string> vs;
+	vs.reserve(2);
+	vs.push_back(std::string(20, 'a'));
+	vs.push_back(std::string(20, 'b'));
+	vs.insert(vs.begin(), (size_t)3, vs[1]);
+	cout << "\n插入自身元素后：" << vs.size() << " " << vs[0][0] << vs[2][0] << vs[3][0] << vs[4][0]; // 5 bbab
+	
+	// 移动构造可能抛异常的类型扩容时复制：复制中途抛异常，原有元素不受影响
+	lzstl::vector<grow_probe> g;
+	g.reserve(2);
+	g.push_back(grow_probe("aa"));
+	g.push_back(grow_probe("bb"));
+	grow_probe::copies_left = 1;
+	try { g.push_back(grow_probe("cc")); } catch (int) {}
+	grow_probe::copies_left = -1;
+	cout << "\n扩容异常后：" << g.size() << " " << g[0].s << " " << g[1].s << endl; // 2 aa bb
+}
+
+void test_vector_move_only()
+{
+	cout << "\n=== 测试 vector 只能移动的元素 ===" << endl;
+	lzstl::vector<std::unique_ptr<int>> v;
+	for (int i = 0; i < 10; ++i)
+		v.push_back(std::unique_ptr<int>(new int(i)));     // 扩容时移动旧元素
+	v.emplace_back(new int(10));
+	v.insert(v.begin(), std::unique_ptr<int>(new int(-1)));
+	v.erase(v.begin() + 5);
+	lzstl::vector<std::unique_ptr<int>> w(std::move(v));
+	cout << "unique_ptr 元素: ";
+	for (size_t i = 0; i < w.size(); ++i) cout << *w[i] << " ";  // -1 0 1 2 3 5 6 7 8 9 10
+	cout << endl;
+	cout << "移动后原 vector 为空: " << (v.empty() ? "是" : "否") << endl; // 是
+	
+	// 非POD 插入/删除：挪动用移动，空位先析构再构造
+	lzstl::vector<std::string> s;
+	for (int i = 0; i < 5; ++i) s.push_back(std::string(20, char('a' + i)));
+	s.insert(s.begin() + 1, 3, std::string("xyz"));
+	s.insert(s.begin() + 7, s[0]);          // 插入的是自己的元素
+	s.erase(s.begin() + 2, s.begin() + 4);
+	cout << "string 插入删除后: ";
+	for (size_t i = 0; i < s.size(); ++i) cout << s[i].substr(0, 3) << " ";  // aaa xyz bbb ccc ddd aaa eee
+	cout << endl;
+}
+
+void test_vector_shrink()
+{
+	cout << "\n\n=== 测试 vector shrink_to_fit / swap ===" << endl;
+	// 小块：20个int(80字节)缩到3个int，容量按8字节规格取整为4
+	lzstl::vector<int> small;
+	small.reserve(20);
+	for (int i = 0; i < 3; ++i) small.push_back(i);
+	int* old_block = small.data();
+	small.shrink_to_fit();
+	cout << "shrink 后 size: " << small.size() << ", capacity: " << small.capacity()
+	     << ", 元素: " << small[0] << small[1] << small[2] << endl; // 3 4 012
+	// 旧的80字节块已经回到自由链表，再申请80字节会拿到它
+	void* reuse = lzstl::alloc::allocate(80);
+	cout << "旧块回到自由链表: " << (reuse == old_block ? "是" : "否") << endl; // 是
+	lzstl::alloc::deallocate(reuse, 80);
+	
+	// 大块：走 realloc 缩小
+	lzstl::vector<long> big;
+	for (long i = 0; i < 1000; ++i) big.push_back(i);
+	big.erase(big.begin() + 100, big.end());
+	big.shrink_to_fit();
+	cout << "大块 shrink 后 capacity: " << big.capacity() << ", back: " << big.back() << endl; // 100 99
+	
+	// clear + shrink_to_fit 归还全部内存
+	big.clear();
+	big.shrink_to_fit();
+	cout << "clear+shrink 后 capacity: " << big.capacity() << endl; // 0
+	
+	// 非POD 元素逐个移动
+	lzstl::vector<std::string> strs;
+	strs.reserve(16);
+	strs.push_back("alpha");
+	strs.push_back("beta");
+	strs.shrink_to_fit();
+	cout << "string shrink 后 capacity: " << strs.capacity() << ", 内容: " << strs[0] << " " << strs[1] << endl; // 2 alpha beta
+	
+	// swap 只交换指针
+	lzstl::vector<int> other;
+	int* small_data = small.data();
+	lzstl::swap(small, other);
+	cout << "swap 后 other.size: " << other.size() << ", 数据指针被交换: " << (other.data() == small_data ? "是" : "否") << endl; // 3 是
+}
+
+void test_vector_snapshot()
+{
+	cout << "\n=== 测试 vector snapshot（写时复制）===" << endl;
+	lzstl::vector<int> vec;
+	for (int i = 0; i < 100; ++i) vec.push_back(i);
+	
+	// 快照与 vector 共享缓冲区，复制快照只加引用计数
+	const lzstl::vector<int>& cvec = vec;
+	lzstl::vector_snapshot<int> snap = vec.snapshot();
+	lzstl::vector_snapshot<int> reader = snap;
+	cout << "快照共享缓冲区: " << (snap.data() == cvec.data() ? "是" : "否")
+	     << ", 引用计数: " << reader.use_count() << endl; // 是 3
+	
+	// vector 修改时才复制，快照内容不变
+	vec[0] = -1;
+	vec.push_back(100);
+	cout << "修改后 vec[0]: " << vec[0] << ", vec.size: " << vec.size()
+	     << ", 快照[0]: " << reader[0] << ", 快照 size: " << reader.size()
+	     << ", 已分离: " << (snap.data() != cvec.data() ? "是" : "否") << endl; // -1 101 0 100 是
+	
+	// 快照都释放后，vector 再次快照并修改时直接收回缓冲区，不复制
+	snap = lzstl::vector_snapshot<int>();
+	reader = lzstl::vector_snapshot<int>();
+	{
+		lzstl::vector_snapshot<int> tmp = vec.snapshot();
+	}
+	const int* before = cvec.data();
+	vec[1] = -2;
+	cout << "无快照时修改不复制: " << (cvec.data() == before ? "是" : "否") << endl; // 是
+	
+	// 快照可以比 vector 活得久
+	lzstl::vector_snapshot<std::string> keep;
+	{
+		lzstl::vector<std::string> names;
+		names.push_back("a");
+		names.push_back("b");
+		keep = names.snapshot();
+	}
+	cout << "vector 析构后快照仍可读: " << keep[0] << keep[1] << endl; // ab
+}
+
+// 复制次数用完后复制抛异常，移动赋值可以设成抛一次；移动构造不是 noexcept，扩容时会改用复制
+struct soa_probe
+{
+	static int copies_left, assigns_left;
+	std::string s;
+	soa_probe(const char* x) : s(x) {}
+	soa_probe(const soa_probe& other) : s(other.s) { if (copies_left == 0) throw 1; if (copies_left > 0) --copies_left; }
+	soa_probe(soa_probe&& other) : s(std::move(other.s)) {}
+	soa_probe& operator=(const soa_probe& other) { s = other.s; return *this; }
+	soa_probe& operator=(soa_probe&& other)
+	{
+		if (assigns_left == 0) { assigns_left = -1; throw 1; }
+		if (assigns_left > 0) --assigns_left;
+		s = std::move(other.s);
+		return *this;
+	}
+};
+int soa_probe::copies_left = -1;
+int soa_probe::assigns_left = -1;
+
+// 各列逐行拼起来，方便比较
+std::string soa_rows(const lzstl::soa_vector<int, soa_probe>& v)
+{
+	std::string r;
+	for (size_t i = 0; i < v.size(); ++i) r += std::to_string(v.data<0>()[i]) + v.data<1>()[i].s + " ";
+	return r;
+}
+
+void test_soa_vector()
+{
+	cout << "\n\n=== 测试 soa_vector.h ===" << endl;
+	// 每行三个字段：id / 分数 / 名字，分三列存放
+	lzstl::soa_vector<int, double, std::string> sv;
+	for (int i = 0; i < 5; ++i)
+		sv.push_back(i, i * 1.5, "row" + std::to_string(i));
+	cout << "push_back后 size: " << sv.size() << ", capacity: " << sv.capacity() << endl; // 5 8
+	
+	// 按列扫描：只碰 double 这一列
+	double sum = 0;
+	const double* scores = sv.data<1>();
+	for (size_t i = 0; i < sv.size(); ++i) sum += scores[i];
+	cout << "第1列求和: " << sum << endl; // 15
+	
+	// 插入/删除保持各列对齐
+	sv.insert(sv.begin() + 1, 100, 0.5, "new");
+	sv.erase(sv.begin() + 3);
+	cout << "插入删除后：";
+	for (auto row : sv) cout << "(" << std::get<0>(row) << "," << std::get<2>(row) << ") ";
+	cout << endl; // (0,row0) (100,new) (1,row1) (3,row3) (4,row4)
+	
+	// 拉链迭代器可以写回
+	for (auto it = sv.begin(); it != sv.end(); ++it) std::get<0>(*it) *= 2;
+	cout << "写回后第0列: ";
+	for (size_t i = 0; i < sv.size(); ++i) cout << sv.data<0>()[i] << " ";
+	cout << endl; // 0 200 2 6 8
+	
+	// resize 扩大时各列用给定值填充，缩小时逐列析构
+	sv.resize(7, -1, 9.0, "fill");
+	cout << "resize(7)后最后一行: " << std::get<0>(sv.back()) << " " << std::get<2>(sv.back()) << endl; // -1 fill
+	sv.resize(2);
+	lzstl::soa_vector<int, double, std::string> sv2 = sv;
+	cout << "resize(2)后拷贝 size: " << sv2.size() << ", 第二行名字: " << std::get<2>(sv2[1]) << endl; // 2 new
+	
+	// 某一列抛异常：已插入的列撤销，抛异常的列自己也恢复原样，各列长度一致
+	lzstl::soa_vector<int, soa_probe> pv;
+	pv.reserve(4);
+	pv.push_back(1, "a");
+	pv.push_back(2, "b");
+	pv.push_back(3, "c");
+	const std::string before = soa_rows(pv);
+	bool ok = true;
+	soa_probe::copies_left = 2;		// 整行先复制两次，第二列复制新值时抛异常
+	try { pv.insert(pv.begin() + 1, 9, soa_probe("x")); ok = false; } catch (int) {}
+	soa_probe::copies_left = -1;
+	ok = ok && pv.size() == 3 && soa_rows(pv) == before;
+	soa_probe::assigns_left = 1;	// 后移到一半时移动赋值抛异常
+	try { pv.insert(pv.begin(), 9, soa_probe("x")); ok = false; } catch (int) {}
+	ok = ok && pv.size() == 3 && soa_rows(pv) == before;
+	pv.push_back(4, "d");
+	soa_probe::copies_left = 2;		// 扩容搬到第三个元素时抛异常
+	try { pv.push_back(5, "e"); ok = false; } catch (int) {}
+	soa_probe::copies_left = -1;
+	ok = ok && pv.size() == 4 && pv.capacity() == 4 && soa_rows(pv) == before + "4d ";
+	pv.insert(pv.begin() + 2, 7, soa_probe("z"));
+	cout << "插入/扩容抛异常后各列不变: " << (ok ? "是" : "否") << ", 之后插入: " << soa_rows(pv) << endl; // 是 1a 2b 7z 3c 4d
+}
+
+// 记录分配次数的配置器
+struct counting_alloc
+{
+	static std::atomic<int> allocs;
+	static void* allocate(size_t n) { allocs.fetch_add(1); return lzstl::malloc_alloc::allocate(n); }
+	static void deallocate(void* p, size_t n) { lzstl::malloc_alloc::deallocate(p, n); }
+};
+std::atomic<int> counting_alloc::allocs(0);
+
+void test_concurrent_vector()
+{
+	cout << "\n=== 测试 concurrent_vector.h ===" << endl;
+	lzstl::concurrent_vector<int> cv;
+	
+	// 4个线程同时尾插，每个线程写入 t*10000 + i
+	const int nthreads = 4, per_thread = 10000;
+	std::vector<std::thread> workers;
+	for (int t = 0; t < nthreads; ++t)
+		workers.emplace_back([&cv, t]() {
+			for (int i = 0; i < per_thread; ++i)
+				cv.push_back(t * per_thread + i);
+		});
+	for (auto& w : workers) w.join();
+	
+	// 每个值恰好出现一次
+	std::vector<int> seen(nthreads * per_thread, 0);
+	bool all_ready = true;
+	for (size_t i = 0; i < cv.size(); ++i)
+	{
+		all_ready = all_ready && cv.ready(i);
+		++seen[cv[i]];
+	}
+	bool unique = true;
+	for (int c : seen) unique = unique && (c == 1);
+	cout << "并发尾插后 size: " << cv.size() << ", 全部就绪: " << (all_ready ? "是" : "否")
+	     << ", 无重复无丢失: " << (unique ? "是" : "否") << endl; // 40000 是 是
+	
+	// grow_by 一次领取一段连续下标，已有元素地址不变
+	int* first = &cv[0];
+	size_t idx = cv.grow_by(100, 7);
+	cout << "grow_by 起始下标: " << idx << ", 末元素: " << cv[idx + 99]
+	     << ", 首元素地址不变: " << (first == &cv[0] ? "是" : "否") << endl; // 40000 7 是
+	
+	// 多个线程同时碰到同一个空段：只有一个线程去分配
+	{
+		lzstl::concurrent_vector<int, counting_alloc> cc;
+		std::vector<std::thread> racers;
+		for (int t = 0; t < 8; ++t)
+			racers.emplace_back([&cc]() { for (int i = 0; i < 2000; ++i) cc.push_back(i); });
+		for (auto& r : racers) r.join();
+		cout << "16000 个元素的段分配次数: " << counting_alloc::allocs.load() << endl; // 11
+	}
+}
+
+void test_bit_vector()
+{
+	cout << "\n=== 测试 bvector.h ===" << endl;
+	// vector<bool> 按位存储：1000 个标志只占 16 个字
+	lzstl::bit_vector bv(1000, false);
+	cout << "1000位占用字数: " << bv.word_count() << ", 字节数: " << bv.word_count() * 8 << endl; // 16 128
+	
+	bv[3] = true;
+	bv[64] = true;
+	bv[999] = true;
+	cout << "count: " << bv.count() << endl; // 3
+	cout << "find_first/find_next: ";
+	for (size_t i = bv.find_first(); i != lzstl::bit_vector::npos; i = bv.find_next(i))
+		cout << i << " ";
+	cout << endl; // 3 64 999
+	
+	// resize 整字填充，尾部多余的位保持为0
+	bv.resize(1100, true);
+	cout << "resize(1100, true) 后 count: " << bv.count() << endl; // 103
+	
+	// 按字的 与 / 或 / 异或
+	lzstl::bit_vector a(130, false), b(130, false);
+	for (size_t i = 0; i < 130; i += 2) a[i] = true;  // 偶数位
+	for (size_t i = 0; i < 130; i += 3) b[i] = true;  // 3的倍数
+	cout << "a&b: " << (a & b).count() << ", a|b: " << (a | b).count() << ", a^b: " << (a ^ b).count() << endl; // 22 87 65
+	
+	// 代理引用与迭代器
+	a.flip();
+	size_t ones = 0;
+	for (auto it = a.begin(); it != a.end(); ++it) ones += *it;
+	cout << "flip 后迭代计数: " << ones << ", push_back/erase 后 size: ";
+	a.push_back(true);
+	a.erase(a.begin());
+	cout << a.size() << ", 首位: " << a[0] << ", 末位: " << a.back() << endl; // 65 130 1 1
+	
+	// 整字移位的 insert / erase：和 std::vector<bool> 逐位比较（跨字、区间删除、删到字边界）
+	lzstl::bit_vector c;
+	std::vector<bool> ref;
+	unsigned seed = 12345;
+	for (int i = 0; i < 300; ++i) { seed = seed * 1103515245 + 12345; c.push_back(seed >> 20 & 1); ref.push_back(seed >> 20 & 1); }
+	for (int i = 0; i < 200; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		size_t at = (seed >> 8) % (ref.size() + 1);
+		bool bit = seed >> 30 & 1;
+		c.insert(c.begin() + at, bit);
+		ref.insert(ref.begin() + at, bit);
+		if (i % 3 == 0)
+		{
+			size_t from = (seed >> 4) % ref.size();
+			size_t len = (seed >> 12) % 100;
+			if (len > ref.size() - from) len = ref.size() - from;
+			c.erase(c.begin() + from, c.begin() + from + len);
+			ref.erase(ref.begin() + from, ref.begin() + from + len);
+		}
+	}
+	bool same = c.size() == ref.size() && c.count() == (size_t)std::count(ref.begin(), ref.end(), true);
+	for (size_t i = 0; i < ref.size() && same; ++i) same = c[i] == ref[i];
+	cout << "随机 insert/erase 与 std::vector<bool> 一致: " << (same ? "是" : "否") << endl; // 是
+}
+
+void test_packed_int_vector()
+{
+	cout << "\n=== 测试 packed_int_vector.h ===" << endl;
+	const size_t n = 10000;
+	
+	// 小取值列：0~999 的 ID，FOR 位宽约10位
+	lzstl::packed_int_vector<> ids;
+	// 有序列：递增时间戳，相邻差 0~15，差分只需4位
+	lzstl::packed_int_vector<> stamps(true);
+	unsigned long long ts = 1700000000000ULL;
+	std::vector<unsigned long long> ref_ids, ref_stamps;
+	for (size_t i = 0; i < n; ++i)
+	{
+		unsigned long long id = (i * 7919) % 1000;
+		ts += (i * 31) % 16;
+		ids.push_back(id);
+		stamps.push_back(ts);
+		ref_ids.push_back(id);
+		ref_stamps.push_back(ts);
+	}
+	
+	// 随机访问与顺序解码都要和原数据一致
+	bool ok = true;
+	for (size_t i = 0; i < n; ++i)
+		ok = ok && ids[i] == ref_ids[i] && stamps[i] == ref_stamps[i];
+	std::vector<unsigned long long> out(n);
+	stamps.decode(0, n, out.data());
+	ok = ok && out == ref_stamps;
+	ids.decode(100, 1000, out.data());
+	ok = ok && std::equal(out.begin(), out.begin() + 1000, ref_ids.begin() + 100);
+	cout << "随机访问/顺序解码一致: " << (ok ? "是" : "否") << endl; // 是
+	
+	size_t raw = n * sizeof(unsigned long long);
+	cout << "ID列 压缩比: " << (double)raw / ids.memory_bytes() << "x" << endl;       // 约5x
+	cout << "时间戳列 压缩比: " << (double)raw / stamps.memory_bytes() << "x" << endl; // 约10x
+}
+
+void test_sort()
+{
+	cout << "\n=== 测试 sort.h ===" << endl;
+	const size_t n = 100000;
+	unsigned long long seed = 88172645463325252ULL;
+	auto rnd = [&]() { seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17; return seed; };
+	
+	// 有符号整数：负数要排在正数前面；多线程与单线程结果一致
+	lzstl::vector<int> a;
+	for (size_t i = 0; i < n; ++i)
+		a.push_back((int)rnd());
+	std::vector<int> ref(a.begin(), a.end());
+	std::sort(ref.begin(), ref.end());
+	lzstl::vector<int> b = a, c = a;
+	lzstl::radix_sort(a.begin(), a.end(), 1);
+	lzstl::radix_sort(b.begin(), b.end(), 4);
+	lzstl::radix_sort(c.begin(), c.end());		// 默认：硬件线程数
+	cout << "radix_sort<int> 单线程/4线程/默认线程数正确: " << (std::equal(ref.begin(), ref.end(), a.begin()) && std::equal(ref.begin(), ref.end(), b.begin())
+	     && std::equal(ref.begin(), ref.end(), c.begin()) ? "是" : "否") << endl; // 是
+	
+	// 浮点数：含负数、0
+	lzstl::vector<double> d;
+	for (size_t i = 0; i < n; ++i)
+		d.push_back((double)(long long)(rnd() % 2000001) / 1000.0 - 1000.0);
+	std::vector<double> dref(d.begin(), d.end());
+	std::sort(dref.begin(), dref.end());
+	lzstl::radix_sort(d.begin(), d.end(), 3);
+	cout << "radix_sort<double> 正确: " << (std::equal(dref.begin(), dref.end(), d.begin()) ? "是" : "否") << endl; // 是
+	
+	// 按键排序记录：相同键保持原来的先后顺序（稳定）
+	struct record { unsigned long long key; size_t seq; };
+	lzstl::vector<record> r, m;
+	for (size_t i = 0; i < n; ++i)
+	{
+		record x = { rnd() % 1000, i };
+		r.push_back(x);
+		m.push_back(x);
+	}
+	auto stable = [](const lzstl::vector<record>& v) {
+		for (size_t i = 1; i < v.size(); ++i)
+			if (v[i-1].key > v[i].key || (v[i-1].key == v[i].key && v[i-1].seq > v[i].seq))
+				return false;
+		return true;
+	};
+	lzstl::radix_sort_by_key(r.begin(), r.end(), [](const record& x) { return x.key; }, 4);
+	cout << "radix_sort_by_key 稳定: " << (stable(r) ? "是" : "否") << endl; // 是
+	lzstl::parallel_merge_sort(m.begin(), m.end(), [](const record& x, const record& y) { return x.key < y.key; }, 3);
+	cout << "parallel_merge_sort 稳定: " << (stable(m) ? "是" : "否") << endl; // 是
+	
+	// 非 POD 元素
+	lzstl::vector<std::string> s;
+	for (size_t i = 0; i < 30000; ++i)
+		s.push_back(std::to_string(rnd() % 100000));
+	std::vector<std::string> sref(s.begin(), s.end());
+	std::sort(sref.begin(), sref.end());
+	lzstl::parallel_merge_sort(s.begin(), s.end(), std::less<std::string>(), 5);
+	cout << "parallel_merge_sort<string> 正确: " << (std::equal(sref.begin(), sref.end(), s.begin()) ? "是" : "否") << endl; // 是
+}
+
+// 检查 simd_fill 在各种起始偏移、长度下只写 [first, first+n)，且每个元素都等于 value
+template <typename T>
+bool check_simd_fill(const T& value)
+{
+	const size_t cap = 600;
+	unsigned char* raw = static_cast<unsigned char*>(lzstl::alloc::allocate(cap * sizeof(T) + 192));
+	bool ok = true;
+	for (size_t offset = 0; offset < 8; ++offset)
+		for (size_t n = 0; n < cap; n += 37)
+		{
+			std::memset(raw, 0x5A, cap * sizeof(T) + 192);
+			T* first = reinterpret_cast<T*>(raw + 64 + offset * sizeof(T) + 1 % alignof(T));
+			lzstl::simd_fill(first, n, value);
+			for (size_t i = 0; i < n; ++i)
+				ok = ok && std::memcmp(first + i, &value, sizeof(T)) == 0;
+			unsigned char* end = reinterpret_cast<unsigned char*>(first + n);
+			ok = ok && reinterpret_cast<unsigned char*>(first)[-1] == 0x5A && end[0] == 0x5A && end[63] == 0x5A;
+		}
+	lzstl::alloc::deallocate(raw, cap * sizeof(T) + 192);
+	return ok;
+}
+
+void test_simd_fill()
+{
+	cout << "\n=== 测试 simd.h ===" << endl;
+	const char* levels[] = {"无", "SSE2", "AVX2", "AVX-512"};
+	cout << "检测到的 SIMD 指令集: " << levels[lzstl::simd_level()] << endl;
+	
+	struct pod16 { long long a; double b; };
+	struct pod12 { int a, b, c; };		// 12、24 不整除 64，花样周期 192 字节
+	struct pod24 { double a; int b, c; long long d; };
+	struct pod7 { char c[7]; };			// 周期 448 字节
+	struct pod62 { char c[62]; };		// 周期太长，走逐元素路径
+	pod16 v16 = { -3, 2.5 };
+	pod12 v12 = { 1, 2, 3 };
+	pod24 v24 = { 1.5, -2, 3, 0x0102030405060708LL };
+	pod7 v7 = { { 1, 2, 3, 4, 5, 6, 7 } };
+	pod62 v62;
+	for (int i = 0; i < 62; ++i) v62.c[i] = char(i);
+	bool ok = check_simd_fill<char>('x') && check_simd_fill<short>(0x1234) && check_simd_fill<int>(0x01020304)
+	       && check_simd_fill<long long>(0x0102030405060708LL) && check_simd_fill<double>(3.14)
+	       && check_simd_fill(v16) && check_simd_fill(v12) && check_simd_fill(v24) && check_simd_fill(v7)
+	       && check_simd_fill(v62) && check_simd_fill<int>(-1);
+	cout << "各种元素大小/对齐/长度填充正确: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 非临时存储：阈值调小后同样正确
+	size_t old = lzstl::nontemporal_threshold();
+	lzstl::set_nontemporal_threshold(256);
+	ok = check_simd_fill<int>(7) && check_simd_fill<char>(0) && check_simd_fill(v16) && check_simd_fill(v12) && check_simd_fill(v24);
+	lzstl::set_nontemporal_threshold(old);
+	cout << "非临时存储填充正确: " << (ok ? "是" : "否") << endl; // 是
+	
+	// vector(n, value) 与 resize 走 SIMD 路径
+	lzstl::vector<int> v(1000, 42);
+	v.resize(3000, 7);
+	ok = v[0] == 42 && v[999] == 42 && v[1000] == 7 && v[2999] == 7;
+	cout << "vector(n, value)/resize 填充正确: " << (ok ? "是" : "否") << endl; // 是
+}
+
+// 随机数据（取值范围小，保证有命中和重复），与 std 的结果逐一比较
+// 各种长度和起始偏移，覆盖向量主体、尾部和非对齐的情况
+template <typename T>
+bool check_algorithm(int range)
+{
+	unsigned seed = 12345;
+	auto next = [&]() { seed = seed * 1103515245u + 12345u; return T(int(seed >> 16) % range - range / 3); };
+	std::vector<T> a(400), b(400);
+	for (size_t i = 0; i < a.size(); ++i) { a[i] = next(); b[i] = a[i]; }
+	for (size_t off = 0; off < 3; ++off)
+		for (size_t n = 0; n + off <= a.size(); n += (n < 140 ? 1 : 37))
+		{
+			const T* p = a.data() + off;
+			T* q = b.data() + off;
+			T v = n ? p[n / 2] : T(1);
+			if (lzstl::find(p, p + n, v) != std::find(p, p + n, v)) return false;
+			if (lzstl::count(p, p + n, v) != std::count(p, p + n, v)) return false;
+			if (lzstl::min_element(p, p + n) != std::min_element(p, p + n)) return false;
+			if (lzstl::max_element(p, p + n) != std::max_element(p, p + n)) return false;
+			if (!lzstl::equal(p, p + n, q)) return false;
+			if (n)
+			{
+				T saved = q[n - 1 - n / 3];
+				q[n - 1 - n / 3] = T(saved + 1);
+				if (lzstl::mismatch(p, p + n, q) != std::mismatch(p, p + n, q)) return false;
+				if (lzstl::lexicographical_compare(p, p + n, q, q + n) != std::lexicographical_compare(p, p + n, q, q + n)) return false;
+				if (lzstl::lexicographical_compare(q, q + n, p, p + n) != std::lexicographical_compare(q, q + n, p, p + n)) return false;
+				q[n - 1 - n / 3] = saved;
+			}
+			if (lzstl::lexicographical_compare(p, p + n / 2, q, q + n) != std::lexicographical_compare(p, p + n / 2, q, q + n)) return false;
+		}
+	return true;
+}
+
+// 直接调用每一级内核（CPU 支持时），不只是当前选中的那一级
+template <typename T>
+bool check_algorithm_kernels()
+{
+	std::vector<T> a(300);
+	for (size_t i = 0; i < a.size(); ++i) a[i] = T(int(i * 7 % 101) - 50);
+	typedef lzstl::__find_kernels<T> fk;
+	typedef lzstl::__count_kernels<T> ck;
+	std::vector<typename fk::type> finds(1, &fk::scalar);
+	std::vector<typename ck::type> counts(1, &ck::scalar);
+#ifdef LZ_STL_SIMD_X86
+	if (__builtin_cpu_supports("avx2")) { finds.push_back(&fk::avx2); counts.push_back(&ck::avx2); }
+	if (__builtin_cpu_supports("avx512bw")) { finds.push_back(&fk::avx512); counts.push_back(&ck::avx512); }
+#endif
+	for (size_t k = 0; k < finds.size(); ++k)
+		for (size_t n = 0; n <= a.size(); n += 13)
+			for (int v = -50; v <= 50; v += 25)
+			{
+				if (finds[k](a.data(), n, T(v)) != size_t(std::find(a.data(), a.data() + n, T(v)) - a.data())) return false;
+				if (counts[k](a.data(), n, T(v)) != size_t(std::count(a.data(), a.data() + n, T(v)))) return false;
+			}
+	return true;
+}
+
+void test_algorithm()
+{
+	cout << "\n=== 测试 algorithm.h ===" << endl;
+	bool ok = check_algorithm<char>(7) && check_algorithm<signed char>(7) && check_algorithm<unsigned char>(200)
+	       && check_algorithm<short>(50) && check_algorithm<unsigned short>(50) && check_algorithm<int>(50)
+	       && check_algorithm<unsigned>(50) && check_algorithm<long long>(50) && check_algorithm<unsigned long long>(50)
+	       && check_algorithm<float>(20) && check_algorithm<double>(20);
+	cout << "SIMD 路径与 std 结果一致: " << (ok ? "是" : "否") << endl; // 是
+	ok = check_algorithm_kernels<char>() && check_algorithm_kernels<short>() && check_algorithm_kernels<int>()
+	  && check_algorithm_kernels<long long>() && check_algorithm_kernels<float>() && check_algorithm_kernels<double>();
+	cout << "各级内核结果一致: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 浮点：+0 == -0，NaN 不等于任何值
+	double d[] = { 1.0, -0.0, 2.0, 0.0, 3.0 };
+	d[3] = std::numeric_limits<double>::quiet_NaN();
+	cout << "find(0.0) 下标: " << lzstl::find(d, d + 5, 0.0) - d << ", count(NaN): "
+	     << lzstl::count(d, d + 5, d[3]) << endl; // 1 0
+	
+	// 通用路径：std::list（双向迭代器）
+	std::list<int> l1 = { 3, 1, 4, 1, 5 }, l2 = { 3, 1, 4, 2, 5 };
+	cout << "list: find(4) 距离 " << std::distance(l1.begin(), lzstl::find(l1.begin(), l1.end(), 4))
+	     << ", count(1) " << lzstl::count(l1.begin(), l1.end(), 1)
+	     << ", max " << *lzstl::max_element(l1.begin(), l1.end())
+	     << ", equal " << lzstl::equal(l1.begin(), l1.end(), l2.begin())
+	     << ", l1<l2 " << lzstl::lexicographical_compare(l1.begin(), l1.end(), l2.begin(), l2.end()) << endl; // 2 2 5 0 1
+	
+	// copy / fill
+	lzstl::vector<int> src(1000), dst(1000);
+	for (int i = 0; i < 1000; ++i) src[i] = i;
+	lzstl::copy(src.begin(), src.end(), dst.begin());
+	ok = lzstl::equal(src.begin(), src.end(), dst.begin());
+	lzstl::copy(dst.begin() + 1, dst.end(), dst.begin());		// 重叠，向前搬
+	ok = ok && dst[0] == 1 && dst[998] == 999;
+	lzstl::fill(dst.begin(), dst.end(), 9);
+	ok = ok && lzstl::count(dst.begin(), dst.end(), 9) == 1000;
+	ok = ok && lzstl::fill_n(dst.begin(), 10, 0) == dst.begin() + 10 && dst[9] == 0 && dst[10] == 9;
+	std::list<std::string> names(3);
+	lzstl::fill(names.begin(), names.end(), std::string("ab"));
+	std::vector<std::string> copied(3);
+	lzstl::copy(names.begin(), names.end(), copied.begin());
+	ok = ok && copied[2] == "ab";
+	cout << "copy / fill 正确: " << (ok ? "是" : "否") << endl; // 是
+}
+
+void test_thread_pool()
+{
+	cout << "\n=== 测试 thread_pool.h ===" << endl;
+	lzstl::thread_pool pool(3);
+	
+	// parallel_for：每个块恰好执行一次
+	std::vector<int> hits(1000, 0);
+	pool.parallel_for(hits.size(), [&](size_t i) { hits[i]++; });
+	pool.parallel_for(hits.size(), [&](size_t i) { hits[i]++; });
+	cout << "parallel_for 每块执行次数正确: " << (std::count(hits.begin(), hits.end(), 2) == 1000 ? "是" : "否") << endl; // 是
+	
+	// 并行 uninitialized_fill_n / copy / move：阈值调小，强制切块
+	size_t old = lzstl::parallel_uninitialized_threshold();
+	lzstl::set_parallel_uninitialized_threshold(4096);
+	const size_t n = 100003;
+	long long* a = static_cast<long long*>(lzstl::alloc::allocate(n * sizeof(long long)));
+	long long* b = static_cast<long long*>(lzstl::alloc::allocate(n * sizeof(long long)));
+	unsigned long before = pool.dispatched();
+	lzstl::parallel_uninitialized_fill_n(a, n, 77LL, pool);
+	bool ok = std::count(a, a + n, 77LL) == (ptrdiff_t)n;
+	for (size_t i = 0; i < n; ++i) a[i] = (long long)i;
+	lzstl::parallel_uninitialized_copy(a, a + n, b, pool);
+	ok = ok && std::equal(a, a + n, b);
+	lzstl::parallel_uninitialized_fill(b, b + n, 5, pool);
+	lzstl::parallel_uninitialized_move(b, b + n, a, pool);
+	ok = ok && std::count(a, a + n, 5LL) == (ptrdiff_t)n;
+	unsigned long above = pool.dispatched() - before;
+	lzstl::parallel_uninitialized_fill_n(a, 16, 1LL, pool);		// 低于阈值：不分发
+	unsigned long below = pool.dispatched() - before - above;
+	lzstl::set_parallel_uninitialized_threshold(old);
+	lzstl::alloc::deallocate(a, n * sizeof(long long));
+	lzstl::alloc::deallocate(b, n * sizeof(long long));
+	cout << "并行填充/复制/移动正确: " << (ok ? "是" : "否") << endl; // 是
+	cout << "分发到线程池的次数 超过阈值: " << above << "，低于阈值: " << below << endl; // 4，0
+	
+	// 非 POD 退回串行版本
+	std::string* s = static_cast<std::string*>(lzstl::alloc::allocate(10 * sizeof(std::string)));
+	lzstl::parallel_uninitialized_fill_n(s, 10, std::string("abc"), pool);
+	cout << "非POD 并行填充: " << s[9] << endl; // abc
+	lzstl::destroy(s, s + 10);
+	lzstl::alloc::deallocate(s, 10 * sizeof(std::string));
+}
+
+void test_deque()
+{
+	cout << "\n=== 测试 deque.h ===" << endl;
+	
+	// 两端 push/pop，跨越多个块（int 每块 128 个）
+	lzstl::deque<int> d;
+	for (int i = 0; i < 1000; ++i) d.push_back(i);
+	for (int i = 1; i <= 1000; ++i) d.push_front(-i);
+	bool ok = d.size() == 2000 && d.front() == -1000 && d.back() == 999;
+	for (int i = 0; i < 2000; ++i) ok = ok && d[i] == i - 1000;
+	cout << "两端插入后顺序正确: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 随机访问迭代器：差值、+=、比较、iterator_traits
+	lzstl::deque<int>::iterator it = d.begin();
+	it += 1500;
+	ok = *it == 500 && it - d.begin() == 1500 && d.end() - it == 500 && *(it - 1300) == -800
+	     && it[-1] == 499 && d.begin() < it && it <= d.end() - 500;
+	lzstl::deque<int>::const_iterator cit = it;
+	ok = ok && lzstl::distance(cit, static_cast<const lzstl::deque<int>&>(d).end()) == 500
+	     && typeid(lzstl::iterator_traits<lzstl::deque<int>::iterator>::iterator_category) == typeid(lzstl::random_access_iterator_tag);
+	cout << "随机访问迭代器正确: " << (ok ? "是" : "否") << endl; // 是
+	cout << "find(777) 下标: " << lzstl::find(d.begin(), d.end(), 777) - d.begin() << endl; // 1777
+	
+	for (int i = 0; i < 1000; ++i) d.pop_front();
+	for (int i = 0; i < 500; ++i) d.pop_back();
+	cout << "两端弹出后: size " << d.size() << ", front " << d.front() << ", back " << d.back() << endl; // 500 0 499
+	
+	// 中间插入/删除：前半段和后半段
+	d.insert(d.begin() + 10, -1);
+	d.insert(d.begin() + 400, -2);
+	ok = d.size() == 502 && d[10] == -1 && d[11] == 10 && d[400] == -2 && d[401] == 399;
+	d.erase(d.begin() + 400);
+	d.erase(d.begin() + 10);
+	for (int i = 0; i < 500; ++i) ok = ok && d[i] == i;
+	d.erase(d.begin() + 5, d.begin() + 205);			// 前段较短
+	d.erase(d.begin() + 200, d.begin() + 250);		// 后段较短
+	ok = ok && d.size() == 250 && d[4] == 4 && d[5] == 205 && d[199] == 399 && d[200] == 450 && d.back() == 499;
+	cout << "中间插入/删除正确: " << (ok ? "是" : "否") << endl; // 是
+	
+	// resize / 复制 / 移动 / 清空
+	d.resize(300, 7);
+	lzstl::deque<int> d2(d);
+	d.resize(3);
+	lzstl::deque<int> d3(std::move(d2));
+	ok = d.size() == 3 && d2.empty() && d3.size() == 300 && d3[250] == 7 && d3[249] == 499;
+	d2 = d3;
+	d3.clear();
+	ok = ok && d2.size() == 300 && d3.empty();
+	d3.push_back(1);
+	ok = ok && d3.size() == 1 && d3.front() == 1;
+	lzstl::deque<int> d4(10, 3), d5(d2.begin(), d2.begin() + 5);
+	std::list<int> l = { 1, 2, 3 };
+	lzstl::deque<int> d6(l.begin(), l.end());
+	ok = ok && d4.size() == 10 && d4[9] == 3 && d5[4] == 4 && d6.back() == 3;
+	cout << "resize/复制/移动正确: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 非 POD 与只能移动的元素
+	lzstl::deque<std::string> ds(3, std::string("ab"));
+	ds.push_front("x");
+	ds.insert(ds.begin() + 2, "y");
+	cout << "string 元素: " << ds[0] << ds[1] << ds[2] << ds[3] << ds[4] << endl; // xabyabab
+	ds.erase(ds.begin() + 1, ds.begin() + 1);
+	ds.erase(ds.end(), ds.end());
+	cout << "空区间 erase 后: " << ds.size() << " " << ds[0] << ds[1] << ds[2] << ds[3] << ds[4] << endl; // 5 xabyabab
+	lzstl::deque<std::unique_ptr<int>> dp;
+	for (int i = 0; i < 300; ++i) dp.emplace_back(new int(i));
+	dp.erase(dp.begin() + 100);
+	dp.emplace(dp.begin() + 100, new int(-1));
+	cout << "unique_ptr 元素: " << *dp[99] << " " << *dp[100] << " " << *dp[101] << endl; // 99 -1 101
+	
+	// 构造时抛异常：已构造的元素析构，内存归还
+	try { lzstl::deque<Thrower> dt(5); } catch (int) {}
+	cout << "deque 构造异常后存活对象数: " << Thrower::alive << endl; // 0
+	
+	// 队列负载：队尾进、队头出，块在空闲块栈里循环使用
+	lzstl::deque<int> q;
+	long long sum = 0;
+	for (int i = 0; i < 100000; ++i)
+	{
+		q.push_back(i);
+		if (q.size() > 300) { sum += q.front(); q.pop_front(); }
+	}
+	while (!q.empty()) { sum += q.front(); q.pop_front(); }
+	cout << "队列负载求和: " << sum << endl; // 4999950000
+}
+
+void test_list()
+{
+	cout << "\n=== 测试 list.h ===" << endl;
+	
+	// allocate_batch：一次取一批同规格的块，每块可单独归还
+	int nobjs = 8;
+	void* chain = lzstl::alloc::allocate_batch(24, nobjs);
+	int got = 0;
+	while (chain)
+	{
+		void* next = *static_cast<void**>(chain);
+		lzstl::alloc::deallocate(chain, 24);
+		chain = next;
+		++got;
+	}
+	cout << "allocate_batch 取到块数: " << got << " / " << nobjs << endl; // 8 / 8
+	
+	// 双向迭代器：advance/distance 走逐步移动的版本
+	lzstl::list<int> l;
+	for (int i = 0; i < 10; ++i) l.push_back(i);
+	for (int i = 1; i <= 3; ++i) l.push_front(-i);
+	lzstl::list<int>::iterator it = l.begin();
+	lzstl::advance(it, 5);
+	cout << "advance(5): " << *it << ", distance: " << lzstl::distance(l.begin(), l.end())
+	     << ", 双向迭代器: " << (typeid(lzstl::iterator_traits<lzstl::list<int>::iterator>::iterator_category)
+	                             == typeid(lzstl::bidirectional_iterator_tag) ? "是" : "否") << endl; // 2 13 是
+	lzstl::advance(it, -2);
+	l.insert(it, 100);
+	l.erase(l.begin());
+	l.pop_back();
+	l.pop_front();
+	cout << "插入/删除后: ";
+	for (int x : l) cout << x << " ";
+	cout << "(size " << l.size() << ")" << endl; // -1 100 0 1 2 3 4 5 6 7 8 (size 11)
+	
+	// 删除的节点进入缓存，下一次插入直接复用
+	int* old_addr = &l.back();
+	l.pop_back();
+	l.push_back(8);
+	cout << "pop_back 后 push_back 复用节点: " << (&l.back() == old_addr ? "是" : "否") << endl; // 是
+	
+	// splice：整个 list、单个节点、区间
+	lzstl::list<int> a(3, 7), b;
+	for (int i = 0; i < 5; ++i) b.push_back(i);
+	int* b_first = &b.front();
+	a.splice(a.begin(), b);
+	bool ok = a.size() == 8 && b.empty() && &a.front() == b_first;		// 节点本身被搬走，不复制
+	b.splice(b.end(), a, a.begin());
+	lzstl::list<int>::iterator first = a.begin(), last = a.begin();
+	lzstl::advance(last, 3);
+	b.splice(b.begin(), a, first, last);
+	ok = ok && a.size() == 4 && b.size() == 4 && b.front() == 1 && b.back() == 0;
+	a.splice(a.end(), a, a.begin());		// 同一个 list 内搬移
+	ok = ok && a.size() == 4 && a.front() == 7 && a.back() == 4;
+	cout << "splice 正确: " << (ok ? "是" : "否") << endl; // 是
+	
+	// sort 稳定，merge 只搬节点
+	std::vector<std::pair<int, int>> ref;
+	lzstl::list<std::pair<int, int>> ps;
+	for (int i = 0; i < 1000; ++i) { ps.push_back(std::make_pair((i * 7919) % 31, i)); ref.push_back(ps.back()); }
+	auto by_key = [](const std::pair<int, int>& x, const std::pair<int, int>& y) { return x.first < y.first; };
+	ps.sort(by_key);
+	std::stable_sort(ref.begin(), ref.end(), by_key);
+	cout << "sort 稳定且与 std::stable_sort 一致: " << (std::equal(ref.begin(), ref.end(), ps.begin()) ? "是" : "否") << endl; // 是
+	lzstl::list<int> m1, m2;
+	for (int i = 0; i < 10; i += 2) m1.push_back(i);
+	for (int i = 1; i < 12; i += 3) m2.push_back(i);
+	m1.merge(m2);
+	cout << "merge: ";
+	for (int x : m1) cout << x << " ";
+	cout << "(m2 size " << m2.size() << ")" << endl; // 0 1 2 4 4 6 7 8 10 (m2 size 0)
+	
+	// unique / remove / remove_if / reverse
+	m1.unique();
+	m1.remove(6);
+	m1.remove_if([](int x) { return x > 8; });
+	m1.reverse();
+	cout << "unique/remove/reverse: ";
+	for (int x : m1) cout << x << " ";
+	cout << endl; // 8 7 4 2 1 0
+	
+	// 复制 / 移动 / 交换 / resize，字符串元素
+	lzstl::list<std::string> s1(2, std::string("ab")), s2;
+	s1.push_back("cd");
+	s2 = s1;
+	s2.front() = "x";
+	lzstl::list<std::string> s3(std::move(s1));
+	s3.resize(5, "e");
+	lzstl::swap(s2, s3);
+	cout << "string 元素: " << s1.size() << " " << s2.size() << " " << s2.back() << " " << s3.front() << endl; // 0 5 e x
+	
+	// 只能移动的元素
+	lzstl::list<std::unique_ptr<int>> lp;
+	for (int i = 0; i < 5; ++i) lp.emplace_back(new int(i));
+	lp.sort([](const std::unique_ptr<int>& x, const std::unique_ptr<int>& y) { return *x > *y; });
+	cout << "unique_ptr 降序: " << *lp.front() << " " << *lp.back() << endl; // 4 0
+	
+	// 构造时抛异常：已构造的节点全部删除
+	try { lzstl::list<Thrower> lt(5); } catch (int) {}
+	cout << "list 构造异常后存活对象数: " << Thrower::alive << endl; // 0
+}
+
+// 所有键的哈希值都相同：探测必须跨组走下去
+struct same_hash
+{
+	size_t operator()(int) const { return 42; }
+};
+
+void test_flat_hash_map()
+{
+	cout << "\n=== 测试 flat_hash_map.h ===" << endl;
+	
+	// 随机插入/查找/删除，与 std::unordered_map 对照
+	lzstl::flat_hash_map<int, int> m;
+	std::unordered_map<int, int> ref;
+	unsigned x = 1;
+	bool ok = true;
+	for (int i = 0; i < 200000; ++i)
+	{
+		x = x * 1103515245u + 12345u;
+		int k = int((x >> 8) % 5000), op = int(x >> 28);
+		if (op < 8) { m[k] += i; ref[k] += i; }
+		else if (op < 12) ok = ok && m.erase(k) == ref.erase(k);
+		else ok = ok && m.count(k) == ref.count(k) && (m.find(k) == m.end() || m.find(k)->second == ref[k]);
+	}
+	size_t visited = 0;
+	for (auto& kv : m) { ++visited; ok = ok && ref.count(kv.first) && ref[kv.first] == kv.second; }
+	ok = ok && visited == ref.size() && m.size() == ref.size();
+	cout << "随机操作与 std::unordered_map 一致: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 反复插入删除不会无限增长：墓碑被回收或原容量重建
+	lzstl::flat_hash_set<int> s;
+	s.reserve(100);
+	size_t cap = s.capacity();
+	for (int i = 0; i < 100000; ++i) { s.insert(i); if (i >= 50) s.erase(i - 50); }
+	cout << "滑动窗口后 size " << s.size() << ", 容量不变: " << (s.capacity() == cap ? "是" : "否") << endl; // 50 是
+	
+	// reserve 之后插入不 rehash；rehash(0) 收缩
+	lzstl::flat_hash_set<int> r;
+	r.reserve(1000);
+	cap = r.capacity();
+	for (int i = 0; i < 1000; ++i) r.insert(i * 7);
+	ok = r.capacity() == cap && r.size() == 1000;
+	for (int i = 0; i < 990; ++i) r.erase(i * 7);
+	r.rehash(0);
+	ok = ok && r.capacity() == 15 && r.size() == 10 && r.count(993 * 7) && !r.count(7);
+	cout << "reserve / rehash 正确: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 哈希全部冲突时仍然正确
+	lzstl::flat_hash_set<int, same_hash> c;
+	for (int i = 0; i < 300; ++i) c.insert(i);
+	for (int i = 0; i < 300; i += 2) c.erase(i);
+	ok = c.size() == 150;
+	for (int i = 0; i < 300; ++i) ok = ok && c.count(i) == size_t(i % 2);
+	cout << "全部冲突时查找正确: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 字符串键、只能移动的值、复制/移动/交换
+	lzstl::flat_hash_map<std::string, std::unique_ptr<int>> u;
+	for (int i = 0; i < 100; ++i) u.try_emplace(std::to_string(i), new int(i));
+	std::pair<lzstl::flat_hash_map<std::string, std::unique_ptr<int>>::iterator, bool> res = u.try_emplace("42", std::unique_ptr<int>(new int(0)));
+	cout << "try_emplace 已存在: " << res.second << " " << *res.first->second << ", emplace 新键: "
+	     << u.emplace("x", std::unique_ptr<int>(new int(7))).second << endl; // 0 42 1
+	lzstl::flat_hash_map<std::string, int> a;
+	a.insert(std::make_pair(std::string("one"), 1));
+	a["two"] = 2;
+	lzstl::flat_hash_map<std::string, int> b(a), d(std::move(a));
+	b["three"] = 3;
+	lzstl::swap(b, d);
+	cout << "复制/移动/交换: " << a.size() << " " << b.size() << " " << d.size() << " " << d["three"] << endl; // 0 2 3 3
+	
+	// 迭代器遍历时删除
+	lzstl::flat_hash_set<int> e;
+	for (int i = 0; i < 1000; ++i) e.insert(i);
+	for (auto it = e.begin(); it != e.end();)
+		it = (*it % 3 == 0) ? e.erase(it) : ++it;
+	cout << "遍历中删除后 size: " << e.size() << endl; // 666
+}
+
+// SIMD lower_bound 与 std::lower_bound 在各种长度、各种键上一致
+template <typename T>
+bool check_flat_lower_bound()
+{
+	for (size_t n = 0; n < 700; n += (n < 140 ? 1 : 37))
+	{
+		if (double(n / 3 * 2 + 2) > double(std::numeric_limits<T>::max())) break;		// 保持有序，不能回绕
+		std::vector<T> v(n);
+		for (size_t i = 0; i < n; ++i) v[i] = T(i / 3 * 2);		// 有重复、有空隙
+		for (long long k = -2; k <= (long long)(n / 3 * 2) + 2; ++k)
+		{
+			const T* p = v.data();
+			T key = T(k);
+			if (k < 0 && std::is_unsigned<T>::value) continue;
+			size_t expect = std::lower_bound(p, p + n, key) - p;
+			if (lzstl::__simd_lower_bound(p, n, key) - p != (ptrdiff_t)expect) return false;
+			if (lzstl::__branchless_lower_bound(p, n, key, std::less<T>()) - p != (ptrdiff_t)expect) return false;
+			if (lzstl::__branchless_upper_bound(p, n, key, std::less<T>()) - p != std::upper_bound(p, p + n, key) - p) return false;
+		}
+	}
+	return true;
+}
+
+void test_flat_map()
+{
+	cout << "\n=== 测试 flat_map.h ===" << endl;
+	bool ok = check_flat_lower_bound<int>() && check_flat_lower_bound<unsigned>() && check_flat_lower_bound<short>()
+	       && check_flat_lower_bound<unsigned char>() && check_flat_lower_bound<long long>() && check_flat_lower_bound<double>();
+	cout << "lower_bound / upper_bound 与 std 一致: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 随机操作与 std::map 对照
+	lzstl::flat_map<int, int> m;
+	std::map<int, int> ref;
+	unsigned x = 7;
+	ok = true;
+	for (int i = 0; i < 20000; ++i)
+	{
+		x = x * 1103515245u + 12345u;
+		int k = int((x >> 8) % 3000), op = int(x >> 28);
+		if (op < 8) { m[k] += i; ref[k] += i; }
+		else if (op < 11) ok = ok && m.erase(k) == ref.erase(k);
+		else ok = ok && m.count(k) == ref.count(k) && (m.find(k) == m.end() || m.find(k)->second == ref[k]);
+	}
+	ok = ok && m.size() == ref.size() && std::equal(ref.begin(), ref.end(), m.begin(),
+	          [](const std::pair<const int, int>& a, std::pair<const int&, const int&> b) { return a.first == b.first && a.second == b.second; });
+	cout << "随机操作与 std::map 一致: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 批量插入：批内重复、与已有键重复时都保留先到的
+	lzstl::flat_set<int> s;
+	s.insert(5);
+	s.insert(1);
+	std::vector<int> batch = { 9, 3, 5, 3, 7, 1, 8 };
+	s.insert(batch.begin(), batch.end());
+	cout << "flat_set 批量插入: ";
+	for (int k : s) cout << k << " ";
+	cout << endl; // 1 3 5 7 8 9
+	lzstl::flat_map<std::string, int> fm;
+	fm["b"] = 1;
+	std::vector<std::pair<std::string, int>> kv = { {"d", 4}, {"a", 2}, {"b", 100}, {"a", 3}, {"c", 5} };
+	fm.insert(kv.begin(), kv.end());
+	cout << "flat_map 批量插入: ";
+	for (auto it = fm.begin(); it != fm.end(); ++it) cout << it->first << "=" << (*it).second << " ";
+	cout << endl; // a=2 b=1 c=5 d=4
+	
+	// lower_bound / upper_bound / equal_range / erase 区间
+	lzstl::flat_set<double> ds;
+	for (int i = 0; i < 100; ++i) ds.insert(i * 0.5);
+	std::pair<const double*, const double*> r = ds.equal_range(10.0);
+	ok = *ds.lower_bound(10.2) == 10.5 && *ds.upper_bound(10.0) == 10.5 && r.second - r.first == 1;
+	ds.erase(ds.lower_bound(10.0), ds.lower_bound(20.0));
+	ok = ok && ds.size() == 80 && !ds.count(15.0) && ds.count(20.0);
+	cout << "有序查找与区间删除: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 自定义比较器（走通用的无分支二分）、只能移动的值、迭代器改值
+	lzstl::flat_map<int, std::unique_ptr<int>, std::greater<int>> g;
+	for (int i = 0; i < 10; ++i) g.try_emplace(i, new int(i * i));
+	g.begin()->second.reset(new int(-1));
+	cout << "greater 比较器: 首键 " << g.begin()->first << ", 值 " << *g.begin()->second
+	     << ", find(3) " << *g.find(3)->second << endl; // 9 -1 9
+	
+	// 复制 / 移动 / 交换
+	lzstl::flat_map<int, int> m2(m), m3(std::move(m));
+	m2[-1] = 1;
+	lzstl::swap(m2, m3);
+	cout << "复制/移动/交换: " << (m3.size() == m2.size() + 1 && m3.count(-1) && !m2.count(-1) ? "是" : "否") << endl; // 是
+	
+	// iterator 隐式转换为 const_iterator，迭代器自身的拷贝仍是平凡的
+	lzstl::flat_map<int, int>::const_iterator ci = m3.find(-1);
+	ok = ci != m3.end() && ci->second == 1 && std::is_trivially_copyable<lzstl::flat_map<int, int>::iterator>::value;
+	cout << "iterator 转 const_iterator: " << (ok ? "是" : "否") << endl; // 是
+}
+
+// 正向、反向遍历都与 ref 一致
+template <typename Tree, typename Ref>
+bool check_btree_order(const Tree& t, const Ref& ref)
+{
+	if (t.size() != ref.size() || !std::equal(ref.begin(), ref.end(), t.begin()))
+		return false;
+	typename Tree::const_iterator it = t.end();
+	for (typename Ref::const_reverse_iterator r = ref.rbegin(); r != ref.rend(); ++r)
+		if (!(*--it == *r))
+			return false;
+	return it == t.begin();
+}
+
+void test_btree()
+{
+	cout << "\n=== 测试 btree.h ===" << endl;
+	// 随机插入/删除与 std::map 对照，键的范围小，合并/旋转/根节点收缩都会频繁发生
+	lzstl::btree_map<int, int> m;
+	std::map<int, int> ref;
+	unsigned x = 11;
+	bool ok = true;
+	for (int i = 0; i < 200000; ++i)
+	{
+		x = x * 1103515245u + 12345u;
+		int k = int((x >> 8) % 5000), op = int(x >> 28);
+		if (op < 7) { m[k] += i; ref[k] += i; }
+		else if (op < 12) ok = ok && m.erase(k) == ref.erase(k);
+		else ok = ok && m.count(k) == ref.count(k) && (m.find(k) == m.end() || m.find(k)->second == ref[k]);
+		if (i % 20000 == 0) ok = ok && check_btree_order(m, ref);
+	}
+	ok = ok && check_btree_order(m, ref);
+	cout << "随机操作与 std::map 一致: " << (ok ? "是" : "否") << endl; // 是
+	
+	// erase(pos) 返回下一个元素：隔一个删一个，剩下奇数
+	lzstl::btree_set<int> s;
+	for (int i = 0; i < 10000; ++i) s.insert((i * 7919) % 10000);
+	ok = true;
+	for (lzstl::btree_set<int>::iterator it = s.begin(); it != s.end(); )
+	{
+		ok = ok && *it % 2 == 0;
+		it = s.erase(it);
+		if (it != s.end()) ++it;
+	}
+	ok = ok && s.size() == 5000 && *s.begin() == 1 && *--s.end() == 9999 && !s.count(5000) && s.count(4999);
+	cout << "erase 返回后继: " << (ok ? "是" : "否") << endl; // 是
+	
+	// lower_bound / upper_bound / equal_range / erase 区间
+	ok = *s.lower_bound(100) == 101 && *s.upper_bound(101) == 103 && s.lower_bound(10000) == s.end();
+	std::pair<lzstl::btree_set<int>::iterator, lzstl::btree_set<int>::iterator> r = s.equal_range(201);
+	ok = ok && *r.first == 201 && *r.second == 203 && s.equal_range(202).first == s.equal_range(202).second;
+	s.erase(s.lower_bound(1000), s.lower_bound(9000));
+	std::set<int> sref;
+	for (int i = 1; i < 1000; i += 2) sref.insert(i);
+	for (int i = 9001; i < 10000; i += 2) sref.insert(i);
+	ok = ok && check_btree_order(s, sref);
+	cout << "有序查找与区间删除: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 有序输入批量插入：节点全满。set<int> 一个节点 60 个键，两层最多 61*61-1 = 3720 个
+	std::vector<int> sorted;
+	for (int i = 0; i < 3720; ++i) sorted.push_back(i * 2);
+	lzstl::btree_set<int> bulk(sorted.begin(), sorted.end()), one;
+	for (int k : sorted) one.insert(k);
+	cout << "3720 个有序键，批量插入树高 " << bulk.height() << ", 逐个插入树高 " << one.height() << endl; // 2 3
+	sorted.push_back(100000);
+	std::vector<int> tail = { 7441, 7443, 7445 };
+	bulk.insert(sorted.begin(), sorted.end());		// 只追加了一个
+	bulk.insert(tail.begin(), tail.end());
+	bulk.insert(7);
+	ok = bulk.size() == 3725 && check_btree_order(bulk, std::set<int>(bulk.begin(), bulk.end()));
+	for (int i = 0; i < 3720 && ok; ++i) ok = bulk.count(i * 2) && !bulk.count(i * 2 + 1) == (i != 3);
+	cout << "批量追加后再插入/查找: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 非平凡的槽（string）、只能移动的值、自定义比较器
+	lzstl::btree_map<std::string, std::string> sm;
+	for (int i = 0; i < 3000; ++i) sm.try_emplace(std::to_string(i * 37 % 3000), std::string(i * 37 % 3000 % 40, 'x'));
+	for (int i = 0; i < 3000; i += 3) sm.erase(std::to_string(i));
+	ok = sm.size() == 2000;
+	for (int k = 1; k < 3000 && ok; k += 3) ok = sm.find(std::to_string(k))->second.size() == size_t(k % 40);
+	lzstl::btree_map<int, std::unique_ptr<int>, std::greater<int>> g;
+	for (int i = 0; i < 500; ++i) g.try_emplace(i, new int(i * i));
+	g.begin()->second.reset(new int(-1));
+	for (int i = 0; i < 500; i += 2) g.erase(i);
+	cout << "string 槽: " << (ok ? "是" : "否") << ", greater 比较器: 首键 " << g.begin()->first << ", 值 " << *g.begin()->second
+	     << ", find(3) " << *g.find(3)->second << endl; // 是 499 -1 9
+	
+	// 复制（按序追加，节点全满）/ 移动 / 交换
+	lzstl::btree_map<int, int> m2(m), m3(std::move(m));
+	m2[-1] = 1;
+	lzstl::swap(m2, m3);
+	ok = m3.size() == m2.size() + 1 && m3.count(-1) && !m2.count(-1) && check_btree_order(m2, ref) && m.empty();
+	m2.clear();
+	ok = ok && m2.empty() && m2.begin() == m2.end() && m2.height() == 0;
+	cout << "复制/移动/交换/清空: " << (ok ? "是" : "否") << endl; // 是
+}
+
+// 移动构造不抛异常；移动赋值在 fail_after 减到 0 时抛异常（-1 表示从不抛）
+struct flaky_assign
+{
+	static int fail_after;
+	int v;
+	explicit flaky_assign(int x) : v(x) {}
+	flaky_assign(flaky_assign&& other) noexcept : v(other.v) {}
+	flaky_assign& operator=(flaky_assign&& other)
+	{
+		if (fail_after == 0) throw 1;
+		if (fail_after > 0) --fail_after;
+		v = other.v;
+		return *this;
+	}
+};
+int flaky_assign::fail_after = -1;
+
+void test_spsc_ring()
+{
+	cout << "\n=== 测试 spsc_ring.h ===" << endl;
+	// 容量取 2 的幂；满了 try_push 失败，空了 try_pop 失败
+	lzstl::spsc_ring<int> r(5);
+	int v = 0;
+	bool ok = r.capacity() == 8 && !r.try_pop(v);
+	for (int i = 0; i < 8; ++i) ok = ok && r.try_push(i);
+	ok = ok && !r.try_push(8) && r.size() == 8 && r.try_pop(v) && v == 0 && r.try_push(8);
+	cout << "容量 " << r.capacity() << ", 满/空判断: " << (ok ? "是" : "否") << endl; // 8 是
+	cout << "按 cache line 对齐: " << (alignof(lzstl::spsc_ring<int>) == 64 && reinterpret_cast<uintptr_t>(&r) % 64 == 0 ? "是" : "否") << endl; // 是
+	
+	// push_n / pop_n 跨过环绕点：分两段 memcpy
+	int out[16];
+	size_t got = r.pop_n(out, 16);
+	int in[6] = { 10, 11, 12, 13, 14, 15 };
+	ok = got == 8 && out[0] == 1 && out[7] == 8 && r.push_n(in, 6) == 6 && r.push_n(in, 6) == 2;
+	got = r.pop_n(out, 16);
+	ok = ok && got == 8 && out[5] == 15 && out[6] == 10 && out[7] == 11 && r.empty();
+	cout << "批量读写跨环绕点: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 非平凡类型：front/pop 原地读取，析构时销毁剩余元素
+	std::shared_ptr<int> p = std::make_shared<int>(7);
+	{
+		lzstl::spsc_ring<std::shared_ptr<int>> sr(4);
+		std::shared_ptr<int> batch[3] = { p, p, p };
+		sr.try_push(p);
+		sr.push_n(batch, 3);
+		ok = *sr.front() == p && p.use_count() == 8;
+		sr.pop();
+		std::shared_ptr<int> q;
+		ok = ok && sr.try_pop(q) && q == p && p.use_count() == 7;
+		std::string s;
+		lzstl::spsc_ring<std::string> ss(2);
+		ss.try_emplace(3, 'z');
+		ok = ok && ss.try_pop(s) && s == "zzz";
+	}
+	cout << "非平凡类型与析构: " << (ok && p.use_count() == 1 ? "是" : "否") << endl; // 是
+	
+	// pop_n 中途移动赋值抛异常：已取走的出队，抛异常的那个留在队首
+	lzstl::spsc_ring<flaky_assign> fr(4);
+	for (int i = 1; i <= 3; ++i) fr.try_push(flaky_assign(i));
+	flaky_assign fout[3] = { flaky_assign(0), flaky_assign(0), flaky_assign(0) };
+	flaky_assign::fail_after = 1;
+	try { fr.pop_n(fout, 3); } catch (int) {}
+	flaky_assign::fail_after = -1;
+	ok = fout[0].v == 1 && fr.size() == 2 && fr.pop_n(fout, 3) == 2 && fout[0].v == 2 && fout[1].v == 3;
+	cout << "pop_n 异常后队列状态: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 两个线程交接：顺序不变、一个不丢
+	lzstl::spsc_ring<unsigned> q(64);
+	const unsigned total = 200000;
+	std::thread producer([&]() {
+		unsigned buf[16];
+		for (unsigned i = 0; i < total; )
+		{
+			if (i % 3 == 0)
+			{
+				unsigned n = 0;
+				for (; n < 16 && i + n < total; ++n) buf[n] = i + n;
+				i += unsigned(q.push_n(buf, n));
+			}
+			else if (q.try_push(i))
+				++i;
+			else
+				std::this_thread::yield();
+		}
+	});
+	unsigned expect = 0;
+	ok = true;
+	while (expect < total)
+	{
+		unsigned buf[32];
+		size_t n = expect % 2 ? q.pop_n(buf, 32) : q.try_pop(buf[0]);
+		for (size_t i = 0; i < n; ++i) ok = ok && buf[i] == expect++;
+		if (n == 0) std::this_thread::yield();
+	}
+	producer.join();
+	cout << "双线程交接 " << total << " 个元素，顺序正确: " << (ok && q.empty() ? "是" : "否") << endl; // 是
+}
+
+void test_mpmc_queue()
+{
+	cout << "\n=== 测试 mpmc_queue.h ===" << endl;
+	// 单线程：容量取 2 的幂，先进先出，多轮环绕后序号仍然正确
+	lzstl::mpmc_queue<int> q(3);
+	int v = 0;
+	bool ok = q.capacity() == 4 && !q.try_pop(v);
+	for (int round = 0; round < 5 && ok; ++round)
+	{
+		for (int i = 0; i < 4; ++i) ok = ok && q.try_push(round * 10 + i);
+		ok = ok && !q.try_push(-1) && q.size() == 4;
+		for (int i = 0; i < 4; ++i) ok = ok && q.try_pop(v) && v == round * 10 + i;
+		ok = ok && !q.try_pop(v) && q.empty();
+	}
+	cout << "容量 " << q.capacity() << ", 先进先出/满/空: " << (ok ? "是" : "否") << endl; // 4 是
+	
+	// 非平凡类型：复制可能抛异常的走"先构造再移入"，析构时销毁剩余元素
+	std::shared_ptr<int> p = std::make_shared<int>(1);
+	{
+		lzstl::mpmc_queue<std::shared_ptr<int>> sq(4);
+		sq.try_push(p);
+		sq.try_push(p);
+		lzstl::mpmc_queue<std::string> strs(2);
+		std::string a(30, 'a'), s;
+		ok = strs.try_push(a) && strs.try_emplace(3, 'b') && !strs.try_push(a) && strs.try_pop(s) && s == a
+		     && strs.try_pop(s) && s == "bbb" && p.use_count() == 3;
+	}
+	cout << "非平凡类型与析构: " << (ok && p.use_count() == 1 ? "是" : "否") << endl; // 是
+	
+	// 队列满时 try_push(右值) 失败不移走参数；取出时赋值抛异常，槽照样还回去
+	{
+		lzstl::mpmc_queue<std::string> strs(2);
+		std::string x(30, 'x');
+		ok = strs.try_push(x) && strs.try_push(x) && !strs.try_push(std::move(x)) && x.size() == 30;
+		std::string y;
+		strs.pop(y);
+		strs.push(y);		// 复制可能抛异常：槽外复制一次再移入
+		ok = ok && strs.size() == 2;
+		lzstl::mpmc_queue<flaky_assign> fq(2);
+		flaky_assign out(0);
+		fq.try_push(flaky_assign(1));
+		fq.try_push(flaky_assign(2));
+		flaky_assign::fail_after = 0;
+		try { fq.try_pop(out); ok = false; } catch (int) {}
+		flaky_assign::fail_after = -1;
+		ok = ok && fq.try_push(flaky_assign(3)) && fq.try_pop(out) && out.v == 2 && fq.try_pop(out) && out.v == 3;
+	}
+	cout << "失败的 try_push 保留参数，pop 异常后槽可复用: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 4 个生产者、4 个消费者，容量只有 8：阻塞 push/pop 会睡眠，每个值恰好被取走一次
+	lzstl::mpmc_queue<unsigned> mq(8);
+	const unsigned per = 20000, np = 4, nc = 4;
+	std::vector<std::atomic<unsigned char>> seen(per * np);
+	for (auto& f : seen) f.store(0);
+	std::vector<std::thread> threads;
+	for (unsigned t = 0; t < np; ++t)
+		threads.emplace_back([&, t]() {
+			for (unsigned i = 0; i < per; ++i)
+			{
+				if (i % 2) mq.push(t * per + i);
+				else while (!mq.try_push(t * per + i)) std::this_thread::yield();
+			}
+		});
+	for (unsigned t = 0; t < nc; ++t)
+		threads.emplace_back([&]() {
+			unsigned x;
+			for (unsigned i = 0; i < per * np / nc; ++i)
+			{
+				mq.pop(x);
+				seen[x].fetch_add(1);
+			}
+		});
+	for (auto& th : threads) th.join();
+	ok = mq.empty();
+	for (auto& f : seen) ok = ok && f.load() == 1;
+	cout << np << " 生产者 " << nc << " 消费者，每个值恰好取走一次: " << (ok ? "是" : "否") << endl; // 是
+}
+
+void test_priority_queue()
+{
+	cout << "\n=== 测试 priority_queue.h ===" << endl;
+	// 随机 push/pop 混合，和 std::priority_queue 逐个比较堆顶；2/4/8 叉都试
+	std::priority_queue<int> ref;
+	lzstl::priority_queue<int, std::less<int>, 2> q2;
+	lzstl::priority_queue<int> q4;
+	lzstl::priority_queue<int, std::less<int>, 8> q8;
+	unsigned seed = 12345;
+	bool ok = true;
+	for (int i = 0; i < 20000 && ok; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		int v = int(seed >> 16) % 1000;
+		if (seed % 3 != 0 || ref.empty())
+		{
+			ref.push(v);
+			q2.push(v);
+			q4.push(v);
+			q8.emplace(v);
+		}
+		else
+		{
+			ok = q2.top() == ref.top() && q4.top() == ref.top() && q8.top() == ref.top();
+			ref.pop();
+			q2.pop();
+			q4.pop();
+			q8.pop();
+		}
+	}
+	ok = ok && q4.size() == ref.size();
+	cout << "2/4/8 叉与 std::priority_queue 堆顶一致: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 区间构造与 push_range：大批追加整体建堆，小批逐个上滤；弹出顺序是降序
+	std::vector<int> data;
+	for (int i = 0; i < 1000; ++i) data.push_back((i * 7919) % 1000);
+	lzstl::priority_queue<int> h(data.begin(), data.begin() + 100);
+	h.push_range(data.begin() + 100, data.begin() + 990);   // 890 > 100/2，整体建堆
+	h.push_range(data.begin() + 990, data.end());           // 10 个，逐个上滤
+	ok = h.size() == 1000;
+	for (int expect = 999; expect >= 0 && ok; --expect)
+	{
+		ok = h.top() == expect;
+		h.pop();
+	}
+	cout << "push_range 后依次弹出 999..0: " << (ok && h.empty() ? "是" : "否") << endl; // 是
+	
+	// 小顶堆上的 pop_push / replace_top：始终保留最大的 k 个
+	lzstl::priority_queue<int, std::greater<int>> topk;
+	for (int i = 0; i < 10; ++i) topk.push(data[i]);
+	for (size_t i = 10; i < data.size(); ++i)
+		if (data[i] > topk.top())
+			topk.replace_top(data[i]);
+	int smallest = topk.pop_push(2000);
+	ok = smallest == 990 && topk.top() == 991 && topk.size() == 10;
+	cout << "replace_top 求前 10 大，最小的一个: " << smallest << (ok ? " 是" : " 否") << endl; // 990 是
+	
+	// 非平凡类型
+	lzstl::priority_queue<std::string, std::less<std::string>, 3> sq;
+	const char* words[] = {"pear", "apple", "fig", "kiwi", "banana"};
+	for (const char* w : words) sq.push(std::string(w));
+	std::string order;
+	while (!sq.empty())
+	{
+		order += sq.top()[0];
+		sq.pop();
+	}
+	cout << "字符串降序首字母: " << order << endl; // pkfba
+	
+	// indexed_priority_queue：decrease_key 的 Dijkstra 与懒删除的 std::priority_queue 结果一致
+	const int n = 500;
+	std::vector<std::vector<std::pair<int, int>>> adj(n);
+	for (int u = 0; u < n; ++u)
+		for (int k = 0; k < 6; ++k)
+		{
+			seed = seed * 1103515245 + 12345;
+			adj[u].push_back(std::make_pair(int(seed >> 8) % n, int(seed >> 20) % 100 + 1));
+		}
+	const int inf = std::numeric_limits<int>::max();
+	std::vector<int> d1(n, inf), d2(n, inf);
+	lzstl::indexed_priority_queue<int, std::greater<int>> ipq(n);
+	d1[0] = 0;
+	ipq.push(0, 0);
+	size_t max_size = 0;
+	while (!ipq.empty())
+	{
+		max_size = std::max(max_size, ipq.size());
+		int u = int(ipq.top_id());
+		ipq.pop();
+		for (const auto& e : adj[u])
+			if (d1[u] + e.second < d1[e.first])
+			{
+				d1[e.first] = d1[u] + e.second;
+				ipq.push_or_decrease(e.first, d1[e.first]);
+			}
+	}
+	std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>> lazy;
+	d2[0] = 0;
+	lazy.push(std::make_pair(0, 0));
+	while (!lazy.empty())
+	{
+		std::pair<int, int> t = lazy.top();
+		lazy.pop();
+		if (t.first > d2[t.second]) continue;
+		for (const auto& e : adj[t.second])
+			if (t.first + e.second < d2[e.first])
+			{
+				d2[e.first] = t.first + e.second;
+				lazy.push(std::make_pair(d2[e.first], e.first));
+			}
+	}
+	cout << "Dijkstra decrease_key 与懒删除结果一致: " << (d1 == d2 ? "是" : "否")
+	     << ", 队列最多 " << (max_size <= size_t(n) ? "不超过顶点数" : "超过顶点数") << endl; // 是, 队列最多 不超过顶点数
+	
+	// update_key 两个方向、erase 任意编号
+	lzstl::indexed_priority_queue<int> iq;
+	for (int i = 0; i < 8; ++i) iq.push(i, i * 10);
+	iq.update_key(7, 5);     // 变差：下滤
+	iq.update_key(2, 100);   // 变好：上滤
+	iq.erase(6);
+	iq.erase(2);
+	std::string ids;
+	while (!iq.empty())
+	{
+		ids += char('0' + iq.top_id());
+		iq.pop();
+	}
+	cout << "update_key/erase 后按键弹出编号: " << ids << ", 弹空后不含 3: " << (!iq.contains(3) ? "是" : "否") << endl; // 543170, 是
+}
+
+void test_string()
+{
+	cout << "\n=== 测试 basic_string.h ===" << endl;
+	// 短串放在对象里：23 个字符以内容量都是 23，第 24 个字符才分配（容量按配置器规格取整）
+	lzstl::string s("hello");
+	lzstl::string s23(23, 'x');
+	lzstl::string s24(24, 'y');
+	cout << "sizeof: " << sizeof(lzstl::string) << ", 容量 " << s.capacity() << "/" << s23.capacity() << "/" << s24.capacity()
+	     << ", 结尾 '\\0': " << (s23.c_str()[23] == '\0' && std::strlen(s24.c_str()) == 24 ? "是" : "否") << endl; // sizeof: 24, 容量 23/23/31, 结尾 '\0': 是
+	
+	// append 一路从短串长到几千字节，和 std::string 逐步比较；自己追加自己、插入自己
+	lzstl::string a;
+	std::string ref;
+	bool ok = true;
+	for (int i = 0; i < 500 && ok; ++i)
+	{
+		char piece[8];
+		int len = std::snprintf(piece, sizeof(piece), "%d,", i);
+		a.append(piece, len);
+		ref.append(piece, len);
+		ok = a.size() == ref.size() && std::memcmp(a.data(), ref.data(), ref.size()) == 0 && a.c_str()[a.size()] == '\0';
+	}
+	lzstl::string self("abc");
+	for (int i = 0; i < 5; ++i) self.append(self);
+	self.insert(3, self.data(), 6);
+	ok = ok && self.size() == 102 && self.substr(0, 12) == "abcabcabcabc";
+	cout << "append 与 std::string 一致，追加/插入自身: " << (ok ? "是" : "否") << endl; // 是
+	
+	// find：单字符、子串、不存在、末尾、空串，和 std::string::find 对照
+	const char* needles[] = {"1,", "99,100", "499,", "500,", "", ",2", "7,8,9"};
+	ok = true;
+	for (const char* nd : needles)
+		for (size_t pos = 0; pos < ref.size() + 2; pos += 37)
+			ok = ok && a.find(nd, pos) == ref.find(nd, pos);
+	ok = ok && a.find(',') == ref.find(',') && a.find('x') == lzstl::string::npos && a.rfind('4') == ref.rfind('4');
+	cout << "find / rfind 与 std::string 一致: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 修改：erase / resize / clear，缩回短串
+	lzstl::string m("the quick brown fox jumps over the lazy dog");
+	m.erase(4, 6);
+	m.resize(9);
+	ok = m == "the brown";
+	m.shrink_to_fit();
+	ok = ok && m.capacity() == 23 && m == "the brown";
+	m += " fox";
+	m += '!';
+	cout << "erase/resize/shrink_to_fit: " << m << (ok ? " 是" : " 否") << endl; // the brown fox! 是
+	
+	// 比较与拼接
+	lzstl::string x("apple"), y("apples");
+	ok = x < y && y > x && x != y && x.compare("apple") == 0 && (x + y) == "appleapples" && (lzstl::string("a") + "b") == "ab";
+	cout << "比较与拼接: " << (ok ? "是" : "否") << endl; // 是
+	const lzstl::string ab("ab");
+	ok = ab + "c" == "abc" && "x" + ab == "xab" && ab + 'd' == "abd" && 'y' + ab == "yab" && lzstl::string("q") + 'r' == "qr"
+	     && ab < "abc" && "aa" < ab && !(ab < "ab") && "ab" == ab && "ac" != ab;
+	cout << "与 const char* / char 拼接、比较: " << (ok ? "是" : "否") << endl; // 是
+	std::hash<lzstl::string> hs;
+	cout << "哈希: 相等串相同 " << (hs(lzstl::string("hello world, long string")) == hs(lzstl::string("hello world, long string")) ? "是" : "否")
+	     << "，ab/ba 不同 " << (hs(lzstl::string("ab")) != hs(lzstl::string("ba")) ? "是" : "否") << endl; // 是 是
+	
+	// 放进 vector：扩容时移动，移动后源为空短串；做 flat_hash_map 的键
+	lzstl::vector<lzstl::string> v;
+	for (int i = 0; i < 1000; ++i)
+	{
+		char buf[64];
+		int len = std::snprintf(buf, sizeof(buf), "%0*d", 5 + i % 40, i);
+		v.push_back(lzstl::string(buf, len));
+	}
+	ok = v.size() == 1000 && v[999].size() == 5 + 999 % 40 && v[999].find("999") == v[999].size() - 3;
+	lzstl::string moved(std::move(v[10]));
+	ok = ok && v[10].empty() && v[10].capacity() == 23 && moved.size() == 15;
+	lzstl::flat_hash_map<lzstl::string, int> counts;
+	const char* words[] = {"a", "long enough to live on the heap", "a", "b", "long enough to live on the heap", "a"};
+	for (const char* w : words) ++counts[lzstl::string(w)];
+	ok = ok && counts[lzstl::string("a")] == 3 && counts[lzstl::string("long enough to live on the heap")] == 2;
+	cout << "vector<string> 扩容、移动、做哈希表的键: " << (ok ? "是" : "否") << endl; // 是
+}
+
+// 常量表达式里构造、插入、删除
+constexpr lzstl::static_vector<int, 8> make_static_squares()
+{
+	lzstl::static_vector<int, 8> v;
+	for (int i = 0; i < 6; ++i) v.push_back(i * i);     // 0 1 4 9 16 25
+	v.erase(v.begin() + 1);                              // 0 4 9 16 25
+	v.insert(v.begin(), 2, -1);                          // -1 -1 0 4 9 16 25
+	v.pop_back();                                        // -1 -1 0 4 9 16
+	return v;
+}
+
+struct static_vector_point
+{
+	int x = 1, y = 2;   // 默认构造不平凡，但可以按字节复制
+};
+
+void test_static_vector()
+{
+	cout << "\n=== 测试 static_vector.h ===" << endl;
+	// 平凡的 T：对象就是 T 数组 + 长度，平凡可复制，能在常量表达式里用
+	constexpr lzstl::static_vector<int, 8> sq = make_static_squares();
+	static_assert(sq.size() == 6 && sq[0] == -1 && sq[2] == 0 && sq.back() == 16, "constexpr static_vector");
+	cout << "sizeof(static_vector<int,8>): " << sizeof(lzstl::static_vector<int, 8>)
+	     << ", 平凡可复制: " << (std::is_trivially_copyable<lzstl::static_vector<int, 8>>::value
+	                           && std::is_trivially_copyable<lzstl::static_vector<static_vector_point, 4>>::value ? "是" : "否")
+	     << ", string 的不是: " << (!std::is_trivially_copyable<lzstl::static_vector<std::string, 4>>::value ? "是" : "否")
+	     << ", 常量表达式: " << sq.size() << endl; // sizeof(static_vector<int,8>): 40, 平凡可复制: 是, string 的不是: 是, 常量表达式: 6
+	
+	lzstl::static_vector<static_vector_point, 4> pts(3);
+	cout << "非平凡默认构造: " << (pts.size() == 3 && pts[2].x == 1 && pts[2].y == 2 ? "是" : "否") << endl; // 是
+	
+	// 非平凡类型：和 std::vector 做同样的操作，结果一致
+	lzstl::static_vector<std::string, 16> s;
+	std::vector<std::string> ref;
+	const char* words[] = {"alpha", "beta", "a string that is long enough to allocate", "delta", "epsilon"};
+	for (const char* w : words)
+	{
+		s.emplace_back(w);
+		ref.emplace_back(w);
+	}
+	s.insert(s.begin() + 1, std::string("inserted"));
+	ref.insert(ref.begin() + 1, std::string("inserted"));
+	s.insert(s.begin() + 3, 2, std::string("x"));
+	ref.insert(ref.begin() + 3, 2, std::string("x"));
+	std::vector<std::string> head(ref.begin(), ref.begin() + 2);
+	s.insert(s.end() - 1, head.begin(), head.end());
+	ref.insert(ref.end() - 1, head.begin(), head.end());
+	s.erase(s.begin() + 2, s.begin() + 4);
+	ref.erase(ref.begin() + 2, ref.begin() + 4);
+	s.resize(9, "pad");
+	ref.resize(9, "pad");
+	bool ok = s.size() == ref.size() && std::equal(s.begin(), s.end(), ref.begin());
+	cout << "insert/erase/resize 与 std::vector 一致: " << (ok ? "是" : "否") << endl; // 是
+	
+	// 复制、移动、交换（长度不同），元素的引用计数确认没有多构造或漏析构
+	std::shared_ptr<int> p = std::make_shared<int>(7);
+	{
+		lzstl::static_vector<std::shared_ptr<int>, 8> a(5, p), b(2, p);
+		lzstl::static_vector<std::shared_ptr<int>, 8> c(a);
+		ok = p.use_count() == 13;
+		b.swap(a);
+		ok = ok && a.size() == 2 && b.size() == 5 && p.use_count() == 13;
+		c = std::move(a);
+		ok = ok && c.size() == 2 && p.use_count() == 8;
+		a = b;
+		ok = ok && a == b && a != c && p.use_count() == 13;
+	}
+	cout << "复制/移动/交换，引用计数: " << (ok && p.use_count() == 1 ? "是" : "否") << endl; // 是
+	
+	// 超出容量抛 bad_alloc，原有内容不变
+	lzstl::static_vector<int, 4> small = {1, 2, 3, 4};
+	bool thrown = false;
+	try
+	{
+		small.push_back(5);
+	}
+	catch (const std::bad_alloc&)
+	{
+		thrown = true;
+	}
+	cout << "满了再 push_back 抛 bad_alloc: " << (thrown && small.full() && small.back() == 4 ? "是" : "否") << endl; // 是
 }
 
 int main() 
@@ -293,5 +2008,26 @@ int main()
 	test_construct();
 	test_uninitialized();
 	test_vector();
+	test_vector_move_only();
+	test_vector_shrink();
+	test_vector_snapshot();
+	test_soa_vector();
+	test_concurrent_vector();
+	test_bit_vector();
+	test_packed_int_vector();
+	test_sort();
+	test_simd_fill();
+	test_thread_pool();
+	test_algorithm();
+	test_deque();
+	test_list();
+	test_flat_hash_map();
+	test_flat_map();
+	test_btree();
+	test_spsc_ring();
+	test_mpmc_queue();
+	test_priority_queue();
+	test_string();
+	test_static_vector();
 	return 0;
 }
@@ -0,0 +1,332 @@
+#ifndef LZ_STL_MPMC_QUEUE_H
+#define LZ_STL_MPMC_QUEUE_H
+
+/*
+mpmc_queue：多生产者多消费者的有界无锁队列（Dmitry Vyukov 的带序号环形队列）
+为什么需要？
+线程池的任务队列、多个线程往一处汇总结果，都是多对多的交接，spsc_ring 用不了
+互斥锁 + std::deque 在线程多时所有线程都排在一把锁上
+
+做法：
+1.容量取 2 的幂，每个槽除了元素还有一个原子序号 seq，初始时第 i 个槽的 seq = i
+2.入队：取 _tail 位置 pos 的槽，seq == pos 说明槽空着，CAS 把 _tail 推进到 pos+1 就占到了这个槽
+  构造元素后 seq 写成 pos+1（release），告诉消费者可以读了
+  seq < pos 说明这个槽上一轮的元素还没被取走，队列满
+3.出队对称：seq == pos+1 说明元素已写好，CAS 推进 _head，取走元素后 seq 写成 pos+容量，留给下一轮的生产者
+  seq < pos+1 说明队列空
+4.生产者之间只争 _tail，消费者之间只争 _head，生产者和消费者只在各自的槽上通过 seq 交接
+5.每个槽按 64 字节对齐并补齐到 64 的倍数，相邻的槽不在同一条 cache line 上；_head、_tail 也各占一行
+6.阻塞的 push / pop：先自旋（pause）一会儿，再 yield 几次，还不行就在条件变量上睡眠
+  try_push / try_pop 成功后，只有看到有线程在睡眠时才去加锁唤醒，没有线程睡眠时只多一个栅栏和一次等待计数的读
+  写 seq 与读等待计数之间、加等待计数与再次尝试之间各有一个 seq_cst 栅栏：
+  两边不会同时错过对方，要么唤醒方看到有人等待，要么等待方睡前看到新的 seq，所以不会丢失唤醒
+
+限制：
+1.T 的移动构造不能抛异常（编译期检查）；其他构造可能抛异常时先在槽外构造好，占到槽后再移进去（占到的槽必须填上）
+  所以 try_push(T&&) 失败时参数原样保留；try_emplace 用可能抛异常的构造时，失败返回前参数已经被用过一次
+2.槽在构造时一次分配好；二级配置器的自由链表不是线程安全的，默认用 malloc_alloc
+3.析构时不能有别的线程在用
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "type_traits.h"
+#include "alloc.h"
+#include "construct.h"
+
+namespace lzstl
+{
+	enum {__MPMC_CACHE_LINE = 64};
+	enum {__MPMC_SPIN = 64};		// 阻塞操作先自旋的次数
+	enum {__MPMC_YIELD = 16};		// 自旋之后 yield 的次数，之后才睡眠
+
+	inline void __mpmc_pause()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#endif
+	}
+
+	template <typename T,typename Alloc = malloc_alloc>
+	class mpmc_queue
+	{
+	public:
+		typedef T			value_type;
+		typedef size_t		size_type;
+		typedef Alloc		allocator_type;
+	private:
+		struct __cell
+		{
+			std::atomic<size_type>	seq;
+			typename std::aligned_storage<sizeof(T),alignof(T)>::type storage;
+
+			T* data() {return reinterpret_cast<T*>(&storage);}
+		};
+		enum {STRIDE = (sizeof(__cell) + __MPMC_CACHE_LINE - 1) / __MPMC_CACHE_LINE * __MPMC_CACHE_LINE};
+
+		// 两方都只读
+		char*		_raw;		// Alloc 给的原始地址，多申请了一条 cache line 用来对齐
+		char*		_cells;		// 按 64 字节对齐的第一个槽
+		size_type	_mask;
+		char		_pad0[__MPMC_CACHE_LINE];
+
+		std::atomic<size_type>	_tail;			// 生产者争这一行
+		char		_pad1[__MPMC_CACHE_LINE - sizeof(std::atomic<size_type>)];
+		std::atomic<size_type>	_head;			// 消费者争这一行
+		char		_pad2[__MPMC_CACHE_LINE - sizeof(std::atomic<size_type>)];
+
+		// 阻塞等待用，只有有线程睡眠时才会被写
+		std::atomic<unsigned>	_push_waiters;
+		std::atomic<unsigned>	_pop_waiters;
+		std::mutex				_park_mutex;
+		std::condition_variable	_not_full;
+		std::condition_variable	_not_empty;
+
+		__cell* _cell(size_type pos) const {return reinterpret_cast<__cell*>(_cells + (pos & _mask) * STRIDE);}
+
+		static size_type _round_up(size_type n)
+		{
+			size_type cap = 2;
+			while(cap < n)
+				cap <<= 1;
+			return cap;
+		}
+
+		size_type _bytes() const {return (_mask + 1) * STRIDE + __MPMC_CACHE_LINE;}
+
+		// 占一个空槽，队列满时返回 false
+		bool _claim_push(size_type& pos)
+		{
+			pos = _tail.load(std::memory_order_relaxed);
+			for(;;)
+			{
+				size_type seq = _cell(pos)->seq.load(std::memory_order_acquire);
+				intptr_t diff = intptr_t(seq) - intptr_t(pos);
+				if(diff == 0)
+				{
+					if(_tail.compare_exchange_weak(pos,pos + 1,std::memory_order_relaxed))
+						return true;
+				}
+				else if(diff < 0)
+					return false;
+				else
+					pos = _tail.load(std::memory_order_relaxed);
+			}
+		}
+
+		// 占一个写好的槽，队列空时返回 false
+		bool _claim_pop(size_type& pos)
+		{
+			pos = _head.load(std::memory_order_relaxed);
+			for(;;)
+			{
+				size_type seq = _cell(pos)->seq.load(std::memory_order_acquire);
+				intptr_t diff = intptr_t(seq) - intptr_t(pos + 1);
+				if(diff == 0)
+				{
+					if(_head.compare_exchange_weak(pos,pos + 1,std::memory_order_relaxed))
+						return true;
+				}
+				else if(diff < 0)
+					return false;
+				else
+					pos = _head.load(std::memory_order_relaxed);
+			}
+		}
+
+		// 有线程在 cv 上睡眠时唤醒一个；先拿一下锁，保证它不在"确认完、还没睡下"的窗口里
+		// 调用前刚写过 seq：和 _wait_until 里的栅栏配对，要么这里看到等待计数，要么等待方看到新的 seq
+		void _wake_one(std::atomic<unsigned>& waiters,std::condition_variable& cv)
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if(waiters.load(std::memory_order_relaxed) == 0)
+				return;
+			{
+				std::lock_guard<std::mutex> lock(_park_mutex);
+			}
+			cv.notify_one();
+		}
+
+		// 构造不会抛异常：占到槽后直接在槽里构造
+		template <typename... Args>
+		bool _try_emplace(true_type,Args&&... args)
+		{
+			size_type pos;
+			if(!_claim_push(pos))
+				return false;
+			__cell* c = _cell(pos);
+			::new (static_cast<void*>(c->data())) T(std::forward<Args>(args)...);
+			c->seq.store(pos + 1,std::memory_order_release);
+			_wake_one(_pop_waiters,_not_empty);
+			return true;
+		}
+
+		// 构造可能抛异常：先在槽外构造，占到槽后再移进去（移动构造不抛异常，槽一定能填上）
+		template <typename... Args>
+		bool _try_emplace(false_type,Args&&... args)
+		{
+			T tmp(std::forward<Args>(args)...);
+			return _try_emplace(true_type(),std::move(tmp));
+		}
+
+		// 复制不抛异常：每次重试直接在槽里复制
+		void _push_copy(const T& value,true_type)
+		{
+			_wait_until([&]{return try_push(value);},[&]{return _can_push();},_push_waiters,_not_full);
+		}
+
+		// 复制可能抛异常：只在槽外复制一次，之后每次重试都只是尝试移进去
+		void _push_copy(const T& value,false_type)
+		{
+			T tmp(value);
+			push(std::move(tmp));
+		}
+
+		// 取走元素后把槽还给下一轮的生产者
+		void _release_pop(__cell* c,size_type pos)
+		{
+			lzstl::destroy(c->data());
+			c->seq.store(pos + _mask + 1,std::memory_order_release);
+			_wake_one(_push_waiters,_not_full);
+		}
+
+		// 队首的槽已写好 / 队尾的槽已空出来：只读，睡眠前在锁里再确认一次
+		bool _can_pop() const
+		{
+			size_type pos = _head.load(std::memory_order_relaxed);
+			return intptr_t(_cell(pos)->seq.load(std::memory_order_acquire)) - intptr_t(pos + 1) >= 0;
+		}
+
+		bool _can_push() const
+		{
+			size_type pos = _tail.load(std::memory_order_relaxed);
+			return intptr_t(_cell(pos)->seq.load(std::memory_order_acquire)) - intptr_t(pos) >= 0;
+		}
+
+		// 自旋 -> yield -> 睡眠，直到 op() 成功
+		// op() 成功时要去唤醒对方，可能要拿 _park_mutex，所以 op() 不能在锁里调用，锁里只用 ready() 确认
+		template <typename Op,typename Ready>
+		void _wait_until(Op op,Ready ready,std::atomic<unsigned>& waiters,std::condition_variable& cv)
+		{
+			for(int i = 0;i<__MPMC_SPIN;++i)
+			{
+				if(op())
+					return;
+				__mpmc_pause();
+			}
+			for(int i = 0;i<__MPMC_YIELD;++i)
+			{
+				if(op())
+					return;
+				std::this_thread::yield();
+			}
+			waiters.fetch_add(1,std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			while(!op())
+			{
+				std::unique_lock<std::mutex> lock(_park_mutex);
+				while(!ready())
+					cv.wait(lock);
+			}
+			waiters.fetch_sub(1,std::memory_order_relaxed);
+		}
+
+		mpmc_queue(const mpmc_queue&);
+		mpmc_queue& operator=(const mpmc_queue&);
+
+		static_assert(std::is_nothrow_move_constructible<T>::value,"占到的槽必须填上，T 的移动构造不能抛异常");
+
+	public:
+		// 容量向上取整到 2 的幂，至少为 2
+		explicit mpmc_queue(size_type capacity)
+			:_mask(_round_up(capacity) - 1),_tail(0),_head(0),_push_waiters(0),_pop_waiters(0)
+		{
+			_raw = static_cast<char*>(Alloc::allocate(_bytes()));
+			_cells = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(_raw) + __MPMC_CACHE_LINE - 1)
+											 & ~uintptr_t(__MPMC_CACHE_LINE - 1));
+			for(size_type i = 0;i<=_mask;++i)
+				::new (static_cast<void*>(&_cell(i)->seq)) std::atomic<size_type>(i);
+		}
+
+		~mpmc_queue()
+		{
+			size_type pos;
+			while(_claim_pop(pos))
+				lzstl::destroy(_cell(pos)->data());
+			Alloc::deallocate(_raw,_bytes());
+		}
+
+		// -------------------------- 容量与大小 --------------------------
+		size_type capacity() const {return _mask + 1;}
+
+		// 别的线程同时在操作时只是一个近似值
+		size_type size() const
+		{
+			size_type h = _head.load(std::memory_order_acquire);
+			size_type t = _tail.load(std::memory_order_acquire);
+			return t > h ? t - h : 0;
+		}
+		bool empty() const {return size() == 0;}
+
+		// -------------------------- 非阻塞 --------------------------
+		template <typename... Args>
+		bool try_emplace(Args&&... args)
+		{
+			return _try_emplace(typename __bool_type<std::is_nothrow_constructible<T,Args&&...>::value>::type(),
+								std::forward<Args>(args)...);
+		}
+
+		bool try_push(const T& value) {return try_emplace(value);}
+		bool try_push(T&& value) {return try_emplace(std::move(value));}
+
+		bool try_pop(T& out)
+		{
+			size_type pos;
+			if(!_claim_pop(pos))
+				return false;
+			__cell* c = _cell(pos);
+			try
+			{
+				out = std::move(*c->data());
+			}
+			catch(...)
+			{
+				// 赋值抛异常也要把槽还回去，否则生产者会永远等这个槽；这个元素就丢掉了
+				_release_pop(c,pos);
+				throw;
+			}
+			_release_pop(c,pos);
+			return true;
+		}
+
+		// -------------------------- 阻塞 --------------------------
+		// 满了就等
+		void push(const T& value)
+		{
+			_push_copy(value,typename __bool_type<std::is_nothrow_copy_constructible<T>::value>::type());
+		}
+
+		// 移动构造不抛异常，走的是占到槽再构造的路径，成功之前 value 不会被移走
+		void push(T&& value)
+		{
+			_wait_until([&]{return try_push(std::move(value));},[&]{return _can_push();},_push_waiters,_not_full);
+		}
+
+		// 空了就等
+		void pop(T& out)
+		{
+			_wait_until([&]{return try_pop(out);},[&]{return _can_pop();},_pop_waiters,_not_empty);
+		}
+
+		allocator_type get_allocator() const {return allocator_type();}
+	};
+}
+
+#endif
@@ -0,0 +1,290 @@
+#ifndef LZ_STL_PACKED_INT_VECTOR_H
+#define LZ_STL_PACKED_INT_VECTOR_H
+
+/*
+packed_int_vector：压缩存储的 64 位无符号整数数组
+为什么需要？
+ID、时间戳这类列放在 vector<uint64_t> 里每个占 8 字节，但真实取值往往很小或有序
+扫描时大部分带宽都花在搬运高位的 0 上
+
+做法：每 64 个值为一块（block），每块独立选择位宽
+1.帧参考（Frame Of Reference, FOR）
+	块内存 v - min，位宽 w = 能表示 (max - min) 的最少位数
+	64 个值 * w 位 = 正好 w 个 64 位字，所以每块的数据都从字边界开始
+2.差分（delta，可选，适合有序数据）
+	块内存 v[i] - v[i-1]，有序的时间戳差分往往只要几位
+	只有块内单调不减时才可用；每块在 FOR 和 delta 中选位宽更小的那个
+3.块头 16 字节：base(块最小值或首值) + info(数据起始字下标 << 8 | delta标志 << 7 | 位宽)
+4.追加：新值先进未压缩的尾块 _tail，攒满 64 个再压缩
+
+随机访问：
+	FOR 块：直接定位第 i*w 位，最多跨两个字，O(1)
+	delta 块：需要对块内前缀求和，最多 63 次加法（块大小固定，仍是 O(1)）
+顺序解码：按位宽分派到 __unpack_block<W>，W 是编译期常量，循环可完全展开并被编译器向量化
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include "alloc.h"
+#include "vector.h"
+
+namespace lzstl
+{
+	typedef unsigned long long __packed_word;
+
+	enum {__PACKED_BLOCK = 64};		// 每块的值个数
+
+	// 块头：base + info，见文件开头说明
+	struct __packed_block_header
+	{
+		__packed_word base;
+		__packed_word info;
+
+		size_t offset() const {return size_t(info >> 8);}
+		unsigned width() const {return unsigned(info & 0x7F);}
+		bool delta() const {return (info & 0x80) != 0;}
+	};
+
+	// 能表示 x 的最少位数（x == 0 时为 0）
+	inline unsigned __bit_width(__packed_word x)
+	{
+		return x == 0 ? 0 : unsigned(64 - __builtin_clzll(x));
+	}
+
+	inline __packed_word __low_mask(unsigned w)
+	{
+		return w >= 64 ? ~__packed_word(0) : ((__packed_word(1) << w) - 1);
+	}
+
+	// 从 src 的第 bit 位起取出 w 位
+	inline __packed_word __extract_bits(const __packed_word* src,size_t bit,unsigned w)
+	{
+		size_t word = bit >> 6;
+		unsigned shift = unsigned(bit & 63);
+		__packed_word v = src[word] >> shift;
+		if(shift + w > 64)
+			v |= src[word+1] << (64 - shift);
+		return v & __low_mask(w);
+	}
+
+	// 位宽为 W 的整块解包（不含 base），W 为编译期常量
+	template <unsigned W>
+	inline void __unpack_block(const __packed_word* src,__packed_word* out)
+	{
+		const __packed_word mask = __low_mask(W);
+		for(unsigned i = 0;i<__PACKED_BLOCK;++i)
+		{
+			const unsigned bit = i * W;
+			const unsigned word = bit >> 6;
+			const unsigned shift = bit & 63;
+			__packed_word v = src[word] >> shift;
+			if(shift + W > 64)
+				v |= src[word+1] << (64 - shift);
+			out[i] = v & mask;
+		}
+	}
+
+	template <>
+	inline void __unpack_block<0>(const __packed_word*,__packed_word* out)
+	{
+		std::memset(out,0,__PACKED_BLOCK*sizeof(__packed_word));
+	}
+
+	// 按位宽分派的解包函数表：__unpack_table[w] = __unpack_block<w>
+	typedef void (*__unpack_fn)(const __packed_word*,__packed_word*);
+
+	template <size_t... W>
+	inline const __unpack_fn* __make_unpack_table(std::index_sequence<W...>)
+	{
+		static const __unpack_fn table[] = {&__unpack_block<unsigned(W)>...};
+		return table;
+	}
+
+	inline const __unpack_fn* __unpack_table()
+	{
+		static const __unpack_fn* table = __make_unpack_table(std::make_index_sequence<65>());
+		return table;
+	}
+
+	template <typename Alloc = alloc>
+	class packed_int_vector
+	{
+	public:
+		typedef __packed_word	value_type;
+		typedef size_t			size_type;
+		typedef ptrdiff_t		difference_type;
+		typedef Alloc			allocator_type;
+
+	private:
+		vector<__packed_block_header,Alloc>	_blocks;	// 已压缩的块
+		vector<__packed_word,Alloc>			_bits;		// 所有块的位数据
+		__packed_word	_tail[__PACKED_BLOCK];			// 未压缩的尾块
+		size_type		_tail_size;
+		bool			_allow_delta;					// 是否尝试差分编码
+
+		// -------------------------- 内部辅助函数 --------------------------
+		// 把攒满的尾块压缩成一块
+		void _seal_tail()
+		{
+			const __packed_word* v = _tail;
+
+			// FOR：相对最小值的位宽
+			__packed_word lo = v[0],hi = v[0];
+			for(unsigned i = 1;i<__PACKED_BLOCK;++i)
+			{
+				if(v[i] < lo) lo = v[i];
+				if(v[i] > hi) hi = v[i];
+			}
+			unsigned width = __bit_width(hi - lo);
+			bool use_delta = false;
+
+			// delta：块内单调不减时，相邻差的位宽
+			if(_allow_delta)
+			{
+				bool sorted = true;
+				__packed_word max_gap = 0;
+				for(unsigned i = 1;i<__PACKED_BLOCK && sorted;++i)
+				{
+					if(v[i] < v[i-1])
+						sorted = false;
+					else if(v[i] - v[i-1] > max_gap)
+						max_gap = v[i] - v[i-1];
+				}
+				if(sorted && __bit_width(max_gap) < width)
+				{
+					width = __bit_width(max_gap);
+					use_delta = true;
+				}
+			}
+
+			__packed_block_header h;
+			h.base = use_delta ? v[0] : lo;
+			h.info = (__packed_word(_bits.size()) << 8) | (use_delta ? 0x80 : 0) | width;
+
+			// 64 个 w 位的值正好占 w 个字
+			size_type offset = _bits.size();
+			_bits.resize(offset + width,0);
+			__packed_word* dst = _bits.data() + offset;
+			size_t bit = 0;
+			for(unsigned i = 0;i<__PACKED_BLOCK && width;++i,bit += width)
+			{
+				__packed_word x = use_delta ? (i == 0 ? 0 : v[i] - v[i-1]) : v[i] - lo;
+				size_t word = bit >> 6;
+				unsigned shift = unsigned(bit & 63);
+				dst[word] |= x << shift;
+				if(shift + width > 64)
+					dst[word+1] |= x >> (64 - shift);
+			}
+
+			_blocks.push_back(h);
+			_tail_size = 0;
+		}
+
+		// 解出第 k 块的全部 64 个值
+		void _decode_block(size_type k,__packed_word* out) const
+		{
+			const __packed_block_header& h = _blocks[k];
+			__unpack_table()[h.width()](_bits.data() + h.offset(),out);
+			if(h.delta())
+			{
+				__packed_word acc = h.base;
+				for(unsigned i = 0;i<__PACKED_BLOCK;++i)
+				{
+					acc += out[i];
+					out[i] = acc;
+				}
+			}
+			else
+			{
+				for(unsigned i = 0;i<__PACKED_BLOCK;++i)
+					out[i] += h.base;
+			}
+		}
+
+	public:
+		// -------------------------- 构造函数 --------------------------
+		// allow_delta：有序数据（时间戳、递增 ID）建议打开
+		explicit packed_int_vector(bool allow_delta = false):_tail_size(0),_allow_delta(allow_delta){}
+
+		// -------------------------- 容量与大小操作 --------------------------
+		size_type size() const {return _blocks.size() * __PACKED_BLOCK + _tail_size;}
+		bool empty() const {return size() == 0;}
+
+		void clear()
+		{
+			_blocks.clear();
+			_bits.clear();
+			_tail_size = 0;
+		}
+
+		// 压缩后实际占用的字节数（块头 + 位数据 + 尾块）
+		size_type memory_bytes() const
+		{
+			return _blocks.size() * sizeof(__packed_block_header) + _bits.size() * sizeof(__packed_word)
+				 + _tail_size * sizeof(__packed_word);
+		}
+
+		// -------------------------- 元素访问 --------------------------
+		value_type operator[](size_type idx) const
+		{
+			size_type k = idx / __PACKED_BLOCK;
+			unsigned i = unsigned(idx % __PACKED_BLOCK);
+			if(k == _blocks.size())
+				return _tail[i];
+
+			const __packed_block_header& h = _blocks[k];
+			unsigned w = h.width();
+			const __packed_word* src = _bits.data() + h.offset();
+			if(!h.delta())
+				return w ? h.base + __extract_bits(src,size_t(i) * w,w) : h.base;
+
+			// 差分块：块内前缀求和
+			__packed_word acc = h.base;
+			for(unsigned j = 1;j<=i && w;++j)
+				acc += __extract_bits(src,size_t(j) * w,w);
+			return acc;
+		}
+
+		value_type back() const {return (*this)[size()-1];}
+
+		// 顺序解码 [first, first+n) 到 out，整块部分走按位宽特化的解包
+		void decode(size_type first,size_type n,value_type* out) const
+		{
+			__packed_word buf[__PACKED_BLOCK];
+			size_type last = first + n;
+			while(first < last)
+			{
+				size_type k = first / __PACKED_BLOCK;
+				size_type i = first % __PACKED_BLOCK;
+				size_type take = __PACKED_BLOCK - i;
+				if(take > last - first)
+					take = last - first;
+
+				if(k == _blocks.size())
+					std::memcpy(out,_tail + i,take * sizeof(__packed_word));
+				else if(i == 0 && take == __PACKED_BLOCK)
+					_decode_block(k,out);		// 整块直接解到目标
+				else
+				{
+					_decode_block(k,buf);
+					std::memcpy(out,buf + i,take * sizeof(__packed_word));
+				}
+				out += take;
+				first += take;
+			}
+		}
+
+		// -------------------------- 元素插入 --------------------------
+		void push_back(value_type value)
+		{
+			_tail[_tail_size++] = value;
+			if(_tail_size == __PACKED_BLOCK)
+				_seal_tail();
+		}
+
+		allocator_type get_allocator() const {return allocator_type();}
+	};
+}
+
+#endif
@@ -0,0 +1,439 @@
+#ifndef LZ_STL_PRIORITY_QUEUE_H
+#define LZ_STL_PRIORITY_QUEUE_H
+
+/*
+priority_queue：d 叉堆实现的优先队列，底层是 lzstl::vector
+为什么需要？
+std::priority_queue 是二叉堆，n 个元素的堆有 log2(n) 层，pop 的下滤每层都要访问一次新的 cache line
+几百万个元素时，下滤的每一步几乎都是一次缓存未命中
+
+做法：
+1.每个节点 Arity 个孩子（默认 4），孩子 Arity*i+1 ... Arity*i+Arity 连续存放
+  4 个 int / 8 个 int 的孩子在同一条 cache line 里，一次访存比较完所有孩子；树高是二叉堆的 1/2（4 叉）或 1/3（8 叉）
+  孩子满 Arity 个时两两比较挑最大的，几次比较互不依赖；下滤时顺便按 cache line 预取下一层的孙子
+2.上滤/下滤用"空位"的写法：元素先取出来，沿路把父/子元素移进空位，最后放一次，不做交换
+  pop 时空位先沿最大的孩子走到叶子，再把最后一个元素从叶子上滤（它通常很小，上滤一两层就停）
+3.push_range：追加的元素多（超过原有元素的一半）时整体重新建堆 O(n)，否则逐个上滤
+4.pop_push / replace_top：弹出堆顶的同时放入新元素，只做一次下滤，比 pop + push 少一次上滤
+5.indexed_priority_queue：每个元素带一个编号 id，另存编号 -> 堆中位置的表，
+  可以 O(log n) 地改某个编号的键（decrease_key），Dijkstra / Prim 不需要"懒删除"留下的过期元素
+  堆里存 (键, 编号)，比较只看连续存放的键，不用再查一次表
+
+与 std::priority_queue 一样，Compare 为 std::less 时是大顶堆（top 是最大的元素），std::greater 时是小顶堆
+
+限制：
+1.top / pop / replace_top / pop_push 要求队列非空
+2.indexed_priority_queue 的编号应当是稠密的小整数，位置表按最大的编号分配
+3.Arity 越大树越矮，但每层比较次数越多；元素很大时孩子跨多条 cache line，4 叉通常最合适
+*/
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include "type_traits.h"
+#include "alloc.h"
+#include "vector.h"
+
+namespace lzstl
+{
+	// 堆里的元素挪了位置时不需要记录
+	struct __heap_no_track
+	{
+		template <typename E>
+		void operator()(const E&,size_t) const {}
+	};
+
+	// 孩子 first ... first+Arity-1 的孩子们（孙子）是连续的 Arity*Arity 个元素，下一层要在其中挑，先按 cache line 预取
+	template <size_t Arity,typename E>
+	inline void __dary_prefetch_grandchildren(const E* base,size_t n,size_t first)
+	{
+		enum {STEP = sizeof(E) < 64 ? 64 / sizeof(E) : 1};
+		size_t lo = first * Arity + 1;
+		size_t hi = lo + Arity * Arity < n ? lo + Arity * Arity : n;
+		for(size_t i = lo;i<hi;i += STEP)
+			__builtin_prefetch(base + i);
+	}
+
+	// [p, p+count) 中按 comp 最大的一个的下标
+	// 孩子满 Arity 个时两两比较（锦标赛），比较之间没有依赖，不用等上一次比较的结果再取下一个元素
+	template <size_t Arity,typename E,typename Compare>
+	inline size_t __dary_best_child(const E* p,size_t count,const Compare& comp)
+	{
+		if(count == Arity && Arity % 2 == 0)
+		{
+			size_t win[Arity / 2];
+			for(size_t i = 0;i<Arity / 2;++i)
+				win[i] = comp(p[2 * i],p[2 * i + 1]) ? 2 * i + 1 : 2 * i;
+			for(size_t step = 1;step<Arity / 2;step *= 2)
+				for(size_t i = 0;i + step<Arity / 2;i += 2 * step)
+					win[i] = comp(p[win[i]],p[win[i + step]]) ? win[i + step] : win[i];
+			return win[0];
+		}
+		size_t best = 0;
+		for(size_t c = 1;c<count;++c)
+			best = comp(p[best],p[c]) ? c : best;
+		return best;
+	}
+
+	// hole 处的元素向上调整，返回它最终的位置；每次有元素落到新位置就调用 track(元素, 位置)
+	template <size_t Arity,typename E,typename Compare,typename Track>
+	size_t __dary_sift_up(E* base,size_t hole,const Compare& comp,const Track& track)
+	{
+		E value = std::move(base[hole]);
+		while(hole > 0)
+		{
+			size_t parent = (hole - 1) / Arity;
+			if(!comp(base[parent],value))
+				break;
+			base[hole] = std::move(base[parent]);
+			track(base[hole],hole);
+			hole = parent;
+		}
+		base[hole] = std::move(value);
+		track(base[hole],hole);
+		return hole;
+	}
+
+	// hole 处的元素在 [0, n) 中向下调整：每层在连续的 Arity 个孩子里挑最大的
+	template <size_t Arity,typename E,typename Compare,typename Track>
+	size_t __dary_sift_down(E* base,size_t n,size_t hole,const Compare& comp,const Track& track)
+	{
+		E value = std::move(base[hole]);
+		for(;;)
+		{
+			size_t first = hole * Arity + 1;
+			if(first >= n)
+				break;
+			__dary_prefetch_grandchildren<Arity>(base,n,first);
+			size_t best = first + __dary_best_child<Arity>(base + first,first + Arity <= n ? Arity : n - first,comp);
+			if(!comp(value,base[best]))
+				break;
+			base[hole] = std::move(base[best]);
+			track(base[hole],hole);
+			hole = best;
+		}
+		base[hole] = std::move(value);
+		track(base[hole],hole);
+		return hole;
+	}
+
+	// 弹出堆顶用：空位从根一路沿最大的孩子走到叶子，再把 value 从那里上滤
+	// 被换上来的最后一个元素通常很小，上滤一两层就停，每层省掉一次和 value 的比较（Floyd 的做法）
+	template <size_t Arity,typename E,typename Compare,typename Track>
+	void __dary_pop_sift(E* base,size_t n,E&& value,const Compare& comp,const Track& track)
+	{
+		size_t hole = 0;
+		for(;;)
+		{
+			size_t first = hole * Arity + 1;
+			if(first >= n)
+				break;
+			__dary_prefetch_grandchildren<Arity>(base,n,first);
+			size_t best = first + __dary_best_child<Arity>(base + first,first + Arity <= n ? Arity : n - first,comp);
+			base[hole] = std::move(base[best]);
+			track(base[hole],hole);
+			hole = best;
+		}
+		base[hole] = std::move(value);
+		__dary_sift_up<Arity>(base,hole,comp,track);
+	}
+
+	// 自底向上建堆，O(n)
+	template <size_t Arity,typename E,typename Compare,typename Track>
+	void __dary_make_heap(E* base,size_t n,const Compare& comp,const Track& track)
+	{
+		if(n < 2)
+			return;
+		for(size_t i = (n - 2) / Arity + 1;i-- > 0;)
+			__dary_sift_down<Arity>(base,n,i,comp,track);
+	}
+
+	// -------------------------- priority_queue --------------------------
+	template <typename T,typename Compare = std::less<T>,size_t Arity = 4,typename Alloc = alloc>
+	class priority_queue
+	{
+		static_assert(Arity >= 2,"堆至少是二叉的");
+	public:
+		typedef T					value_type;
+		typedef const T&			const_reference;
+		typedef size_t				size_type;
+		typedef Compare				value_compare;
+		typedef vector<T,Alloc>		container_type;
+	private:
+		container_type	_c;
+		Compare			_comp;
+
+		void _sift_up_last()
+		{
+			__dary_sift_up<Arity>(_c.data(),_c.size() - 1,_comp,__heap_no_track());
+		}
+
+	public:
+		// -------------------------- 构造函数 --------------------------
+		priority_queue():_comp(){}
+		explicit priority_queue(const Compare& comp):_comp(comp){}
+
+		template <typename InputIterator>
+		priority_queue(InputIterator first,InputIterator last,const Compare& comp = Compare()):_c(first,last),_comp(comp)
+		{
+			__dary_make_heap<Arity>(_c.data(),_c.size(),_comp,__heap_no_track());
+		}
+
+		// -------------------------- 容量与大小 --------------------------
+		size_type size() const {return _c.size();}
+		bool empty() const {return _c.empty();}
+		void reserve(size_type n) {_c.reserve(n);}
+		void clear() {_c.clear();}
+
+		// -------------------------- 访问 --------------------------
+		const_reference top() const {return _c.front();}
+
+		// 底层数组（按堆序排列）
+		const container_type& container() const {return _c;}
+
+		// -------------------------- 插入/删除 --------------------------
+		void push(const value_type& value)
+		{
+			_c.push_back(value);
+			_sift_up_last();
+		}
+
+		void push(value_type&& value)
+		{
+			_c.push_back(std::move(value));
+			_sift_up_last();
+		}
+
+		template <typename... Args>
+		void emplace(Args&&... args)
+		{
+			_c.emplace_back(std::forward<Args>(args)...);
+			_sift_up_last();
+		}
+
+		// 追加的元素比原有的一半还多时整体建堆，否则逐个上滤
+		template <typename InputIterator>
+		void push_range(InputIterator first,InputIterator last)
+		{
+			size_type old = _c.size();
+			_c.insert(_c.end(),first,last);
+			size_type n = _c.size();
+			T* base = _c.data();
+			if(n - old > old / 2)
+				__dary_make_heap<Arity>(base,n,_comp,__heap_no_track());
+			else
+				for(size_type i = old;i<n;++i)
+					__dary_sift_up<Arity>(base,i,_comp,__heap_no_track());
+		}
+
+		// 最后一个元素填进堆顶腾出的位置
+		void pop()
+		{
+			T* base = _c.data();
+			size_type n = _c.size() - 1;
+			if(n > 0)
+			{
+				T last = std::move(base[n]);
+				_c.pop_back();
+				__dary_pop_sift<Arity>(base,n,std::move(last),_comp,__heap_no_track());
+			}
+			else
+				_c.pop_back();
+		}
+
+		// 堆顶换成 value 再下滤：等价于 pop(); push(value); 但只调整一次
+		void replace_top(const value_type& value)
+		{
+			T* base = _c.data();
+			base[0] = value;
+			__dary_sift_down<Arity>(base,_c.size(),0,_comp,__heap_no_track());
+		}
+
+		void replace_top(value_type&& value)
+		{
+			T* base = _c.data();
+			base[0] = std::move(value);
+			__dary_sift_down<Arity>(base,_c.size(),0,_comp,__heap_no_track());
+		}
+
+		// 取出堆顶并放入 value，返回原来的堆顶
+		value_type pop_push(value_type value)
+		{
+			T* base = _c.data();
+			value_type old = std::move(base[0]);
+			base[0] = std::move(value);
+			__dary_sift_down<Arity>(base,_c.size(),0,_comp,__heap_no_track());
+			return old;
+		}
+
+		void swap(priority_queue& rhs)
+		{
+			_c.swap(rhs._c);
+			std::swap(_comp,rhs._comp);
+		}
+
+		value_compare value_comp() const {return _comp;}
+	};
+
+	template <typename T,typename Compare,size_t Arity,typename Alloc>
+	inline void swap(priority_queue<T,Compare,Arity,Alloc>& lhs,priority_queue<T,Compare,Arity,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+	// -------------------------- indexed_priority_queue --------------------------
+	// 元素是 (编号, 键)，编号是 [0, n) 中的整数，同一编号同时只能在队列里出现一次
+	template <typename T,typename Compare = std::less<T>,size_t Arity = 4,typename Alloc = alloc>
+	class indexed_priority_queue
+	{
+		static_assert(Arity >= 2,"堆至少是二叉的");
+	public:
+		typedef T			key_type;
+		typedef size_t		size_type;
+		typedef Compare		key_compare;
+
+		static const size_type npos = size_type(-1);
+	private:
+		struct __entry
+		{
+			T			key;
+			size_type	id;
+		};
+
+		struct __entry_less
+		{
+			const Compare* comp;
+			bool operator()(const __entry& a,const __entry& b) const {return (*comp)(a.key,b.key);}
+		};
+
+		// 元素移到新位置时更新 编号 -> 位置 的表
+		struct __track_pos
+		{
+			size_type* pos;
+			void operator()(const __entry& e,size_t i) const {pos[e.id] = i;}
+		};
+
+		vector<__entry,Alloc>		_heap;
+		vector<size_type,Alloc>		_pos;		// 编号 -> 在 _heap 中的位置，不在队列中为 npos
+		Compare						_comp;
+
+		__entry_less _less() const {__entry_less l = {&_comp};return l;}
+		__track_pos _track() {__track_pos t = {_pos.data()};return t;}
+
+	public:
+		indexed_priority_queue():_comp(){}
+		explicit indexed_priority_queue(const Compare& comp):_comp(comp){}
+
+		// 预留 n 个编号 [0, n) 的位置表
+		explicit indexed_priority_queue(size_type n,const Compare& comp = Compare()):_pos(n,npos),_comp(comp)
+		{
+			_heap.reserve(n);
+		}
+
+		// -------------------------- 容量与大小 --------------------------
+		size_type size() const {return _heap.size();}
+		bool empty() const {return _heap.empty();}
+
+		void clear()
+		{
+			for(size_type i = 0;i<_heap.size();++i)
+				_pos[_heap[i].id] = npos;
+			_heap.clear();
+		}
+
+		// -------------------------- 访问 --------------------------
+		bool contains(size_type id) const {return id < _pos.size() && _pos[id] != npos;}
+		const key_type& key(size_type id) const {return _heap[_pos[id]].key;}
+		size_type top_id() const {return _heap.front().id;}
+		const key_type& top_key() const {return _heap.front().key;}
+
+		// -------------------------- 修改 --------------------------
+		// 编号 id 不在队列中
+		void push(size_type id,const key_type& key)
+		{
+			if(id >= _pos.size())
+				_pos.resize(id + 1,npos);
+			__entry e = {key,id};
+			_heap.push_back(e);
+			__dary_sift_up<Arity>(_heap.data(),_heap.size() - 1,_less(),_track());
+		}
+
+		void pop()
+		{
+			__entry* base = _heap.data();
+			size_type n = _heap.size() - 1;
+			_pos[base[0].id] = npos;
+			if(n > 0)
+			{
+				base[0] = std::move(base[n]);
+				_heap.pop_back();
+				__dary_sift_down<Arity>(base,n,0,_less(),_track());
+			}
+			else
+				_heap.pop_back();
+		}
+
+		// 新键按 Compare 不比原来差（小顶堆即不比原来大），只需上滤
+		void decrease_key(size_type id,const key_type& key)
+		{
+			size_type i = _pos[id];
+			_heap[i].key = key;
+			__dary_sift_up<Arity>(_heap.data(),i,_less(),_track());
+		}
+
+		// 新键可能变好也可能变差
+		void update_key(size_type id,const key_type& key)
+		{
+			size_type i = _pos[id];
+			__entry* base = _heap.data();
+			bool better = _comp(base[i].key,key);
+			base[i].key = key;
+			if(better)
+				__dary_sift_up<Arity>(base,i,_less(),_track());
+			else
+				__dary_sift_down<Arity>(base,_heap.size(),i,_less(),_track());
+		}
+
+		// 不在队列中就插入，在就改成更好的键；返回是否有改动（Dijkstra 的松弛）
+		bool push_or_decrease(size_type id,const key_type& key)
+		{
+			if(!contains(id))
+			{
+				push(id,key);
+				return true;
+			}
+			if(!_comp(_heap[_pos[id]].key,key))
+				return false;
+			decrease_key(id,key);
+			return true;
+		}
+
+		// 从队列中删掉编号 id
+		void erase(size_type id)
+		{
+			size_type i = _pos[id];
+			__entry* base = _heap.data();
+			size_type n = _heap.size() - 1;
+			_pos[id] = npos;
+			if(i != n)
+			{
+				bool better = _comp(base[i].key,base[n].key);
+				base[i] = std::move(base[n]);
+				_heap.pop_back();
+				if(better)
+					__dary_sift_up<Arity>(base,i,_less(),_track());
+				else
+					__dary_sift_down<Arity>(base,n,i,_less(),_track());
+			}
+			else
+				_heap.pop_back();
+		}
+
+		key_compare key_comp() const {return _comp;}
+	};
+
+	template <typename T,typename Compare,size_t Arity,typename Alloc>
+	const typename indexed_priority_queue<T,Compare,Arity,Alloc>::size_type indexed_priority_queue<T,Compare,Arity,Alloc>::npos;
+}
+
+#endif
@@ -0,0 +1,439 @@
+#ifndef LZ_STL_SIMD_H
+#define LZ_STL_SIMD_H
+
+/*
+SIMD 填充/复制内核：给 uninitialized_fill / uninitialized_fill_n / uninitialized_copy 的 POD 分支用
+为什么需要？
+vector(n, value)、resize 对 POD 元素原本是一次赋值一个元素，带宽远低于内存速度
+大块复制（vector 拷贝、扩容）超过缓存后，memcpy 的普通存储也会被 RFO 拖慢
+
+做法：
+1.运行时检测 CPU（SSE2 / AVX2 / AVX-512），第一次调用时选定内核，之后只是一次函数指针调用
+  各内核用 __attribute__((target(...))) 单独编译，不需要给整个程序加 -mavx2
+2.把元素值重复铺满一个 “花样”（pattern），长度取元素大小与 64 的最小公倍数
+  元素大小整除 64 时就是 64 字节；12、24 字节的元素是 192 字节（3 条 cache line），最长 __SIMD_MAX_PERIOD
+	头部：逐字节写到 64 字节对齐
+	主体：每次写 64 字节（SSE2 4 次、AVX2 2 次、AVX-512 1 次对齐存储），依次取花样里的下一段 64 字节
+	尾部：逐字节写完
+  对齐后花样的相位会变，所以主体用的是按头部长度 “旋转” 过的花样
+  花样只有 64 字节时整个放在寄存器里；更长的花样每写 64 字节从（L1 里的）花样读一次
+  非临时存储的主体总是按后一种写，瓶颈在内存，多出的读不影响
+3.值的所有字节都相同（0、-1、'a' ...）时直接用 memset，libc 的实现已经足够快
+4.非临时存储（non-temporal，绕过缓存直接写内存）：
+  填充量超过最后一级缓存（LLC）时，普通存储会把有用的数据挤出缓存，还要先把目标行读进来（RFO）
+  超过 nontemporal_threshold() 字节时改用流式存储，可用 set_nontemporal_threshold 调整
+5.复制：没超过阈值直接 memcpy；超过时目标对齐到 64 字节后非对齐读、流式写（simd_copy）
+*/
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define LZ_STL_SIMD_POSIX 1
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LZ_STL_SIMD_X86 1
+#endif
+
+namespace lzstl
+{
+	// -------------------------- CPU 检测 --------------------------
+	enum __simd_level {__SIMD_NONE = 0,__SIMD_SSE2,__SIMD_AVX2,__SIMD_AVX512};
+
+	inline __simd_level __detect_simd_level()
+	{
+#ifdef LZ_STL_SIMD_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx512f"))
+			return __SIMD_AVX512;
+		if(__builtin_cpu_supports("avx2"))
+			return __SIMD_AVX2;
+		if(__builtin_cpu_supports("sse2"))
+			return __SIMD_SSE2;
+#endif
+		return __SIMD_NONE;
+	}
+
+	inline __simd_level simd_level()
+	{
+		static const __simd_level level = __detect_simd_level();
+		return level;
+	}
+
+	// -------------------------- 非临时存储阈值 --------------------------
+	// 默认取最后一级缓存的大小，取不到（或不是 POSIX 系统）时按 32MB 算
+	inline size_t& __nontemporal_threshold_ref()
+	{
+		static size_t threshold = []()
+		{
+			long llc = -1;
+#if defined(LZ_STL_SIMD_POSIX) && defined(_SC_LEVEL3_CACHE_SIZE)
+			llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+			return llc > 0 ? size_t(llc) : size_t(32) << 20;
+		}();
+		return threshold;
+	}
+
+	inline size_t nontemporal_threshold() {return __nontemporal_threshold_ref();}
+
+	// 超过 bytes 字节的填充/复制使用非临时存储；传 size_t(-1) 关闭
+	inline void set_nontemporal_threshold(size_t bytes) {__nontemporal_threshold_ref() = bytes;}
+
+	// -------------------------- 填充内核 --------------------------
+	// 花样的最大周期：元素大小与 64 的最小公倍数不超过它时才走 SIMD 填充
+	enum {__SIMD_MAX_PERIOD = 1024};
+
+	// dst 开始的 bytes 字节按周期 period（64 的倍数）的花样 pattern 填充；nt 表示使用非临时存储
+	typedef void (*__fill_kernel)(unsigned char* dst,size_t bytes,const unsigned char* pattern,size_t period,bool nt);
+
+	// 头部、尾部与无 SIMD 时的逐字节填充，dst 相对花样起点的偏移为 phase（< period）
+	inline void __fill_bytes(unsigned char* dst,size_t bytes,const unsigned char* pattern,size_t period,size_t phase)
+	{
+		for(size_t i = 0;i<bytes;++i)
+		{
+			dst[i] = pattern[phase];
+			if(++phase == period)
+				phase = 0;
+		}
+	}
+
+	// 把 dst 对齐到 64 字节：返回头部长度，并生成主体使用的旋转花样
+	inline size_t __fill_head(unsigned char* dst,size_t bytes,const unsigned char* pattern,size_t period,unsigned char* rotated)
+	{
+		size_t head = (64 - (reinterpret_cast<size_t>(dst) & 63)) & 63;
+		if(head > bytes) head = bytes;
+		__fill_bytes(dst,head,pattern,period,0);
+		std::memcpy(rotated,pattern + head,period - head);
+		std::memcpy(rotated + period - head,pattern,head);
+		return head;
+	}
+
+	// 主体每写 64 字节，花样前进 64 字节，到一个周期后回到开头
+	inline size_t __fill_next(size_t off,size_t period)
+	{
+		off += 64;
+		return off == period ? 0 : off;
+	}
+
+	inline void __fill_kernel_scalar(unsigned char* dst,size_t bytes,const unsigned char* pattern,size_t period,bool)
+	{
+		// 按 8 字节一次写，编译器会自动展开
+		unsigned char rotated[__SIMD_MAX_PERIOD];
+		size_t head = __fill_head(dst,bytes,pattern,period,rotated);
+		dst += head;
+		bytes -= head;
+		size_t body = bytes & ~size_t(63),off = 0;
+		for(size_t i = 0;i<body;i+=64,off = __fill_next(off,period))
+			std::memcpy(dst+i,rotated+off,64);
+		__fill_bytes(dst+body,bytes-body,rotated,period,off);
+	}
+
+#ifdef LZ_STL_SIMD_X86
+	__attribute__((target("sse2")))
+	inline void __fill_kernel_sse2(unsigned char* dst,size_t bytes,const unsigned char* pattern,size_t period,bool nt)
+	{
+		unsigned char rotated[__SIMD_MAX_PERIOD];
+		size_t head = __fill_head(dst,bytes,pattern,period,rotated);
+		dst += head;
+		bytes -= head;
+		size_t body = bytes & ~size_t(63),off = 0;
+		if(nt)
+		{
+			for(size_t i = 0;i<body;i+=64,off = __fill_next(off,period))
+			{
+				const __m128i* s = reinterpret_cast<const __m128i*>(rotated+off);
+				__m128i* d = reinterpret_cast<__m128i*>(dst+i);
+				_mm_stream_si128(d,_mm_loadu_si128(s));
+				_mm_stream_si128(d+1,_mm_loadu_si128(s+1));
+				_mm_stream_si128(d+2,_mm_loadu_si128(s+2));
+				_mm_stream_si128(d+3,_mm_loadu_si128(s+3));
+			}
+			_mm_sfence();
+		}
+		else if(period == 64)
+		{
+			// 花样只有 64 字节（最常见）：整个放在寄存器里，主体只剩存储
+			const __m128i* s = reinterpret_cast<const __m128i*>(rotated);
+			const __m128i v0 = _mm_loadu_si128(s),v1 = _mm_loadu_si128(s+1),v2 = _mm_loadu_si128(s+2),v3 = _mm_loadu_si128(s+3);
+			__m128i* p = reinterpret_cast<__m128i*>(dst);
+			for(size_t i = 0;i<body/16;i+=4)
+			{
+				_mm_store_si128(p+i,v0);
+				_mm_store_si128(p+i+1,v1);
+				_mm_store_si128(p+i+2,v2);
+				_mm_store_si128(p+i+3,v3);
+			}
+		}
+		else
+		{
+			for(size_t i = 0;i<body;i+=64,off = __fill_next(off,period))
+			{
+				const __m128i* s = reinterpret_cast<const __m128i*>(rotated+off);
+				__m128i* d = reinterpret_cast<__m128i*>(dst+i);
+				_mm_store_si128(d,_mm_loadu_si128(s));
+				_mm_store_si128(d+1,_mm_loadu_si128(s+1));
+				_mm_store_si128(d+2,_mm_loadu_si128(s+2));
+				_mm_store_si128(d+3,_mm_loadu_si128(s+3));
+			}
+		}
+		__fill_bytes(dst+body,bytes-body,rotated,period,off);
+	}
+
+	__attribute__((target("avx2")))
+	inline void __fill_kernel_avx2(unsigned char* dst,size_t bytes,const unsigned char* pattern,size_t period,bool nt)
+	{
+		unsigned char rotated[__SIMD_MAX_PERIOD];
+		size_t head = __fill_head(dst,bytes,pattern,period,rotated);
+		dst += head;
+		bytes -= head;
+		size_t body = bytes & ~size_t(63),off = 0;
+		if(nt)
+		{
+			for(size_t i = 0;i<body;i+=64,off = __fill_next(off,period))
+			{
+				const __m256i* s = reinterpret_cast<const __m256i*>(rotated+off);
+				__m256i* d = reinterpret_cast<__m256i*>(dst+i);
+				_mm256_stream_si256(d,_mm256_loadu_si256(s));
+				_mm256_stream_si256(d+1,_mm256_loadu_si256(s+1));
+			}
+			_mm_sfence();
+		}
+		else if(period == 64)
+		{
+			const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rotated));
+			const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rotated+32));
+			__m256i* p = reinterpret_cast<__m256i*>(dst);
+			for(size_t i = 0;i<body/32;i+=2)
+			{
+				_mm256_store_si256(p+i,v0);
+				_mm256_store_si256(p+i+1,v1);
+			}
+		}
+		else
+		{
+			for(size_t i = 0;i<body;i+=64,off = __fill_next(off,period))
+			{
+				const __m256i* s = reinterpret_cast<const __m256i*>(rotated+off);
+				__m256i* d = reinterpret_cast<__m256i*>(dst+i);
+				_mm256_store_si256(d,_mm256_loadu_si256(s));
+				_mm256_store_si256(d+1,_mm256_loadu_si256(s+1));
+			}
+		}
+		__fill_bytes(dst+body,bytes-body,rotated,period,off);
+	}
+
+	__attribute__((target("avx512f")))
+	inline void __fill_kernel_avx512(unsigned char* dst,size_t bytes,const unsigned char* pattern,size_t period,bool nt)
+	{
+		unsigned char rotated[__SIMD_MAX_PERIOD];
+		size_t head = __fill_head(dst,bytes,pattern,period,rotated);
+		dst += head;
+		bytes -= head;
+		size_t body = bytes & ~size_t(63),off = 0;
+		if(nt)
+		{
+			for(size_t i = 0;i<body;i+=64,off = __fill_next(off,period))
+				_mm512_stream_si512(reinterpret_cast<__m512i*>(dst+i),_mm512_loadu_si512(rotated+off));
+			_mm_sfence();
+		}
+		else if(period == 64)
+		{
+			const __m512i v = _mm512_loadu_si512(rotated);
+			for(size_t i = 0;i<body;i+=64)
+				_mm512_store_si512(dst+i,v);
+		}
+		else
+		{
+			for(size_t i = 0;i<body;i+=64,off = __fill_next(off,period))
+				_mm512_store_si512(dst+i,_mm512_loadu_si512(rotated+off));
+		}
+		__fill_bytes(dst+body,bytes-body,rotated,period,off);
+	}
+#endif
+
+	inline __fill_kernel __select_fill_kernel()
+	{
+#ifdef LZ_STL_SIMD_X86
+		switch(simd_level())
+		{
+			case __SIMD_AVX512: return &__fill_kernel_avx512;
+			case __SIMD_AVX2:   return &__fill_kernel_avx2;
+			case __SIMD_SSE2:   return &__fill_kernel_sse2;
+			default: break;
+		}
+#endif
+		return &__fill_kernel_scalar;
+	}
+
+	inline __fill_kernel __fill_kernel_for_cpu()
+	{
+		static const __fill_kernel kernel = __select_fill_kernel();
+		return kernel;
+	}
+
+	// -------------------------- 非临时复制内核 --------------------------
+	// 目标先用 memcpy 对齐到 64 字节，主体每次读 64 字节（非对齐）、流式写 64 字节
+	typedef void (*__copy_kernel)(unsigned char* dst,const unsigned char* src,size_t bytes);
+
+	inline size_t __copy_head(unsigned char* dst,const unsigned char* src,size_t bytes)
+	{
+		size_t head = (64 - (reinterpret_cast<size_t>(dst) & 63)) & 63;
+		if(head > bytes) head = bytes;
+		std::memcpy(dst,src,head);
+		return head;
+	}
+
+	inline void __copy_kernel_scalar(unsigned char* dst,const unsigned char* src,size_t bytes)
+	{
+		std::memcpy(dst,src,bytes);
+	}
+
+#ifdef LZ_STL_SIMD_X86
+	__attribute__((target("sse2")))
+	inline void __copy_kernel_sse2(unsigned char* dst,const unsigned char* src,size_t bytes)
+	{
+		size_t head = __copy_head(dst,src,bytes);
+		dst += head;
+		src += head;
+		bytes -= head;
+		size_t body = bytes & ~size_t(63);
+		for(size_t i = 0;i<body;i+=64)
+		{
+			const __m128i* s = reinterpret_cast<const __m128i*>(src+i);
+			__m128i* d = reinterpret_cast<__m128i*>(dst+i);
+			__m128i v0 = _mm_loadu_si128(s),v1 = _mm_loadu_si128(s+1),v2 = _mm_loadu_si128(s+2),v3 = _mm_loadu_si128(s+3);
+			_mm_stream_si128(d,v0);
+			_mm_stream_si128(d+1,v1);
+			_mm_stream_si128(d+2,v2);
+			_mm_stream_si128(d+3,v3);
+		}
+		_mm_sfence();
+		std::memcpy(dst+body,src+body,bytes-body);
+	}
+
+	__attribute__((target("avx2")))
+	inline void __copy_kernel_avx2(unsigned char* dst,const unsigned char* src,size_t bytes)
+	{
+		size_t head = __copy_head(dst,src,bytes);
+		dst += head;
+		src += head;
+		bytes -= head;
+		size_t body = bytes & ~size_t(63);
+		for(size_t i = 0;i<body;i+=64)
+		{
+			const __m256i* s = reinterpret_cast<const __m256i*>(src+i);
+			__m256i* d = reinterpret_cast<__m256i*>(dst+i);
+			__m256i v0 = _mm256_loadu_si256(s),v1 = _mm256_loadu_si256(s+1);
+			_mm256_stream_si256(d,v0);
+			_mm256_stream_si256(d+1,v1);
+		}
+		_mm_sfence();
+		std::memcpy(dst+body,src+body,bytes-body);
+	}
+
+	__attribute__((target("avx512f")))
+	inline void __copy_kernel_avx512(unsigned char* dst,const unsigned char* src,size_t bytes)
+	{
+		size_t head = __copy_head(dst,src,bytes);
+		dst += head;
+		src += head;
+		bytes -= head;
+		size_t body = bytes & ~size_t(63);
+		for(size_t i = 0;i<body;i+=64)
+			_mm512_stream_si512(reinterpret_cast<__m512i*>(dst+i),_mm512_loadu_si512(src+i));
+		_mm_sfence();
+		std::memcpy(dst+body,src+body,bytes-body);
+	}
+#endif
+
+	inline __copy_kernel __select_copy_kernel()
+	{
+#ifdef LZ_STL_SIMD_X86
+		switch(simd_level())
+		{
+			case __SIMD_AVX512: return &__copy_kernel_avx512;
+			case __SIMD_AVX2:   return &__copy_kernel_avx2;
+			case __SIMD_SSE2:   return &__copy_kernel_sse2;
+			default: break;
+		}
+#endif
+		return &__copy_kernel_scalar;
+	}
+
+	inline __copy_kernel __copy_kernel_for_cpu()
+	{
+		static const __copy_kernel kernel = __select_copy_kernel();
+		return kernel;
+	}
+
+	// -------------------------- 对外接口 --------------------------
+	// 复制 bytes 字节（两块内存不重叠），nt 指定是否使用非临时存储
+	inline void __simd_copy(void* dst,const void* src,size_t bytes,bool nt)
+	{
+		if(bytes == 0)
+			return;		// memcpy 不接受空指针，空 vector 的 data() 正是 nullptr
+		if(!nt)
+			std::memcpy(dst,src,bytes);
+		else
+			__copy_kernel_for_cpu()(static_cast<unsigned char*>(dst),static_cast<const unsigned char*>(src),bytes);
+	}
+
+	// 复制 bytes 字节（两块内存不重叠），超过阈值时使用非临时存储
+	inline void simd_copy(void* dst,const void* src,size_t bytes)
+	{
+		__simd_copy(dst,src,bytes,bytes >= nontemporal_threshold());
+	}
+
+	constexpr size_t __simd_gcd(size_t a,size_t b) {return b == 0 ? a : __simd_gcd(b,a % b);}
+
+	// 元素大小能否走 SIMD 填充：花样周期取元素大小与 64 的最小公倍数（12、24 字节的元素是 192），不能太长
+	template <typename T>
+	struct __simd_fillable
+	{
+		static const size_t period = sizeof(T) / __simd_gcd(sizeof(T),64) * 64;
+		static const bool value = period <= __SIMD_MAX_PERIOD;
+	};
+
+	// 在 [first, first+n) 上按字节复制 value 填充，T 必须是 POD；nt 指定是否使用非临时存储
+	template <typename T>
+	inline void __simd_fill(T* first,size_t n,const T& value,bool nt)
+	{
+		const size_t bytes = n * sizeof(T);
+		const unsigned char* src = reinterpret_cast<const unsigned char*>(&value);
+
+		// 所有字节都相同：memset
+		bool same = true;
+		for(size_t i = 1;i<sizeof(T) && same;++i)
+			same = src[i] == src[0];
+		if(same && !nt)
+		{
+			std::memset(first,src[0],bytes);
+			return;
+		}
+
+		if(!__simd_fillable<T>::value)
+		{
+			for(size_t i = 0;i<n;++i)
+				std::memcpy(first+i,&value,sizeof(T));
+			return;
+		}
+		const size_t period = __simd_fillable<T>::period;
+		unsigned char pattern[__SIMD_MAX_PERIOD];
+		for(size_t i = 0;i<period;i+=sizeof(T))
+			std::memcpy(pattern+i,&value,sizeof(T));
+		__fill_kernel_for_cpu()(reinterpret_cast<unsigned char*>(first),bytes,pattern,period,nt);
+	}
+
+	// 同上，超过阈值时使用非临时存储
+	template <typename T>
+	inline void simd_fill(T* first,size_t n,const T& value)
+	{
+		__simd_fill(first,n,value,n * sizeof(T) >= nontemporal_threshold());
+	}
+}
+
+#endif
@@ -0,0 +1,555 @@
+#ifndef LZ_STL_SOA_VECTOR_H
+#define LZ_STL_SOA_VECTOR_H
+
+/*
+soa_vector：数组结构体（Structure of Arrays）
+为什么需要？
+vector<Record> 是 “结构体数组”（AoS），一条记录的所有字段挨在一起
+只扫描其中 1~2 个字段时，cache line 里其余字段也被一起搬进缓存，浪费带宽
+
+soa_vector<A,B,C> 把每个字段单独放进一段连续内存（一列）
+	_columns = { A* , B* , C* }，三列共用同一个 size/capacity
+	扫描某一列时，cache line 里装的全是有用数据，可以直接交给 SIMD 循环
+
+接口与 lzstl::vector 保持一致：push_back/insert/erase/resize/reserve...
+迭代器是 “拉链式” 代理迭代器：解引用得到 std::tuple<A&,B&,C&>
+每一列的裸指针通过 data<I>() 取得
+*/
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "type_traits.h"
+#include "alloc.h"
+#include "iterator.h"
+#include "construct.h"
+#include "uninitialized.h"
+
+namespace lzstl
+{
+	// 单列的内存操作（与列数无关，供 basic_soa_vector 逐列调用）
+	template <typename Alloc>
+	struct __soa_column
+	{
+		template <typename T>
+		static T* allocate(size_t n)
+		{
+			return n == 0 ? nullptr : static_cast<T*>(Alloc::allocate(n*sizeof(T)));
+		}
+
+		template <typename T>
+		static void deallocate(T* p,size_t n)
+		{
+			if(p)
+				Alloc::deallocate(p,n*sizeof(T));
+		}
+
+		// 在 [col, col+size) 的 pos 处空出一个位置并放入 value（容量已保证足够）
+		// 调用方保证 value 不引用本列中的元素
+		// 抛异常时本列仍是 size 个元素：value 先在列外复制好，后移中途移动赋值抛异常就把已后移的移回去
+		template <typename T>
+		static void insert(T* col,size_t size,size_t pos,const T& value)
+		{
+			if(pos == size)
+			{
+				lzstl::construct(col+size,value);
+				return;
+			}
+			T tmp(value);
+			lzstl::construct(col+size,std::move(col[size-1]));
+			size_t i = size-1;
+			try
+			{
+				for(;i>pos;--i)
+					col[i] = std::move(col[i-1]);
+				col[pos] = std::move(tmp);
+			}
+			catch(...)
+			{
+				// (i, size] 上是后移了一位的原元素
+				for(;i<size;++i)
+					col[i] = std::move(col[i+1]);
+				lzstl::destroy(col+size);
+				throw;
+			}
+		}
+
+		// insert 的逆操作：删除 [first, last)，后面的元素前移
+		template <typename T>
+		static void erase(T* col,size_t size,size_t first,size_t last)
+		{
+			size_t n = last-first;
+			for(size_t i = last;i<size;++i)
+				col[i-n] = std::move(col[i]);
+			lzstl::destroy_n(col+size-n,n);
+		}
+
+		// 扩容时把 [first, first+n) 搬到未初始化的 result
+		// 移动可能抛异常而又能复制时改为复制（同 vector 扩容），抛异常时旧元素原样保留
+		template <typename T>
+		static void relocate(T* first,size_t n,T* result)
+		{
+			relocate(first,n,result,typename __bool_type<std::is_nothrow_move_constructible<T>::value
+												  || !is_copy_constructible<T>::value>::type());
+		}
+
+		template <typename T>
+		static void relocate(T* first,size_t n,T* result,true_type)
+		{
+			lzstl::uninitialized_move(first,first+n,result);
+		}
+
+		template <typename T>
+		static void relocate(T* first,size_t n,T* result,false_type)
+		{
+			lzstl::uninitialized_copy(first,first+n,result);
+		}
+	};
+
+	template <typename Alloc,typename... Ts>
+	class basic_soa_vector
+	{
+		static_assert(sizeof...(Ts) > 0,"soa_vector 至少需要一列");
+	public:
+		typedef std::tuple<Ts...>			value_type;
+		typedef std::tuple<Ts&...>			reference;
+		typedef std::tuple<const Ts&...>	const_reference;
+		typedef size_t						size_type;
+		typedef ptrdiff_t					difference_type;
+		typedef Alloc						allocator_type;
+
+		// 第 I 列的元素类型
+		template <size_t I>
+		using column_type = typename std::tuple_element<I,std::tuple<Ts...>>::type;
+
+		// -------------------------- 拉链式代理迭代器 --------------------------
+		// 只保存 “容器指针 + 下标”，解引用时再把各列的同一行拼成 tuple
+		template <bool IsConst>
+		class __iterator
+		{
+			friend class basic_soa_vector;
+			typedef typename std::conditional<IsConst,const basic_soa_vector*,basic_soa_vector*>::type container_pointer;
+
+			container_pointer _owner;
+			ptrdiff_t         _idx;
+
+			__iterator(container_pointer owner,ptrdiff_t idx):_owner(owner),_idx(idx){}
+		public:
+			typedef random_access_iterator_tag		iterator_category;
+			typedef basic_soa_vector::value_type	value_type;
+			typedef ptrdiff_t						difference_type;
+			typedef void							pointer;
+			typedef typename std::conditional<IsConst,basic_soa_vector::const_reference,
+											  basic_soa_vector::reference>::type reference;
+
+			__iterator():_owner(nullptr),_idx(0){}
+			// iterator 可隐式转换为 const_iterator
+			__iterator(const __iterator<false>& rhs):_owner(rhs._owner),_idx(rhs._idx){}
+
+			reference operator*() const {return (*_owner)[_idx];}
+			reference operator[](difference_type n) const {return (*_owner)[_idx+n];}
+
+			__iterator& operator++() {++_idx;return *this;}
+			__iterator operator++(int) {__iterator tmp = *this;++_idx;return tmp;}
+			__iterator& operator--() {--_idx;return *this;}
+			__iterator operator--(int) {__iterator tmp = *this;--_idx;return tmp;}
+			__iterator& operator+=(difference_type n) {_idx += n;return *this;}
+			__iterator& operator-=(difference_type n) {_idx -= n;return *this;}
+			__iterator operator+(difference_type n) const {return __iterator(_owner,_idx+n);}
+			__iterator operator-(difference_type n) const {return __iterator(_owner,_idx-n);}
+			difference_type operator-(const __iterator& rhs) const {return _idx-rhs._idx;}
+
+			bool operator==(const __iterator& rhs) const {return _idx == rhs._idx;}
+			bool operator!=(const __iterator& rhs) const {return _idx != rhs._idx;}
+			bool operator<(const __iterator& rhs) const {return _idx < rhs._idx;}
+			bool operator>(const __iterator& rhs) const {return _idx > rhs._idx;}
+			bool operator<=(const __iterator& rhs) const {return _idx <= rhs._idx;}
+			bool operator>=(const __iterator& rhs) const {return _idx >= rhs._idx;}
+
+			// 当前行在容器中的下标
+			size_type index() const {return _idx;}
+		};
+
+		typedef __iterator<false>	iterator;
+		typedef __iterator<true>	const_iterator;
+
+	private:
+		typedef std::index_sequence_for<Ts...> __indices;
+
+		std::tuple<Ts*...> _columns;		// 每列一段连续内存
+		size_type _size;
+		size_type _capacity;
+
+		// -------------------------- 内部辅助函数 --------------------------
+		// 对每一列调用 f(列指针, 列号)
+		template <typename F,size_t... I>
+		void _for_each_column(F&& f,std::index_sequence<I...>)
+		{
+			int dummy[] = {0,(f(std::get<I>(_columns),I),0)...};
+			(void)dummy;
+		}
+		template <typename F>
+		void _for_each_column(F&& f)
+		{
+			_for_each_column(std::forward<F>(f),__indices());
+		}
+
+		// 对每一列调用 f(列指针, 该列对应的值, 列号)
+		template <typename F,typename Tuple,size_t... I>
+		void _for_each_column_with(F&& f,Tuple& values,std::index_sequence<I...>)
+		{
+			int dummy[] = {0,(f(std::get<I>(_columns),std::get<I>(values),I),0)...};
+			(void)dummy;
+		}
+
+		// 按某一行构造 tuple 引用
+		template <size_t... I>
+		reference _row(size_type idx,std::index_sequence<I...>)
+		{
+			return reference(std::get<I>(_columns)[idx]...);
+		}
+		template <size_t... I>
+		const_reference _row(size_type idx,std::index_sequence<I...>) const
+		{
+			return const_reference(std::get<I>(_columns)[idx]...);
+		}
+
+		// 释放所有列（调用前元素已析构）
+		void _deallocate()
+		{
+			size_type cap = _capacity;
+			_for_each_column([cap](auto* col,size_t){__soa_column<Alloc>::deallocate(col,cap);});
+		}
+
+		// 扩容：每列各自分配新内存，把旧元素移动过去
+		void _reallocate(size_type new_capacity)
+		{
+			if(new_capacity <= _capacity) return;
+
+			// 1. 逐列分配，任何一列失败都要把已分配的列还回去
+			std::tuple<Ts*...> new_columns;
+			size_t allocated = 0;
+			try
+			{
+				_allocate_columns(new_columns,new_capacity,allocated,__indices());
+			}
+			catch(...)
+			{
+				_deallocate_columns(new_columns,new_capacity,allocated,__indices());
+				throw;
+			}
+
+			// 2. 逐列移动旧元素，销毁并释放旧列；搬不过去时释放新列，本对象不变
+			if(_size > 0)
+			{
+				try
+				{
+					_move_columns(new_columns,__indices());
+				}
+				catch(...)
+				{
+					_deallocate_columns(new_columns,new_capacity,sizeof...(Ts),__indices());
+					throw;
+				}
+			}
+			_deallocate();
+			_columns = new_columns;
+			_capacity = new_capacity;
+		}
+
+		template <size_t... I>
+		void _allocate_columns(std::tuple<Ts*...>& cols,size_type n,size_t& allocated,std::index_sequence<I...>)
+		{
+			int dummy[] = {0,((std::get<I>(cols) = nullptr),0)...};
+			int dummy2[] = {0,((std::get<I>(cols) = __soa_column<Alloc>::template allocate<Ts>(n)),++allocated,0)...};
+			(void)dummy;(void)dummy2;
+		}
+
+		template <size_t... I>
+		void _deallocate_columns(std::tuple<Ts*...>& cols,size_type n,size_t count,std::index_sequence<I...>)
+		{
+			int dummy[] = {0,((I < count ? __soa_column<Alloc>::deallocate(std::get<I>(cols),n) : void()),0)...};
+			(void)dummy;
+		}
+
+		// 所有列都搬完才析构旧元素；某列抛异常时析构已搬好的新列，旧列原样保留
+		template <size_t... I>
+		void _move_columns(std::tuple<Ts*...>& cols,std::index_sequence<I...>)
+		{
+			size_t done = 0;
+			size_type sz = _size;
+			try
+			{
+				int dummy[] = {0,(__soa_column<Alloc>::relocate(std::get<I>(_columns),sz,std::get<I>(cols)),++done,0)...};
+				(void)dummy;
+			}
+			catch(...)
+			{
+				int dummy[] = {0,((I < done ? lzstl::destroy(std::get<I>(cols),std::get<I>(cols)+sz) : void()),0)...};
+				(void)dummy;
+				throw;
+			}
+			_for_each_column([sz](auto* col,size_t){lzstl::destroy(col,col+sz);});
+		}
+
+		// 逐列拷贝 rhs 的元素到本对象（容量已足够）；失败时析构已拷贝的列
+		template <size_t... I>
+		void _copy_columns(const basic_soa_vector& rhs,std::index_sequence<I...>)
+		{
+			size_t done = 0;
+			try
+			{
+				int dummy[] = {0,(lzstl::uninitialized_copy(std::get<I>(rhs._columns),std::get<I>(rhs._columns)+rhs._size,
+													 std::get<I>(_columns)),++done,0)...};
+				(void)dummy;
+			}
+			catch(...)
+			{
+				size_type n = rhs._size;
+				_for_each_column([n,done](auto* col,size_t i)
+				{
+					if(i < done)
+						lzstl::destroy(col,col+n);
+				});
+				throw;
+			}
+		}
+
+		// 与 vector 相同的增长策略：2倍扩容，最小1
+		void _ensure_capacity(size_type n)
+		{
+			if(n > _capacity)
+			{
+				size_type new_cap = (_capacity == 0) ? 1 : _capacity * 2;
+				if(new_cap < n)
+					new_cap = n;
+				_reallocate(new_cap);
+			}
+		}
+
+		// 在 pos 处插入一行；某列抛异常时把已插入的列撤销，保持各列长度一致
+		template <typename Tuple>
+		void _insert_row(size_type pos,Tuple values)
+		{
+			size_t done = 0;
+			size_type sz = _size;
+			try
+			{
+				_for_each_column_with([sz,pos,&done](auto* col,const auto& value,size_t)
+				{
+					__soa_column<Alloc>::insert(col,sz,pos,value);
+					++done;
+				},values,__indices());
+			}
+			catch(...)
+			{
+				_for_each_column([sz,pos,done](auto* col,size_t i)
+				{
+					if(i < done)
+						__soa_column<Alloc>::erase(col,sz+1,pos,pos+1);
+				});
+				throw;
+			}
+			++_size;
+		}
+
+	public:
+		// -------------------------- 构造函数/析构函数/赋值运算符 --------------------------
+		basic_soa_vector():_columns(),_size(0),_capacity(0){}
+
+		// 构造n行，每列都是值初始化
+		explicit basic_soa_vector(size_type n):_columns(),_size(0),_capacity(0)
+		{
+			resize(n);
+		}
+
+		basic_soa_vector(const basic_soa_vector& rhs):_columns(),_size(0),_capacity(0)
+		{
+			reserve(rhs._size);
+			_copy_columns(rhs,__indices());
+			_size = rhs._size;
+		}
+
+		basic_soa_vector(basic_soa_vector&& rhs):_columns(rhs._columns),_size(rhs._size),_capacity(rhs._capacity)
+		{
+			rhs._columns = std::tuple<Ts*...>();
+			rhs._size = rhs._capacity = 0;
+		}
+
+		~basic_soa_vector()
+		{
+			clear();
+			_deallocate();
+		}
+
+		// 拷贝后交换，天然处理自赋值与异常安全
+		basic_soa_vector& operator=(const basic_soa_vector& rhs)
+		{
+			if(this != &rhs)
+			{
+				basic_soa_vector tmp(rhs);
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		basic_soa_vector& operator=(basic_soa_vector&& rhs)
+		{
+			if(this != &rhs)
+			{
+				basic_soa_vector tmp(std::move(rhs));
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		void swap(basic_soa_vector& rhs)
+		{
+			std::swap(_columns,rhs._columns);
+			std::swap(_size,rhs._size);
+			std::swap(_capacity,rhs._capacity);
+		}
+
+		// -------------------------- 迭代器接口 --------------------------
+		iterator begin() {return iterator(this,0);}
+		const_iterator begin() const {return const_iterator(this,0);}
+		iterator end() {return iterator(this,_size);}
+		const_iterator end() const {return const_iterator(this,_size);}
+
+		// -------------------------- 容量与大小操作 --------------------------
+		size_type size() const {return _size;}
+		size_type capacity() const {return _capacity;}
+		bool empty() const {return _size == 0;}
+
+		void reserve(size_type n)
+		{
+			if(n > _capacity)
+				_reallocate(n);
+		}
+
+		// 调整行数：缩小时逐列析构，扩大时逐列填充 values
+		void resize(size_type n,const Ts&... values)
+		{
+			if(n < _size)
+			{
+				size_type sz = _size;
+				_for_each_column([n,sz](auto* col,size_t){lzstl::destroy_n(col+n,sz-n);});
+				_size = n;
+			}
+			else if(n > _size)
+			{
+				_ensure_capacity(n);
+				auto vals = std::forward_as_tuple(values...);
+				size_t done = 0;
+				size_type sz = _size;
+				try
+				{
+					_for_each_column_with([n,sz,&done](auto* col,const auto& value,size_t)
+					{
+						lzstl::uninitialized_fill_n(col+sz,n-sz,value);
+						++done;
+					},vals,__indices());
+				}
+				catch(...)
+				{
+					_for_each_column([n,sz,done](auto* col,size_t i)
+					{
+						if(i < done)
+							lzstl::destroy(col+sz,col+n);
+					});
+					throw;
+				}
+				_size = n;
+			}
+		}
+		void resize(size_type n)
+		{
+			resize(n,Ts()...);
+		}
+
+		void clear()
+		{
+			size_type sz = _size;
+			_for_each_column([sz](auto* col,size_t){lzstl::destroy_n(col,sz);});
+			_size = 0;
+		}
+
+		// -------------------------- 元素访问 --------------------------
+		reference operator[](size_type idx) {return _row(idx,__indices());}
+		const_reference operator[](size_type idx) const {return _row(idx,__indices());}
+
+		reference front() {return (*this)[0];}
+		const_reference front() const {return (*this)[0];}
+		reference back() {return (*this)[_size-1];}
+		const_reference back() const {return (*this)[_size-1];}
+
+		// 第 I 列的连续内存，可直接交给 SIMD 循环
+		template <size_t I>
+		column_type<I>* data() {return std::get<I>(_columns);}
+		template <size_t I>
+		const column_type<I>* data() const {return std::get<I>(_columns);}
+
+		// -------------------------- 元素插入/删除 --------------------------
+		void push_back(const Ts&... values)
+		{
+			if(_size == _capacity)
+			{
+				// 扩容会释放旧列，values 可能正引用旧列中的元素，先复制出来
+				std::tuple<Ts...> row(values...);
+				_ensure_capacity(_size+1);
+				_insert_row(_size,row);
+			}
+			else
+				_insert_row(_size,std::tuple<const Ts&...>(values...));
+		}
+
+		void pop_back()
+		{
+			if(!empty())
+			{
+				--_size;
+				size_type sz = _size;
+				_for_each_column([sz](auto* col,size_t){lzstl::destroy(col+sz,col+sz+1);});
+			}
+		}
+
+		// pos 处插入一行
+		iterator insert(const_iterator pos,const Ts&... values)
+		{
+			size_type idx = pos._idx;
+			// 先把值复制出来：values 可能引用本容器中的元素（移动或扩容后失效）
+			std::tuple<Ts...> row(values...);
+			_ensure_capacity(_size+1);
+			_insert_row(idx,row);
+			return iterator(this,idx);
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			return erase(pos,pos+1);
+		}
+
+		iterator erase(const_iterator first,const_iterator last)
+		{
+			size_type f = first._idx;
+			size_type l = last._idx;
+			if(f != l)
+			{
+				size_type sz = _size;
+				_for_each_column([sz,f,l](auto* col,size_t){__soa_column<Alloc>::erase(col,sz,f,l);});
+				_size -= l-f;
+			}
+			return iterator(this,f);
+		}
+
+		// -------------------------- 分配器相关 --------------------------
+		allocator_type get_allocator() const {return allocator_type();}
+	};
+
+	// 默认使用二级配置器；需要其它配置器时直接用 basic_soa_vector<Alloc,Ts...>
+	template <typename... Ts>
+	using soa_vector = basic_soa_vector<alloc,Ts...>;
+}
+
+#endif
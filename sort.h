@@ -0,0 +1,427 @@
+#ifndef LZ_STL_SORT_H
+#define LZ_STL_SORT_H
+
+/*
+排序算法：并行 LSD 基数排序 + 并行归并排序
+为什么需要？
+每批要对上亿元素的 vector<uint64_t> / vector<Record> 按键排序，单线程 std::sort 是瓶颈
+
+1.radix_sort / radix_sort_by_key：LSD 基数排序，按字节从低到高做 8 趟稳定分配，O(n)
+	键类型由 is_integral / is_floating_point 在编译期选择转换方式，统一映射成无符号整数：
+		无符号整数  原样
+		有符号整数  翻转符号位      （负数排在正数前面）
+		浮点数      负数全部取反，非负数只翻转符号位（IEEE754 按位比较即按值比较）
+	某个字节上所有元素都相同（例如高位全 0），这一趟直接跳过
+	并行：每个线程负责一段，先各自统计直方图，再由前缀和算出每个线程在每个桶里的写入起点，
+		  各线程独立分配，结果仍然稳定；线程来自 default_thread_pool()，默认段数为硬件线程数
+2.parallel_merge_sort：任意比较器的稳定归并排序
+	先把区间切成 threads 段各自排序，再逐轮两两归并
+	每轮把所有段对（以及落单的段）的输出一起切成 threads 块，用 “归并路径”（merge path）二分定位，
+	一次 parallel_for 做完，所有线程都有活干
+
+两者的辅助空间都从 Alloc 申请
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include "type_traits.h"
+#include "alloc.h"
+#include "iterator.h"
+#include "construct.h"
+#include "uninitialized.h"
+#include "thread_pool.h"
+
+namespace lzstl
+{
+	// -------------------------- 线程辅助 --------------------------
+	// 执行 f(0) ... f(nthreads-1)，全部完成后返回
+	// 交给全局线程池，不再每趟现开线程；各段互不依赖，线程池线程不够（或在任务里嵌套调用）时串行执行也正确
+	template <typename F>
+	inline void __run_parallel(unsigned nthreads,F f)
+	{
+		if(nthreads <= 1)
+		{
+			f(0u);
+			return;
+		}
+		default_thread_pool().parallel_for(nthreads,[&f](size_t t) {f(unsigned(t));});
+	}
+
+	inline unsigned __default_sort_threads()
+	{
+		unsigned hw = std::thread::hardware_concurrency();
+		return hw ? hw : 1;
+	}
+
+	// -------------------------- 键 -> 无符号整数 --------------------------
+	template <size_t Bytes> struct __radix_unsigned;
+	template <> struct __radix_unsigned<1> {typedef unsigned char type;};
+	template <> struct __radix_unsigned<2> {typedef unsigned short type;};
+	template <> struct __radix_unsigned<4> {typedef unsigned int type;};
+	template <> struct __radix_unsigned<8> {typedef unsigned long long type;};
+
+	template <typename Key>
+	struct __radix_key
+	{
+		typedef typename __radix_unsigned<sizeof(Key)>::type type;
+		static const type sign_bit = type(type(1) << (sizeof(Key)*8 - 1));
+
+		static type to_unsigned(Key k)
+		{
+			return __convert(k,is_integral<Key>(),is_floating_point<Key>());
+		}
+	private:
+		// 整数：有符号的翻转符号位
+		static type __convert(Key k,true_type,false_type)
+		{
+			return Key(-1) < Key(0) ? type(type(k) ^ sign_bit) : type(k);
+		}
+		// 浮点：负数全部取反，非负数翻转符号位
+		static type __convert(Key k,false_type,true_type)
+		{
+			type bits;
+			std::memcpy(&bits,&k,sizeof(Key));
+			return (bits & sign_bit) ? type(~bits) : type(bits | sign_bit);
+		}
+	};
+
+	// 元素本身就是键
+	template <typename T>
+	struct __radix_identity
+	{
+		const T& operator()(const T& x) const {return x;}
+	};
+
+	// -------------------------- LSD 基数排序 --------------------------
+	template <typename Alloc,typename T,typename KeyOf>
+	void __radix_sort(T* data,size_t n,KeyOf key_of,unsigned nthreads)
+	{
+		typedef typename remove_cv<typename std::decay<decltype(key_of(*data))>::type>::type key_type;
+		static_assert(is_integral<key_type>::value || is_floating_point<key_type>::value,
+					  "radix_sort 的键必须是整数或浮点数");
+		static_assert(sizeof(key_type) <= 8,"radix_sort 的键最多 8 字节");
+		typedef __radix_key<key_type> conv;
+		typedef typename conv::type ukey;
+		enum {PASSES = sizeof(key_type),RADIX = 256};
+
+		if(n < 2) return;
+		if(nthreads == 0) nthreads = 1;
+		if(n < (size_t)nthreads * 4096) nthreads = 1;	// 太小不值得开线程
+
+		// 各线程、各趟的直方图：hist[t][pass][digit]
+		size_t* hist = static_cast<size_t*>(malloc_alloc::allocate(nthreads*PASSES*RADIX*sizeof(size_t)));
+		std::memset(hist,0,nthreads*PASSES*RADIX*sizeof(size_t));
+
+		// 1. 一次扫描统计所有字节的直方图，用来判断哪些趟可以跳过
+		__run_parallel(nthreads,[&](unsigned t)
+		{
+			size_t* h = hist + (size_t)t*PASSES*RADIX;
+			for(size_t i = __chunk_begin(n,nthreads,t);i<__chunk_begin(n,nthreads,t+1);++i)
+			{
+				ukey k = conv::to_unsigned(key_of(data[i]));
+				for(unsigned p = 0;p<PASSES;++p)
+					++h[p*RADIX + ((k >> (p*8)) & 0xFF)];
+			}
+		});
+		bool need_pass[PASSES];
+		for(unsigned p = 0;p<PASSES;++p)
+		{
+			need_pass[p] = true;
+			for(unsigned d = 0;d<RADIX;++d)
+			{
+				size_t total = 0;
+				for(unsigned t = 0;t<nthreads;++t)
+					total += hist[((size_t)t*PASSES + p)*RADIX + d];
+				if(total == n)
+				{
+					need_pass[p] = false;	// 所有元素这个字节都相同
+					break;
+				}
+			}
+		}
+
+		// 2. 辅助缓冲区：未初始化内存，元素在 data 与 buf 之间来回移动
+		T* buf = static_cast<T*>(Alloc::allocate(n*sizeof(T)));
+		T* src = data;
+		T* dst = buf;
+		size_t* offsets = static_cast<size_t*>(malloc_alloc::allocate(nthreads*RADIX*sizeof(size_t)));
+
+		for(unsigned p = 0;p<PASSES;++p)
+		{
+			if(!need_pass[p]) continue;
+			const unsigned shift = p*8;
+
+			// 2.1 当前数据分段后的直方图（数据每趟都会移动，第一趟之外要重新统计）
+			__run_parallel(nthreads,[&](unsigned t)
+			{
+				size_t* h = hist + (size_t)t*RADIX;
+				std::memset(h,0,RADIX*sizeof(size_t));
+				for(size_t i = __chunk_begin(n,nthreads,t);i<__chunk_begin(n,nthreads,t+1);++i)
+					++h[(conv::to_unsigned(key_of(src[i])) >> shift) & 0xFF];
+			});
+
+			// 2.2 前缀和：桶 d 中线程 t 的起点 = 所有更小桶的总数 + 前面线程在桶 d 中的个数
+			size_t sum = 0;
+			for(unsigned d = 0;d<RADIX;++d)
+				for(unsigned t = 0;t<nthreads;++t)
+				{
+					offsets[(size_t)t*RADIX + d] = sum;
+					sum += hist[(size_t)t*RADIX + d];
+				}
+
+			// 2.3 各线程稳定分配：移动构造到 dst，再析构 src 中的原对象
+			__run_parallel(nthreads,[&](unsigned t)
+			{
+				size_t* off = offsets + (size_t)t*RADIX;
+				for(size_t i = __chunk_begin(n,nthreads,t);i<__chunk_begin(n,nthreads,t+1);++i)
+				{
+					size_t pos = off[(conv::to_unsigned(key_of(src[i])) >> shift) & 0xFF]++;
+					lzstl::construct(dst + pos,std::move(src[i]));
+					lzstl::destroy(src + i);
+				}
+			});
+			std::swap(src,dst);
+		}
+
+		// 3. 奇数趟时结果在 buf 中，搬回原区间
+		if(src != data)
+		{
+			__run_parallel(nthreads,[&](unsigned t)
+			{
+				size_t b = __chunk_begin(n,nthreads,t),e = __chunk_begin(n,nthreads,t+1);
+				lzstl::uninitialized_move(src+b,src+e,data+b);
+				lzstl::destroy(src+b,src+e);
+			});
+		}
+
+		malloc_alloc::deallocate(offsets,nthreads*RADIX*sizeof(size_t));
+		malloc_alloc::deallocate(hist,nthreads*PASSES*RADIX*sizeof(size_t));
+		Alloc::deallocate(buf,n*sizeof(T));
+	}
+
+	// 对整数/浮点数区间做基数排序；[first, last) 必须是连续存储（如 lzstl::vector 的迭代器）
+	template <typename Alloc = alloc,typename RandomAccessIterator>
+	inline void radix_sort(RandomAccessIterator first,RandomAccessIterator last,unsigned nthreads = __default_sort_threads())
+	{
+		typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+		if(first == last) return;
+		__radix_sort<Alloc>(&*first,size_t(last-first),__radix_identity<value_type>(),nthreads);
+	}
+
+	// 按 key_of(元素) 返回的整数/浮点键排序，适合 vector<Record>
+	template <typename Alloc = alloc,typename RandomAccessIterator,typename KeyOf>
+	inline void radix_sort_by_key(RandomAccessIterator first,RandomAccessIterator last,KeyOf key_of,
+								  unsigned nthreads = __default_sort_threads())
+	{
+		if(first == last) return;
+		__radix_sort<Alloc>(&*first,size_t(last-first),key_of,nthreads);
+	}
+
+	// -------------------------- 并行归并排序 --------------------------
+	// 归并路径：合并结果的前 k 个元素中，有几个来自 a（相等时 a 优先，保证稳定）
+	template <typename T,typename Compare>
+	size_t __merge_path(const T* a,size_t na,const T* b,size_t nb,size_t k,Compare& comp)
+	{
+		size_t lo = k > nb ? k - nb : 0;
+		size_t hi = k < na ? k : na;
+		while(lo < hi)
+		{
+			size_t i = lo + (hi - lo + 1) / 2;
+			// a[i-1] 应该排在 b[k-i] 之前，否则 i 取大了
+			if(k - i < nb && comp(b[k-i],a[i-1]))
+				hi = i - 1;
+			else
+				lo = i;
+		}
+		return lo;
+	}
+
+	// 把 a、b 合并到 out（三者都是已构造的对象，按移动赋值）
+	template <typename T,typename Compare>
+	void __move_merge(T* a,T* a_end,T* b,T* b_end,T* out,Compare& comp)
+	{
+		while(a != a_end && b != b_end)
+		{
+			if(comp(*b,*a))
+				*out++ = std::move(*b++);
+			else
+				*out++ = std::move(*a++);
+		}
+		while(a != a_end) *out++ = std::move(*a++);
+		while(b != b_end) *out++ = std::move(*b++);
+	}
+
+	template <typename T,typename Compare>
+	void __insertion_sort(T* first,T* last,Compare& comp)
+	{
+		if(first == last) return;
+		for(T* i = first+1;i<last;++i)
+		{
+			T tmp = std::move(*i);
+			T* j = i;
+			for(;j>first && comp(tmp,*(j-1));--j)
+				*j = std::move(*(j-1));
+			*j = std::move(tmp);
+		}
+	}
+
+	// 单线程自底向上归并排序，buf 与 data 等长且都是已构造的对象；结果留在 data 中
+	template <typename T,typename Compare>
+	void __merge_sort_run(T* data,T* buf,size_t n,Compare& comp)
+	{
+		enum {RUN = 32};
+		for(size_t i = 0;i<n;i+=RUN)
+			__insertion_sort(data+i,data+(i+RUN < n ? i+RUN : n),comp);
+
+		T* src = data;
+		T* dst = buf;
+		for(size_t width = RUN;width<n;width*=2)
+		{
+			for(size_t i = 0;i<n;i+=2*width)
+			{
+				size_t mid = i+width < n ? i+width : n;
+				size_t end = i+2*width < n ? i+2*width : n;
+				__move_merge(src+i,src+mid,src+mid,src+end,dst+i,comp);
+			}
+			std::swap(src,dst);
+		}
+		if(src != data)
+			for(size_t i = 0;i<n;++i)
+				data[i] = std::move(src[i]);
+	}
+
+	// 一轮归并：src 中 [bounds[2p], bounds[2p+1]) 与 [bounds[2p+1], bounds[2p+2]) 两两归并到 dst，
+	// parts 为奇数时最后一段原样搬过去
+	// 整个输出区间 [0, n) 均分成 nthreads 块，一次 parallel_for 做完：每块可能跨几个段对，
+	// 块的起止点落在某个段对内部时，用归并路径二分出它在左段中的位置
+	// 切分点要在任何线程开始移动元素之前全部算好：移动会改写源对象（如 string 被清空），
+	// 别的线程此时再二分查找就会读到被移走的值
+	template <typename T,typename Compare>
+	void __merge_round(T* src,T* dst,size_t n,const size_t* bounds,unsigned parts,Compare& comp,unsigned nthreads)
+	{
+		const unsigned pairs = parts / 2;
+		const size_t merged_end = bounds[2*pairs];		// 之后是落单的段
+		// 位置 k 所在的段对（k < merged_end）
+		auto pair_of = [&](size_t k,unsigned from)
+		{
+			while(bounds[2*from+2] <= k)
+				++from;
+			return from;
+		};
+		size_t* split = static_cast<size_t*>(malloc_alloc::allocate((nthreads+1)*sizeof(size_t)));
+		unsigned* owner = static_cast<unsigned*>(malloc_alloc::allocate((nthreads+1)*sizeof(unsigned)));
+		unsigned p = 0;
+		for(unsigned t = 0;t<=nthreads;++t)
+		{
+			size_t k = __chunk_begin(n,nthreads,t);
+			split[t] = 0;
+			if(k < merged_end)
+			{
+				p = pair_of(k,p);
+				size_t b = bounds[2*p],m = bounds[2*p+1],e = bounds[2*p+2];
+				split[t] = __merge_path(src+b,m-b,src+m,e-m,k-b,comp);
+			}
+			owner[t] = p;
+		}
+		__run_parallel(nthreads,[&](unsigned t)
+		{
+			size_t k0 = __chunk_begin(n,nthreads,t),k1 = __chunk_begin(n,nthreads,t+1);
+			unsigned q = owner[t];
+			for(size_t pos = k0;pos<k1;)
+			{
+				if(pos >= merged_end)
+				{
+					for(;pos<k1;++pos)
+						dst[pos] = std::move(src[pos]);
+					break;
+				}
+				q = pair_of(pos,q);
+				size_t b = bounds[2*q],m = bounds[2*q+1],e = bounds[2*q+2];
+				size_t end = k1 < e ? k1 : e;
+				size_t i0 = pos == k0 ? split[t] : 0;
+				size_t i1 = k1 < e ? split[t+1] : m - b;
+				__move_merge(src+b+i0,src+b+i1,src+m+(pos-b-i0),src+m+(end-b-i1),dst+pos,comp);
+				pos = end;
+			}
+		});
+		malloc_alloc::deallocate(owner,(nthreads+1)*sizeof(unsigned));
+		malloc_alloc::deallocate(split,(nthreads+1)*sizeof(size_t));
+	}
+
+	template <typename Alloc,typename T,typename Compare>
+	void __parallel_merge_sort(T* data,size_t n,Compare comp,unsigned nthreads)
+	{
+		if(n < 2) return;
+		if(nthreads == 0) nthreads = 1;
+		if(n < (size_t)nthreads * 4096) nthreads = 1;
+
+		// 元素先整体移动构造到辅助缓冲区，之后两边都是有效对象，只做移动赋值
+		T* buf = static_cast<T*>(Alloc::allocate(n*sizeof(T)));
+		try
+		{
+			lzstl::uninitialized_move(data,data+n,buf);
+		}
+		catch(...)
+		{
+			Alloc::deallocate(buf,n*sizeof(T));
+			throw;
+		}
+
+		// 1. 每个线程排好自己的一段，结果在 buf 中（data 作为临时空间）
+		__run_parallel(nthreads,[&](unsigned t)
+		{
+			size_t b = __chunk_begin(n,nthreads,t),e = __chunk_begin(n,nthreads,t+1);
+			Compare c = comp;
+			__merge_sort_run(buf+b,data+b,e-b,c);
+		});
+
+		// 2. 逐轮两两归并：parts 段 -> (parts+1)/2 段，每轮所有段对和落单段一起切成 nthreads 块并行
+		// bounds[0..parts] 是当前各段的边界，每轮合并后只保留偶数位置的边界
+		size_t* bounds = static_cast<size_t*>(malloc_alloc::allocate((nthreads+1)*sizeof(size_t)));
+		for(unsigned t = 0;t<=nthreads;++t)
+			bounds[t] = __chunk_begin(n,nthreads,t);
+		T* src = buf;
+		T* dst = data;
+		for(unsigned parts = nthreads;parts>1;parts = (parts+1)/2)
+		{
+			__merge_round(src,dst,n,bounds,parts,comp,nthreads);
+			for(unsigned k = 0;2*k<=parts;++k)
+				bounds[k] = bounds[2*k];
+			bounds[(parts+1)/2] = n;
+			std::swap(src,dst);
+		}
+		malloc_alloc::deallocate(bounds,(nthreads+1)*sizeof(size_t));
+		if(src != data)
+			for(size_t i = 0;i<n;++i)
+				data[i] = std::move(src[i]);
+
+		lzstl::destroy(buf,buf+n);
+		Alloc::deallocate(buf,n*sizeof(T));
+	}
+
+	// 稳定的并行归并排序，比较器任意；[first, last) 必须是连续存储
+	template <typename Alloc = alloc,typename RandomAccessIterator,typename Compare>
+	inline void parallel_merge_sort(RandomAccessIterator first,RandomAccessIterator last,Compare comp,
+									unsigned nthreads = __default_sort_threads())
+	{
+		if(first == last) return;
+		__parallel_merge_sort<Alloc>(&*first,size_t(last-first),comp,nthreads);
+	}
+
+	template <typename T>
+	struct __sort_less
+	{
+		bool operator()(const T& a,const T& b) const {return a < b;}
+	};
+
+	template <typename Alloc = alloc,typename RandomAccessIterator>
+	inline void parallel_merge_sort(RandomAccessIterator first,RandomAccessIterator last)
+	{
+		typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+		parallel_merge_sort<Alloc>(first,last,__sort_less<value_type>());
+	}
+}
+
+#endif
@@ -0,0 +1,262 @@
+#ifndef LZ_STL_SPSC_RING_H
+#define LZ_STL_SPSC_RING_H
+
+/*
+spsc_ring：单生产者单消费者的无锁环形队列
+为什么需要？
+流水线的两级之间用互斥锁保护的队列交接数据，每个元素都要加锁、解锁，两个线程争同一把锁
+锁本身和锁所在的 cache line 在两个核之间来回传递，每秒只能交接几百万个元素
+
+做法：
+1.容量取 2 的幂，下标一直递增不回绕，槽位 = 下标 & (容量-1)；tail - head 就是元素个数
+2.只有生产者写 _tail，只有消费者写 _head，一个原子的 store(release) / load(acquire) 就够了，不需要 CAS
+3._tail 和 _head 各用 alignas(64) 放在单独的 cache line 上，两个线程各写各的行（避免伪共享）
+4.每一方缓存对方的下标（_head_cache / _tail_cache）：
+  生产者只有在看起来满了时才去读 _head，消费者只有在看起来空了时才去读 _tail
+  大多数操作只碰自己那一行，对方那一行不会被来回抢
+5.批量 push_n / pop_n：一次读写下标处理一批元素，环绕时分两段；
+  平凡可复制的类型整段 memcpy；其他类型 push_n 逐个复制构造，pop_n 逐个移动赋值给 dst
+  pop_n 中途移动赋值抛异常时，已取走的元素照样出队，抛异常的那个留在队首
+
+限制：
+1.只能有一个线程 push、一个线程 pop；构造和析构时不能有别的线程在用
+2.缓冲区在构造时一次分配好，之后不再分配；二级配置器的自由链表不是线程安全的，默认用 malloc_alloc
+3.满了 try_push 返回 false，空了 try_pop 返回 false，要不要等待、怎么等由调用者决定
+4.对象本身要按 64 字节对齐，_tail、_head 才真正各占一行：栈上、静态的对象编译器会对齐
+  堆上的对象要 C++17 的 aligned new；C++14 的 new 只保证 16 字节对齐，要自己用对齐的内存 placement new
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "type_traits.h"
+#include "alloc.h"
+#include "construct.h"
+#include "uninitialized.h"
+
+namespace lzstl
+{
+	enum {__SPSC_CACHE_LINE = 64};
+
+	template <typename T,typename Alloc = malloc_alloc>
+	class spsc_ring
+	{
+	public:
+		typedef T			value_type;
+		typedef size_t		size_type;
+		typedef Alloc		allocator_type;
+	private:
+		typedef typename __bool_type<is_trivially_copyable<T>::value>::type __trivial;
+
+		// 两方都只读
+		T*			_buf;
+		size_type	_mask;
+
+		// 生产者的行：alignas 让它从新的一行开始
+		alignas(__SPSC_CACHE_LINE) std::atomic<size_type>	_tail;			// 下一个写入的下标
+		size_type											_head_cache;	// 生产者最近一次看到的 _head
+
+		// 消费者的行；整个对象的大小也会补齐到行的整数倍，后面的对象碰不到这一行
+		alignas(__SPSC_CACHE_LINE) std::atomic<size_type>	_head;			// 下一个读出的下标
+		size_type											_tail_cache;	// 消费者最近一次看到的 _tail
+
+		static size_type _round_up(size_type n)
+		{
+			size_type cap = 2;
+			while(cap < n)
+				cap <<= 1;
+			return cap;
+		}
+
+		// 生产者：从下标 t 起的空位数，看起来满了才重新读一次 _head
+		size_type _free_slots(size_type t)
+		{
+			size_type free = capacity() - (t - _head_cache);
+			if(free == 0)
+			{
+				_head_cache = _head.load(std::memory_order_acquire);
+				free = capacity() - (t - _head_cache);
+			}
+			return free;
+		}
+
+		// 消费者：从下标 h 起已经写好的元素个数，看起来空了才重新读一次 _tail
+		size_type _ready_slots(size_type h)
+		{
+			size_type ready = _tail_cache - h;
+			if(ready == 0)
+			{
+				_tail_cache = _tail.load(std::memory_order_acquire);
+				ready = _tail_cache - h;
+			}
+			return ready;
+		}
+
+		// 把 src 的 n 个元素复制到从槽 first 开始的连续槽里；复制构造失败时已构造的会被析构
+		void _put(size_type first,const T* src,size_type n,true_type)
+		{
+			std::memcpy(static_cast<void*>(_buf + first),static_cast<const void*>(src),n * sizeof(T));
+		}
+
+		void _put(size_type first,const T* src,size_type n,false_type)
+		{
+			lzstl::uninitialized_copy(src,src + n,_buf + first);
+		}
+
+		// 从槽 first 开始取 n 个元素移到 dst（dst 处已有对象，移动赋值），槽里的对象随后析构
+		// done 累加已经取走并析构的个数，移动赋值抛异常时调用方据此推进 _head
+		void _take(size_type first,T* dst,size_type n,size_type& done,true_type)
+		{
+			std::memcpy(static_cast<void*>(dst),static_cast<const void*>(_buf + first),n * sizeof(T));
+			done += n;
+		}
+
+		void _take(size_type first,T* dst,size_type n,size_type& done,false_type)
+		{
+			for(size_type i = 0;i<n;++i,++done)
+			{
+				dst[i] = std::move(_buf[first + i]);
+				lzstl::destroy(_buf + first + i);
+			}
+		}
+
+		spsc_ring(const spsc_ring&);
+		spsc_ring& operator=(const spsc_ring&);
+
+	public:
+		// 容量向上取整到 2 的幂，至少为 2
+		explicit spsc_ring(size_type capacity)
+			:_mask(_round_up(capacity) - 1),_tail(0),_head_cache(0),_head(0),_tail_cache(0)
+		{
+			_buf = static_cast<T*>(Alloc::allocate((_mask + 1) * sizeof(T)));
+		}
+
+		~spsc_ring()
+		{
+			size_type h = _head.load(std::memory_order_relaxed);
+			size_type t = _tail.load(std::memory_order_relaxed);
+			for(;h != t;++h)
+				lzstl::destroy(_buf + (h & _mask));
+			Alloc::deallocate(_buf,(_mask + 1) * sizeof(T));
+		}
+
+		// -------------------------- 容量与大小 --------------------------
+		size_type capacity() const {return _mask + 1;}
+
+		// 别的线程同时在操作时只是一个近似值
+		size_type size() const
+		{
+			size_type h = _head.load(std::memory_order_acquire);
+			size_type t = _tail.load(std::memory_order_acquire);
+			return t - h;
+		}
+		bool empty() const {return size() == 0;}
+
+		// -------------------------- 生产者 --------------------------
+		template <typename... Args>
+		bool try_emplace(Args&&... args)
+		{
+			size_type t = _tail.load(std::memory_order_relaxed);
+			if(_free_slots(t) == 0)
+				return false;
+			::new (static_cast<void*>(_buf + (t & _mask))) T(std::forward<Args>(args)...);
+			_tail.store(t + 1,std::memory_order_release);
+			return true;
+		}
+
+		bool try_push(const T& value) {return try_emplace(value);}
+		bool try_push(T&& value) {return try_emplace(std::move(value));}
+
+		// 放入 [src, src+n) 中能放下的前若干个，返回放入的个数
+		size_type push_n(const T* src,size_type n)
+		{
+			size_type t = _tail.load(std::memory_order_relaxed);
+			size_type free = capacity() - (t - _head_cache);
+			if(free < n)
+			{
+				_head_cache = _head.load(std::memory_order_acquire);
+				free = capacity() - (t - _head_cache);
+			}
+			if(n > free)
+				n = free;
+			size_type first = t & _mask;
+			size_type part = capacity() - first < n ? capacity() - first : n;
+			_put(first,src,part,__trivial());
+			try
+			{
+				_put(0,src + part,n - part,__trivial());
+			}
+			catch(...)
+			{
+				lzstl::destroy(_buf + first,_buf + first + part);
+				throw;
+			}
+			_tail.store(t + n,std::memory_order_release);
+			return n;
+		}
+
+		// -------------------------- 消费者 --------------------------
+		bool try_pop(T& out)
+		{
+			size_type h = _head.load(std::memory_order_relaxed);
+			if(_ready_slots(h) == 0)
+				return false;
+			T* p = _buf + (h & _mask);
+			out = std::move(*p);
+			lzstl::destroy(p);
+			_head.store(h + 1,std::memory_order_release);
+			return true;
+		}
+
+		// 队首元素，空时为 nullptr；用完后调用 pop() 释放槽位（省掉一次移动）
+		T* front()
+		{
+			size_type h = _head.load(std::memory_order_relaxed);
+			return _ready_slots(h) ? _buf + (h & _mask) : nullptr;
+		}
+
+		void pop()
+		{
+			size_type h = _head.load(std::memory_order_relaxed);
+			lzstl::destroy(_buf + (h & _mask));
+			_head.store(h + 1,std::memory_order_release);
+		}
+
+		// 取出至多 n 个元素移到 dst，返回取出的个数
+		size_type pop_n(T* dst,size_type n)
+		{
+			size_type h = _head.load(std::memory_order_relaxed);
+			size_type ready = _tail_cache - h;
+			if(ready < n)
+			{
+				_tail_cache = _tail.load(std::memory_order_acquire);
+				ready = _tail_cache - h;
+			}
+			if(n > ready)
+				n = ready;
+			size_type first = h & _mask;
+			size_type part = capacity() - first < n ? capacity() - first : n;
+			size_type done = 0;
+			try
+			{
+				_take(first,dst,part,done,__trivial());
+				_take(0,dst + part,n - part,done,__trivial());
+			}
+			catch(...)
+			{
+				// 已经析构的槽要让出去，否则之后会被再取一次、再析构一次；抛异常的那个元素还留在队首
+				_head.store(h + done,std::memory_order_release);
+				throw;
+			}
+			_head.store(h + n,std::memory_order_release);
+			return n;
+		}
+
+		allocator_type get_allocator() const {return allocator_type();}
+	};
+}
+
+#endif
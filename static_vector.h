@@ -0,0 +1,482 @@
+#ifndef LZ_STL_STATIC_VECTOR_H
+#define LZ_STL_STATIC_VECTOR_H
+
+/*
+static_vector<T, N>：容量固定为 N、元素放在对象内部的 vector
+为什么需要？
+报文头里的字段、扇出很小的邻接表这类热路径，元素个数有确定的上限，而且通常只有几个到几十个
+用 vector 每个对象都要一次分配，元素和对象本身也不在一起，多一次间接访问
+
+做法：
+1.接口与 lzstl::vector 一致（push_back / emplace_back / insert / erase / resize ...），capacity() 恒为 N
+2.元素存在对象内部按 alignof(T) 对齐的存储里，任何操作都不分配内存
+3.超出容量时抛 std::bad_alloc（和配置器内存不足时一样），reserve(n > N) 也一样
+4.按 T 的性质选存储：
+  T 平凡（平凡默认构造 + 平凡可复制）：存储就是 T 数组，所有特殊成员函数由编译器生成，
+    static_vector 本身平凡可复制、是字面类型，push_back / insert / erase 等都是 constexpr，可以在常量表达式里用
+  T 平凡可复制但默认构造不平凡：未初始化的对齐存储，复制/析构仍由编译器生成，整个对象平凡可复制
+  其他：未初始化的对齐存储，复制/移动/析构只处理前 size() 个元素，
+    走 construct.h / uninitialized.h（POD 按字节复制，平凡析构什么都不做）
+
+限制：
+1.T 平凡时存储在构造时被值初始化（全 0），N 很大时构造有 O(N) 的开销；这是 C++14 的 constexpr 构造函数必须初始化所有成员的代价
+2.复制、移动、交换都是 O(size())（平凡可复制时是 O(N) 的按字节复制），不能像 vector 那样交换指针
+3.非平凡类型的 constexpr 只是声明上的，不能用在常量表达式里
+*/
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "type_traits.h"
+#include "construct.h"
+#include "uninitialized.h"
+
+namespace lzstl
+{
+	// 存储：按 T 是否平凡 / 平凡可复制选三种实现，派生类只通过 _ptr() 和 _size 使用
+	template <typename T,size_t N,bool TriviallyCopyable = is_trivially_copyable<T>::value,
+			  bool Trivial = std::is_trivial<T>::value>
+	struct __static_vector_base;
+
+	// T 平凡：直接用 T 数组，特殊成员函数都由编译器生成
+	template <typename T,size_t N>
+	struct __static_vector_base<T,N,true,true>
+	{
+		T		_data[N ? N : 1];
+		size_t	_size;
+
+		constexpr __static_vector_base():_data(),_size(0){}
+
+		constexpr T* _ptr() {return _data;}
+		constexpr const T* _ptr() const {return _data;}
+	};
+
+	// T 平凡可复制但默认构造不平凡：未初始化的存储，复制就是按字节复制
+	template <typename T,size_t N>
+	struct __static_vector_base<T,N,true,false>
+	{
+		typename std::aligned_storage<sizeof(T),alignof(T)>::type _raw[N ? N : 1];
+		size_t	_size;
+
+		__static_vector_base():_size(0){}
+
+		T* _ptr() {return reinterpret_cast<T*>(_raw);}
+		const T* _ptr() const {return reinterpret_cast<const T*>(_raw);}
+	};
+
+	// 一般的 T：只有前 _size 个位置上有对象
+	template <typename T,size_t N>
+	struct __static_vector_base<T,N,false,false>
+	{
+		typename std::aligned_storage<sizeof(T),alignof(T)>::type _raw[N ? N : 1];
+		size_t	_size;
+
+		T* _ptr() {return reinterpret_cast<T*>(_raw);}
+		const T* _ptr() const {return reinterpret_cast<const T*>(_raw);}
+
+		__static_vector_base():_size(0){}
+
+		__static_vector_base(const __static_vector_base& rhs):_size(0)
+		{
+			lzstl::uninitialized_copy(rhs._ptr(),rhs._ptr() + rhs._size,_ptr());
+			_size = rhs._size;
+		}
+
+		__static_vector_base(__static_vector_base&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value):_size(0)
+		{
+			lzstl::uninitialized_move(rhs._ptr(),rhs._ptr() + rhs._size,_ptr());
+			_size = rhs._size;
+		}
+
+		// 公共部分逐个赋值，多出来的构造或析构
+		__static_vector_base& operator=(const __static_vector_base& rhs)
+		{
+			if(this != &rhs)
+			{
+				const T* src = rhs._ptr();
+				T* p = _ptr();
+				size_t n = rhs._size;
+				size_t common = n < _size ? n : _size;
+				for(size_t i = 0;i<common;++i)
+					p[i] = src[i];
+				if(n < _size)
+					lzstl::destroy(p + n,p + _size);
+				else
+					lzstl::uninitialized_copy(src + common,src + n,p + common);
+				_size = n;
+			}
+			return *this;
+		}
+
+		__static_vector_base& operator=(__static_vector_base&& rhs) noexcept(std::is_nothrow_move_assignable<T>::value
+																			  && std::is_nothrow_move_constructible<T>::value)
+		{
+			if(this != &rhs)
+			{
+				T* src = rhs._ptr();
+				T* p = _ptr();
+				size_t n = rhs._size;
+				size_t common = n < _size ? n : _size;
+				for(size_t i = 0;i<common;++i)
+					p[i] = std::move(src[i]);
+				if(n < _size)
+					lzstl::destroy(p + n,p + _size);
+				else
+					lzstl::uninitialized_move(src + common,src + n,p + common);
+				_size = n;
+			}
+			return *this;
+		}
+
+		~__static_vector_base() {lzstl::destroy(_ptr(),_ptr() + _size);}
+	};
+
+	template <typename T,size_t N>
+	class static_vector : private __static_vector_base<T,N>
+	{
+		typedef __static_vector_base<T,N> base;
+	public:
+		typedef T 			value_type;
+		typedef T* 			iterator;
+		typedef const T*	const_iterator;
+		typedef T&			reference;
+		typedef const T&	const_reference;
+		typedef size_t		size_type;
+		typedef ptrdiff_t 	difference_type;
+	private:
+		// 存储是不是 T 数组：是的话元素一直"活着"，放入/取出都是赋值，可以在常量表达式里做
+		typedef typename __bool_type<std::is_trivial<T>::value>::type __array_tag;
+
+		using base::_ptr;
+		using base::_size;
+
+		// -------------------------- 内部辅助函数 --------------------------
+		// 超出容量：和配置器内存不足时一样抛 bad_alloc
+		static constexpr void _check(size_type n)
+		{
+			if(n > N)
+				throw std::bad_alloc();
+		}
+
+		// 在位置 i 上放入一个用 args 构造的元素
+		template <typename... Args>
+		constexpr void _put(size_type i,true_type,Args&&... args)
+		{
+			_ptr()[i] = T(std::forward<Args>(args)...);
+		}
+
+		template <typename... Args>
+		void _put(size_type i,false_type,Args&&... args)
+		{
+			::new (static_cast<void*>(_ptr() + i)) T(std::forward<Args>(args)...);
+		}
+
+		// 析构 [first, last) 上的元素
+		constexpr void _kill(size_type,size_type,true_type) {}
+		void _kill(size_type first,size_type last,false_type) {lzstl::destroy(_ptr() + first,_ptr() + last);}
+
+		// 把 [pos, _size) 后移 n 位，空出的 [pos, pos+n) 变成"未构造"的位置（_size 不变）
+		constexpr void _open_gap(size_type pos,size_type n,true_type)
+		{
+			T* p = _ptr();
+			for(size_type i = _size;i-- > pos;)
+				p[i + n] = p[i];
+		}
+
+		// 落到旧 _size 之后的移动构造，其余移动赋值，最后析构空位里被移走的对象
+		void _open_gap(size_type pos,size_type n,false_type)
+		{
+			T* p = _ptr();
+			for(size_type i = _size;i-- > pos;)
+			{
+				if(i + n >= _size)
+					lzstl::construct(p + i + n,std::move(p[i]));
+				else
+					p[i + n] = std::move(p[i]);
+			}
+			size_type moved = _size - pos;
+			lzstl::destroy_n(p + pos,n < moved ? n : moved);
+		}
+
+		// [first, first+n) 上放入 [src, src+n) 的复制
+		template <typename InputIterator>
+		constexpr void _fill_from(size_type first,InputIterator src,size_type n,true_type)
+		{
+			for(size_type i = 0;i<n;++i,++src)
+				_ptr()[first + i] = *src;
+		}
+
+		template <typename InputIterator>
+		void _fill_from(size_type first,InputIterator src,size_type n,false_type)
+		{
+			lzstl::uninitialized_copy(src,std::next(src,n),_ptr() + first);
+		}
+
+		// [first, first+n) 上放入 n 个 value
+		constexpr void _fill_value(size_type first,size_type n,const T& value,true_type)
+		{
+			for(size_type i = 0;i<n;++i)
+				_ptr()[first + i] = value;
+		}
+
+		void _fill_value(size_type first,size_type n,const T& value,false_type)
+		{
+			lzstl::uninitialized_fill_n(_ptr() + first,n,value);
+		}
+
+		// [first, first+n) 上值初始化
+		constexpr void _fill_default(size_type first,size_type n,true_type)
+		{
+			for(size_type i = 0;i<n;++i)
+				_ptr()[first + i] = T();
+		}
+
+		void _fill_default(size_type first,size_type n,false_type)
+		{
+			lzstl::uninitialized_value_construct_n(_ptr() + first,n);
+		}
+
+		template <typename InputIterator>
+		constexpr size_type _distance(InputIterator first,InputIterator last)
+		{
+			size_type n = 0;
+			for(;first != last;++first)
+				++n;
+			return n;
+		}
+
+	public:
+		// -------------------------- 构造函数/析构函数/赋值运算符 --------------------------
+		// 复制、移动、析构、赋值都由存储决定：T 平凡可复制时全是编译器生成的
+		constexpr static_vector() {}
+
+		constexpr explicit static_vector(size_type n)
+		{
+			_check(n);
+			_fill_default(0,n,__array_tag());
+			_size = n;
+		}
+
+		constexpr static_vector(size_type n,const value_type& value)
+		{
+			_check(n);
+			_fill_value(0,n,value,__array_tag());
+			_size = n;
+		}
+
+		template <typename InputIterator,typename = typename std::enable_if<
+			!std::is_integral<InputIterator>::value>::type>
+		constexpr static_vector(InputIterator first,InputIterator last)
+		{
+			size_type n = _distance(first,last);
+			_check(n);
+			_fill_from(0,first,n,__array_tag());
+			_size = n;
+		}
+
+		constexpr static_vector(std::initializer_list<value_type> il)
+		{
+			_check(il.size());
+			_fill_from(0,il.begin(),il.size(),__array_tag());
+			_size = il.size();
+		}
+
+		// -------------------------- 迭代器接口（STL标准）--------------------------
+		constexpr iterator begin() {return _ptr();}
+		constexpr const_iterator begin() const {return _ptr();}
+		constexpr iterator end() {return _ptr() + _size;}
+		constexpr const_iterator end() const {return _ptr() + _size;}
+
+		// -------------------------- 容量与大小操作 --------------------------
+		constexpr size_type size() const {return _size;}
+		static constexpr size_type capacity() {return N;}
+		static constexpr size_type max_size() {return N;}
+		constexpr bool empty() const {return _size == 0;}
+		constexpr bool full() const {return _size == N;}
+
+		// 不分配，只检查 n 是否放得下
+		constexpr void reserve(size_type n) {_check(n);}
+
+		constexpr void resize(size_type n)
+		{
+			_check(n);
+			if(n < _size)
+				_kill(n,_size,__array_tag());
+			else
+				_fill_default(_size,n - _size,__array_tag());
+			_size = n;
+		}
+
+		constexpr void resize(size_type n,const value_type& value)
+		{
+			_check(n);
+			if(n < _size)
+				_kill(n,_size,__array_tag());
+			else
+				_fill_value(_size,n - _size,value,__array_tag());
+			_size = n;
+		}
+
+		constexpr void clear()
+		{
+			_kill(0,_size,__array_tag());
+			_size = 0;
+		}
+
+		// -------------------------- 元素访问 --------------------------
+		constexpr reference operator[](size_type idx) {return _ptr()[idx];}
+		constexpr const_reference operator[](size_type idx) const {return _ptr()[idx];}
+
+		constexpr reference front() {return _ptr()[0];}
+		constexpr const_reference front() const {return _ptr()[0];}
+
+		constexpr reference back() {return _ptr()[_size - 1];}
+		constexpr const_reference back() const {return _ptr()[_size - 1];}
+
+		constexpr value_type* data() {return _ptr();}
+		constexpr const value_type* data() const {return _ptr();}
+
+		// -------------------------- 元素插入/删除 --------------------------
+		constexpr void push_back(const value_type& value)
+		{
+			_check(_size + 1);
+			_put(_size,__array_tag(),value);
+			++_size;
+		}
+
+		constexpr void push_back(value_type&& value)
+		{
+			_check(_size + 1);
+			_put(_size,__array_tag(),std::move(value));
+			++_size;
+		}
+
+		template <typename... Args>
+		constexpr reference emplace_back(Args&&... args)
+		{
+			_check(_size + 1);
+			_put(_size,__array_tag(),std::forward<Args>(args)...);
+			return _ptr()[_size++];
+		}
+
+		constexpr void pop_back()
+		{
+			if(!empty())
+			{
+				--_size;
+				_kill(_size,_size + 1,__array_tag());
+			}
+		}
+
+		//pos 插入单个
+		constexpr iterator insert(const_iterator pos,const value_type& value)
+		{
+			// value 可能引用本容器中的元素，挪动之前先复制一份
+			return insert(pos,value_type(value));
+		}
+
+		constexpr iterator insert(const_iterator pos,value_type&& value)
+		{
+			size_type idx = pos - _ptr();
+			_check(_size + 1);
+			_open_gap(idx,1,__array_tag());
+			_put(idx,__array_tag(),std::move(value));
+			++_size;
+			return _ptr() + idx;
+		}
+
+		//pos 插入n个
+		constexpr iterator insert(const_iterator pos,size_type n,const value_type& value)
+		{
+			size_type idx = pos - _ptr();
+			if(n == 0) return _ptr() + idx;
+			_check(_size + n);
+			value_type tmp(value);
+			_open_gap(idx,n,__array_tag());
+			_fill_value(idx,n,tmp,__array_tag());
+			_size += n;
+			return _ptr() + idx;
+		}
+
+		//迭代器范围插入
+		template <typename InputIterator,typename = typename std::enable_if<
+			!std::is_integral<InputIterator>::value>::type>
+		constexpr iterator insert(const_iterator pos,InputIterator first,InputIterator last)
+		{
+			size_type idx = pos - _ptr();
+			size_type n = _distance(first,last);
+			if(n == 0) return _ptr() + idx;
+			_check(_size + n);
+			_open_gap(idx,n,__array_tag());
+			_fill_from(idx,first,n,__array_tag());
+			_size += n;
+			return _ptr() + idx;
+		}
+
+		constexpr iterator erase(const_iterator pos) {return erase(pos,pos + 1);}
+
+		// [last, end) 前移到 first，末尾多出来的元素析构
+		constexpr iterator erase(const_iterator first,const_iterator last)
+		{
+			size_type lo = first - _ptr();
+			size_type hi = last - _ptr();
+			if(lo == hi) return _ptr() + lo;
+			T* p = _ptr();
+			for(size_type i = hi;i<_size;++i)
+				p[lo + i - hi] = std::move(p[i]);
+			size_type new_size = _size - (hi - lo);
+			_kill(new_size,_size,__array_tag());
+			_size = new_size;
+			return p + lo;
+		}
+
+		// 公共部分逐个交换，长的一方多出来的移到短的一方
+		constexpr void swap(static_vector& rhs)
+		{
+			static_vector* small = _size <= rhs._size ? this : &rhs;
+			static_vector* large = small == this ? &rhs : this;
+			T* s = small->_ptr();
+			T* l = large->_ptr();
+			for(size_type i = 0;i<small->_size;++i)
+			{
+				T tmp(std::move(s[i]));
+				s[i] = std::move(l[i]);
+				l[i] = std::move(tmp);
+			}
+			for(size_type i = small->_size;i<large->_size;++i)
+				small->_put(i,__array_tag(),std::move(l[i]));
+			large->_kill(small->_size,large->_size,__array_tag());
+			size_type n = small->_size;
+			small->_size = large->_size;
+			large->_size = n;
+		}
+	};
+
+	template <typename T,size_t N>
+	constexpr bool operator==(const static_vector<T,N>& lhs,const static_vector<T,N>& rhs)
+	{
+		if(lhs.size() != rhs.size())
+			return false;
+		for(size_t i = 0;i<lhs.size();++i)
+			if(!(lhs[i] == rhs[i]))
+				return false;
+		return true;
+	}
+
+	template <typename T,size_t N>
+	constexpr bool operator!=(const static_vector<T,N>& lhs,const static_vector<T,N>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <typename T,size_t N>
+	inline void swap(static_vector<T,N>& lhs,static_vector<T,N>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
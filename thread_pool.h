@@ -0,0 +1,185 @@
+#ifndef LZ_STL_THREAD_POOL_H
+#define LZ_STL_THREAD_POOL_H
+
+/*
+thread_pool：固定线程数的线程池，只提供一个阻塞的 parallel_for
+为什么需要？
+并行填充/复制大块内存时，每次现开线程的代价（几十微秒）不可忽略，线程常驻可以反复使用
+
+用法：
+	pool.parallel_for(nchunks, f);	// 对 i = 0 ... nchunks-1 调用 f(i)，全部完成后才返回
+调用线程也参与执行，所以 N 个工作线程 + 调用者 = N+1 路并行
+任务按原子计数器动态领取，快的线程多做一些
+
+限制：
+1.同一时间只执行一个 parallel_for，多个线程同时提交会排队
+2.任务里不能抛异常
+3.在任务里再调用 parallel_for 不会死锁，而是在当前线程里串行执行
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include "alloc.h"
+
+namespace lzstl
+{
+	// 第 t 段的起点（把 n 个元素尽量均匀地分成 parts 段）
+	inline size_t __chunk_begin(size_t n,size_t parts,size_t t)
+	{
+		return n / parts * t + (t < n % parts ? t : n % parts);
+	}
+
+	class thread_pool
+	{
+	private:
+		typedef void (*__invoke_fn)(void* job,size_t idx);
+
+		std::thread*	_workers;
+		unsigned		_nworkers;
+
+		std::mutex				_submit_mutex;	// 让多个提交者排队
+		std::mutex				_mutex;			// 保护下面的任务状态
+		std::condition_variable	_wake;			// 有新任务或要退出
+		std::condition_variable	_idle;			// 工作线程都离开了当前任务
+		__invoke_fn		_invoke;
+		void*			_job;
+		size_t			_nchunks;
+		std::atomic<size_t>	_next;				// 下一个待领取的块
+		unsigned		_active;				// 正在执行当前任务的工作线程数
+		unsigned long	_generation;			// 每提交一次加一
+		bool			_stop;
+
+		static bool& _inside_task()
+		{
+			static thread_local bool inside = false;
+			return inside;
+		}
+
+		template <typename F>
+		static void _invoke_impl(void* job,size_t idx)
+		{
+			(*static_cast<F*>(job))(idx);
+		}
+
+		// 领取并执行块，直到全部领完
+		static void _run_chunks(__invoke_fn invoke,void* job,size_t nchunks,std::atomic<size_t>& next)
+		{
+			_inside_task() = true;
+			for(size_t i = next.fetch_add(1,std::memory_order_relaxed);i<nchunks;i = next.fetch_add(1,std::memory_order_relaxed))
+				invoke(job,i);
+			_inside_task() = false;
+		}
+
+		void _worker_loop()
+		{
+			unsigned long seen = 0;
+			std::unique_lock<std::mutex> lock(_mutex);
+			for(;;)
+			{
+				_wake.wait(lock,[&]{return _stop || _generation != seen;});
+				if(_stop)
+					return;
+				seen = _generation;
+				__invoke_fn invoke = _invoke;
+				void* job = _job;
+				size_t nchunks = _nchunks;
+				++_active;
+				lock.unlock();
+
+				_run_chunks(invoke,job,nchunks,_next);
+
+				lock.lock();
+				if(--_active == 0)
+					_idle.notify_all();
+			}
+		}
+
+		thread_pool(const thread_pool&);
+		thread_pool& operator=(const thread_pool&);
+
+	public:
+		// nworkers 个工作线程（不含调用者）
+		explicit thread_pool(unsigned nworkers)
+			:_workers(nullptr),_nworkers(nworkers),_invoke(nullptr),_job(nullptr),_nchunks(0),_next(0),
+			 _active(0),_generation(0),_stop(false)
+		{
+			if(_nworkers == 0)
+				return;
+			_workers = static_cast<std::thread*>(malloc_alloc::allocate(_nworkers*sizeof(std::thread)));
+			for(unsigned i = 0;i<_nworkers;++i)
+				new (_workers+i) std::thread(&thread_pool::_worker_loop,this);
+		}
+
+		~thread_pool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stop = true;
+			}
+			_wake.notify_all();
+			for(unsigned i = 0;i<_nworkers;++i)
+			{
+				_workers[i].join();
+				_workers[i].~thread();
+			}
+			if(_workers)
+				malloc_alloc::deallocate(_workers,_nworkers*sizeof(std::thread));
+		}
+
+		// 参与并行的线程总数（工作线程 + 调用者）
+		unsigned concurrency() const {return _nworkers + 1;}
+
+		// 真正分发给工作线程的 parallel_for 次数（串行退化的不算），用于统计和测试
+		unsigned long dispatched()
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			return _generation;
+		}
+
+		// 对 i = 0 ... nchunks-1 调用 f(i)，全部完成后返回
+		template <typename F>
+		void parallel_for(size_t nchunks,F f)
+		{
+			if(nchunks == 0)
+				return;
+			if(_nworkers == 0 || nchunks == 1 || _inside_task())
+			{
+				for(size_t i = 0;i<nchunks;++i)
+					f(i);
+				return;
+			}
+
+			std::lock_guard<std::mutex> submit(_submit_mutex);
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				// 上一个任务中迟到的工作线程可能还没离开，等它们退出后再改任务状态
+				_idle.wait(lock,[&]{return _active == 0;});
+				_invoke = &_invoke_impl<F>;
+				_job = &f;
+				_nchunks = nchunks;
+				_next.store(0,std::memory_order_relaxed);
+				++_generation;
+			}
+			_wake.notify_all();
+
+			_run_chunks(&_invoke_impl<F>,&f,nchunks,_next);
+
+			// 块都已领完；等领了块的工作线程做完
+			std::unique_lock<std::mutex> lock(_mutex);
+			_idle.wait(lock,[&]{return _active == 0;});
+			_nchunks = 0;		// 之后才醒来的线程直接退出，不会碰已失效的 f
+		}
+	};
+
+	// 全局默认线程池：硬件线程数 - 1 个工作线程，第一次使用时创建
+	inline thread_pool& default_thread_pool()
+	{
+		static thread_pool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0);
+		return pool;
+	}
+}
+
+#endif
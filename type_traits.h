@@ -44,18 +44,63 @@ namespace lzstl
 	struct true_type {static const bool value = true;};
 	struct false_type {static const bool value = false;};
 	
-	// 2.类型特性主模板 默认设为 false 更安全
+	// bool 常量 -> true_type / false_type
+	template <bool B>
+	struct __bool_type {typedef false_type type;};
+	
+	template <>
+	struct __bool_type<true> {typedef true_type type;};
+	
+	// 2.类型特性主模板
+	/*
+	手写特化只能覆盖内置类型，用户自己的 struct { int a; double b; } 也是 POD，却只能走逐个构造/析构的慢路径
+	GCC/Clang/MSVC 都提供了判断平凡性的内建函数（编译器在编译期直接回答），主模板用它们自动推导：
+		__is_trivially_constructible / __is_trivially_assignable / __is_trivially_destructible
+		__is_trivial + __is_standard_layout = POD
+	旧的 __has_trivial_* 在 Clang 15 起被标为弃用，而且对删除了拷贝构造/赋值的类型也会答 “平凡”，所以不用它们
+	__is_trivially_destructible 直到 GCC 14 才有（Clang、MSVC 早就有），GCC 查不到时析构退回 __has_trivial_destructor
+	不认识这些内建函数的编译器退回到全部 false_type（最安全）
+	下面对基本类型、指针的手写特化保留，作为覆盖（override）；用户也可以为自己的类型特化
+	*/
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#define LZ_STL_HAS_TYPE_TRAIT_BUILTINS 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define LZ_STL_HAS_IS_TRIVIALLY_DESTRUCTIBLE 1
+#elif defined(__has_builtin)
+#if __has_builtin(__is_trivially_destructible)
+#define LZ_STL_HAS_IS_TRIVIALLY_DESTRUCTIBLE 1
+#endif
+#endif
+
+#ifdef LZ_STL_HAS_TYPE_TRAIT_BUILTINS
 	template <typename T>
 	struct type_traits
 	{
 		//memcpy 的安全性取决于 “拷贝行为是否平凡”
 		//平凡性  与 POD（平凡性且标准布局）
+		typedef typename __bool_type<__is_trivially_constructible(T)>::type				has_trivial_default_constructor;
+		typedef typename __bool_type<__is_trivially_constructible(T,const T&)>::type	has_trivial_copy_constructor;
+		typedef typename __bool_type<__is_trivially_assignable(T&,const T&)>::type		has_trivial_assignment_operator;   // 平凡赋值运算符
+#ifdef LZ_STL_HAS_IS_TRIVIALLY_DESTRUCTIBLE
+		typedef typename __bool_type<__is_trivially_destructible(T)>::type				has_trivial_destructor;
+#else
+		typedef typename __bool_type<__has_trivial_destructor(T)>::type				has_trivial_destructor;
+#endif
+		typedef typename __bool_type<__is_trivial(T) && __is_standard_layout(T)>::type is_POD_type;
+	};
+#else
+	template <typename T>
+	struct type_traits
+	{
 		typedef false_type		has_trivial_default_constructor;
 		typedef false_type		has_trivial_copy_constructor;
 		typedef false_type      has_trivial_assignment_operator;   // 平凡赋值运算符
 		typedef false_type  	has_trivial_destructor;
 		typedef false_type      is_POD_type;
 	};
+#endif
 	
 	// 3.对基本类型的特化  C++98风格，需逐个特化
 	// 3.1 bool
@@ -158,6 +203,25 @@ namespace lzstl
 		typedef true_type      has_trivial_destructor;
 		typedef true_type      is_POD_type;
 	};
+	template <>
+	struct type_traits<long long>
+	{
+		typedef true_type      has_trivial_default_constructor;
+		typedef true_type      has_trivial_copy_constructor;
+		typedef true_type      has_trivial_assignment_operator;
+		typedef true_type      has_trivial_destructor;
+		typedef true_type      is_POD_type;
+	};
+	
+	template <>
+	struct type_traits<unsigned long long>
+	{
+		typedef true_type      has_trivial_default_constructor;
+		typedef true_type      has_trivial_copy_constructor;
+		typedef true_type      has_trivial_assignment_operator;
+		typedef true_type      has_trivial_destructor;
+		typedef true_type      is_POD_type;
+	};
 	// 3.6 float
 	template <>
 	struct type_traits<float>
@@ -233,6 +297,8 @@ namespace lzstl
 	template <>struct is_integral<unsigned int>: public true_type{};
 	template <>struct is_integral<long>: public true_type{};
 	template <>struct is_integral<unsigned long>: public true_type{};
+	template <>struct is_integral<long long>: public true_type{};
+	template <>struct is_integral<unsigned long long>: public true_type{};
 	
 	template <typename T>
 	struct is_floating_point : public false_type{};
@@ -241,6 +307,30 @@ namespace lzstl
 	template <>struct is_floating_point<double> : public true_type{};
 	template <>struct is_floating_point<long double> : public true_type{};
 	
+	// 4.1 可按字节复制（memcpy 安全）/ 标准布局（和 C 结构体内存布局兼容）
+#ifdef LZ_STL_HAS_TYPE_TRAIT_BUILTINS
+	template <typename T>
+	struct is_trivially_copyable : public __bool_type<__is_trivially_copyable(T)>::type {};
+	
+	template <typename T>
+	struct is_standard_layout : public __bool_type<__is_standard_layout(T)>::type {};
+#else
+	template <typename T>
+	struct is_trivially_copyable : public type_traits<T>::is_POD_type {};
+	
+	template <typename T>
+	struct is_standard_layout : public type_traits<T>::is_POD_type {};
+#endif
+	
+	// 4.2 能否拷贝构造：只能移动的类型（如 unique_ptr）为否，容器据此在编译期关掉需要复制的路径
+#ifdef LZ_STL_HAS_TYPE_TRAIT_BUILTINS
+	template <typename T>
+	struct is_copy_constructible : public __bool_type<__is_constructible(T,const T&)>::type {};
+#else
+	template <typename T>
+	struct is_copy_constructible : public true_type {};
+#endif
+	
 	// 5. 类型转换：移除const/volatile修饰符（泛型编程必备）
 	template <typename T>
 	struct remove_const {typedef T type;};
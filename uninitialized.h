@@ -10,10 +10,13 @@
 结合 type_traits 判断元素类型是否为 POD，若为 POD 则直接用 memcpy 等高效内存操作，否则逐个调用构造函数（保证正确性）。
 */
 
+#include <type_traits>
 #include "type_traits.h"
 #include "alloc.h"
 #include "iterator.h"
 #include "construct.h"
+#include "simd.h"
+#include "thread_pool.h"
 
 namespace lzstl
 {
@@ -30,23 +33,93 @@ namespace lzstl
 	template <typename ForwardIterator, typename Size, typename T>
 	ForwardIterator __uninitialized_fill_n(ForwardIterator first, Size n, const T& value);
 	
+	// 只有目标元素是 POD 时，往未构造的内存里赋值才等同于构造；类型不同时赋值可能调用转换，一律走构造
+	template <typename InputIterator,typename ForwardIterator>
+	struct __trivially_copy_assignable
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		typedef typename __bool_type<type_traits<value_type>::is_POD_type::value
+									 && std::is_same<typename iterator_traits<InputIterator>::value_type,value_type>::value>::type type;
+	};
+	
 	// 1. uninitialized_copy：将[first, last)复制到未初始化内存[result, ...)
+	// 目标是 POD 且两端元素类型相同时：
+	//   两端都是连续迭代器：memcpy（大块时非临时存储）
+	//   不连续（如 std::list<int> 的迭代器）：逐个赋值；随机访问时按 4 个一组展开
+	// 其他情况（目标非 POD，或类型不同如 const char* -> std::string、int -> long long）：逐个构造，失败时回滚
 	template <typename InputIterator,typename ForwardIterator>
 	ForwardIterator uninitialized_copy(InputIterator first,InputIterator last,ForwardIterator result)
+	{
+		return __uninitialized_copy_aux(first,last,result,typename __trivially_copy_assignable<InputIterator,ForwardIterator>::type());
+	}
+	
+	// 两端连续、元素类型相同时才能按字节复制（int* -> long* 要逐个转换）
+	// 标签用 __bool_type 转成恰好的 true_type / false_type：is_contiguous_iterator 是从 true_type 派生的，
+	// 直接传它的对象时，精确匹配的模板重载会胜过需要派生类到基类转换的 true_type 重载
+	template <typename InputIterator,typename ForwardIterator>
+	struct __bytewise_copyable
+	{
+		typedef typename __bool_type<is_contiguous_iterator<InputIterator>::value
+									 && is_contiguous_iterator<ForwardIterator>::value
+									 && std::is_same<typename iterator_traits<InputIterator>::value_type,
+													 typename iterator_traits<ForwardIterator>::value_type>::value>::type type;
+	};
+	
+	template <typename InputIterator,typename ForwardIterator>
+	inline ForwardIterator __uninitialized_copy_aux(InputIterator first,InputIterator last,ForwardIterator result,true_type)
+	{
+		return __uninitialized_copy_pod(first,last,result,typename __bytewise_copyable<InputIterator,ForwardIterator>::type());
+	}
+	
+	template <typename InputIterator,typename ForwardIterator>
+	inline ForwardIterator __uninitialized_copy_aux(InputIterator first,InputIterator last,ForwardIterator result,false_type)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		return __uninitialized_copy(first,last,result,static_cast<value_type*>(nullptr));
+	}
+	
+	// POD，两端连续且类型相同：整块复制
+	template <typename InputIterator,typename ForwardIterator>
+	inline ForwardIterator __uninitialized_copy_pod(InputIterator first,InputIterator last,ForwardIterator result,true_type)
 	{
 		typedef typename iterator_traits<InputIterator>::value_type value_type;
-		//POD类型
-		if(type_traits<value_type>::is_POD_type::value)
-		{
-			size_t n = distance(first,last);
-			std::memcpy(&*result,&*first,n* sizeof(value_type));
-			return result + n;
-		}
-		else
+		size_t n = size_t(last - first);
+		simd_copy(&*result,&*first,n * sizeof(value_type));
+		return result + n;
+	}
+	
+	// POD，至少一端不连续：逐个赋值
+	template <typename InputIterator,typename ForwardIterator>
+	inline ForwardIterator __uninitialized_copy_pod(InputIterator first,InputIterator last,ForwardIterator result,false_type)
+	{
+		return __copy_assign_loop(first,last,result,typename __is_random_access_iterator<InputIterator>::type());
+	}
+	
+	// 随机访问：个数已知，展开 4 次减少循环判断
+	template <typename RandomAccessIterator,typename ForwardIterator>
+	ForwardIterator __copy_assign_loop(RandomAccessIterator first,RandomAccessIterator last,ForwardIterator result,true_type)
+	{
+		typename iterator_traits<RandomAccessIterator>::difference_type n = last - first;
+		for(;n >= 4;n -= 4)
 		{
-			return __uninitialized_copy(first,last,result,static_cast<value_type*>(nullptr));
+			*result = *first; ++result; ++first;
+			*result = *first; ++result; ++first;
+			*result = *first; ++result; ++first;
+			*result = *first; ++result; ++first;
 		}
+		for(;n > 0;--n,++result,++first)
+			*result = *first;
+		return result;
 	}
+	
+	template <typename InputIterator,typename ForwardIterator>
+	ForwardIterator __copy_assign_loop(InputIterator first,InputIterator last,ForwardIterator result,false_type)
+	{
+		for(;first!=last;++first,++result)
+			*result = *first;
+		return result;
+	}
+	
 	// 辅助函数 处理 非POD
 	template <typename InputIterator,typename ForwardIterator,typename T>
 	ForwardIterator __uninitialized_copy(InputIterator first,InputIterator last,ForwardIterator result,T*)
@@ -56,30 +129,42 @@ namespace lzstl
 		{
 			// 逐个构造非 POD 类型
 			for(;first!=last;++first,++cur)
-				construct(&*cur,*first);
+				lzstl::construct(&*cur,*first);
 		}
 		catch(...)
 		{
-			destroy(result,cur);
+			lzstl::destroy(result,cur);
 			throw;
 		}
 		return cur;
 	}
 	
 	// 2. uninitialized_fill：在未初始化内存[first, last)中填充value
+	// 按 is_POD_type 在编译期分派；POD 且是原生指针时走 simd_fill
 	template <typename ForwardIterator,typename T>
 	void uninitialized_fill(ForwardIterator first,ForwardIterator last,const T& value)
 	{
 		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
-		if(type_traits<value_type>::is_POD_type::value)
-		{
-			for(;first!=last;++first)
-				*first = value;
-		}
-		else
-		{
-			__uninitialized_fill(first,last,value);
-		}
+		__uninitialized_fill_aux(first,last,value,typename type_traits<value_type>::is_POD_type());
+	}
+	// POD，一般迭代器：逐个赋值
+	template <typename ForwardIterator,typename T>
+	inline void __uninitialized_fill_aux(ForwardIterator first,ForwardIterator last,const T& value,true_type)
+	{
+		for(;first!=last;++first)
+			*first = value;
+	}
+	// POD，原生指针：连续内存，SIMD 填充
+	template <typename T,typename Value>
+	inline void __uninitialized_fill_aux(T* first,T* last,const Value& value,true_type)
+	{
+		simd_fill(first,size_t(last-first),T(value));
+	}
+	// 非POD
+	template <typename ForwardIterator,typename T>
+	inline void __uninitialized_fill_aux(ForwardIterator first,ForwardIterator last,const T& value,false_type)
+	{
+		__uninitialized_fill(first,last,value);
 	}
 	// 辅助函数：非POD类型的uninitialized_fill
 	template <typename ForwardIterator,typename T>
@@ -89,11 +174,11 @@ namespace lzstl
 		try
 		{
 			for(;cur!=last;++cur)
-				construct(&*cur,value);
+				lzstl::construct(&*cur,value);
 		}
 		catch(...)
 		{
-			destroy(first,cur);
+			lzstl::destroy(first,cur);
 			throw;
 		}
 	}
@@ -103,70 +188,393 @@ namespace lzstl
 	ForwardIterator uninitialized_fill_n(ForwardIterator first, Size n, const T& value) 
 	{
 		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
-		if (type_traits<value_type>::is_POD_type::value) 
-		{
-			// POD类型：直接循环赋值（无需构造）
-			ForwardIterator cur = first;
-			for (Size i = 0; i < n; ++i, ++cur) 
-				*cur = value;
-			return cur;
-		} 
-		else 
-		{
-			// 非POD类型：逐个构造n个对象
-			return __uninitialized_fill_n(first, n, value);
-		}
+		return __uninitialized_fill_n_aux(first, n, value, typename type_traits<value_type>::is_POD_type());
+	}
+	
+	// POD，一般迭代器：直接循环赋值（无需构造）
+	template <typename ForwardIterator, typename Size, typename T>
+	inline ForwardIterator __uninitialized_fill_n_aux(ForwardIterator first, Size n, const T& value, true_type)
+	{
+		for (Size i = 0; i < n; ++i, ++first) 
+			*first = value;
+		return first;
+	}
+	
+	// POD，原生指针：SIMD 填充
+	template <typename T, typename Size, typename Value>
+	inline T* __uninitialized_fill_n_aux(T* first, Size n, const Value& value, true_type)
+	{
+		if (n <= 0)
+			return first;
+		simd_fill(first, size_t(n), T(value));
+		return first + n;
+	}
+	
+	// 非POD：逐个构造n个对象
+	template <typename ForwardIterator, typename Size, typename T>
+	inline ForwardIterator __uninitialized_fill_n_aux(ForwardIterator first, Size n, const T& value, false_type)
+	{
+		return __uninitialized_fill_n(first, n, value);
 	}
 	
 	// 辅助函数：非POD类型的uninitialized_fill_n
 	template <typename ForwardIterator, typename Size, typename T>
+	// construct_n 负责逐个构造以及异常时销毁已构造的对象
 	ForwardIterator __uninitialized_fill_n(ForwardIterator first, Size n, const T& value) {
-		ForwardIterator cur = first;
-		try 
+		return lzstl::construct_n(first, n, value);
+	}
+	
+	// 4. uninitialized_move：将[first, last)移动到未初始化内存[result, ...)
+	// POD 的移动就是复制；非POD（包括只能移动、不能复制的类型）逐个移动构造
+	template <typename InputIterator,typename ForwardIterator>
+	ForwardIterator uninitialized_move(InputIterator first,InputIterator last,ForwardIterator result)
+	{
+		typedef typename iterator_traits<InputIterator>::value_type value_type;
+		return __uninitialized_move_aux(first,last,result,typename type_traits<value_type>::is_POD_type());
+	}
+	
+	template <typename InputIterator,typename ForwardIterator>
+	inline ForwardIterator __uninitialized_move_aux(InputIterator first,InputIterator last,ForwardIterator result,true_type)
+	{
+		return lzstl::uninitialized_copy(first,last,result);
+	}
+	
+	template <typename InputIterator,typename ForwardIterator>
+	inline ForwardIterator __uninitialized_move_aux(InputIterator first,InputIterator last,ForwardIterator result,false_type)
+	{
+		return __uninitialized_move(first,last,result);
+	}
+	
+	// 辅助函数
+	template <typename InputIterator,typename ForwardIterator>
+	ForwardIterator __uninitialized_move(InputIterator first,InputIterator last,ForwardIterator result)
+	{
+		ForwardIterator cur = result;
+		try
 		{
-			for (Size i = 0; i < n; ++i, ++cur)
-				construct(&*cur, value);  // 调用构造函数
+			for(;first!=last;++first,++cur)
+				lzstl::construct(&*cur,std::move(*first));
 		}
-		catch (...)
+		catch(...)
 		{
-			destroy(first, cur);  // 异常安全：销毁已构造对象
+			lzstl::destroy(result,cur);
 			throw;
 		}
 		return cur;
 	}
 	
-	// 4. uninitialized_move：将[first, last)移动到未初始化内存[result, ...)
+	// 5. 并行版本：parallel_uninitialized_fill / fill_n / copy / move
+	// 为什么需要？
+	// 几个 GB 的 vector 由一个线程构造时，每一页第一次写入都要缺页，单线程只能用到一小部分内存带宽
+	// 大块 POD 连续区间切成 concurrency()*4 块交给线程池，多个线程同时缺页、同时写入
+	// 低于阈值、非 POD 或不连续的区间退回到上面的串行版本
+	inline size_t& __parallel_uninitialized_threshold_ref()
+	{
+		static size_t threshold = size_t(64) << 20;
+		return threshold;
+	}
+	
+	inline size_t parallel_uninitialized_threshold() {return __parallel_uninitialized_threshold_ref();}
+	
+	// 不少于 bytes 字节的区间才并行；传 size_t(-1) 关闭
+	inline void set_parallel_uninitialized_threshold(size_t bytes) {__parallel_uninitialized_threshold_ref() = bytes;}
+	
+	// 是否走并行：是否用非临时存储按总大小决定，而不是按每一块的大小
+	inline bool __use_parallel_uninitialized(size_t bytes,thread_pool& pool)
+	{
+		return bytes >= parallel_uninitialized_threshold() && pool.concurrency() > 1;
+	}
+	
+	template <typename T>
+	void __parallel_pod_fill(T* first,size_t n,const T& value,thread_pool& pool)
+	{
+		const size_t bytes = n * sizeof(T);
+		if(!__use_parallel_uninitialized(bytes,pool))
+		{
+			simd_fill(first,n,value);
+			return;
+		}
+		const bool nt = bytes >= nontemporal_threshold();
+		const size_t chunks = size_t(pool.concurrency()) * 4;
+		pool.parallel_for(chunks,[&](size_t i)
+		{
+			size_t b = __chunk_begin(n,chunks,i);
+			__simd_fill(first + b,__chunk_begin(n,chunks,i+1) - b,value,nt);
+		});
+	}
+	
+	inline void __parallel_pod_copy(void* dst,const void* src,size_t bytes,thread_pool& pool)
+	{
+		if(!__use_parallel_uninitialized(bytes,pool))
+		{
+			simd_copy(dst,src,bytes);
+			return;
+		}
+		const bool nt = bytes >= nontemporal_threshold();
+		const size_t chunks = size_t(pool.concurrency()) * 4;
+		pool.parallel_for(chunks,[&](size_t i)
+		{
+			size_t b = __chunk_begin(bytes,chunks,i);
+			__simd_copy(static_cast<char*>(dst) + b,static_cast<const char*>(src) + b,
+						__chunk_begin(bytes,chunks,i+1) - b,nt);
+		});
+	}
+	
+	// 5.1 parallel_uninitialized_fill
+	template <typename ForwardIterator,typename T>
+	void parallel_uninitialized_fill(ForwardIterator first,ForwardIterator last,const T& value,
+									 thread_pool& pool = default_thread_pool())
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		__parallel_uninitialized_fill_aux(first,last,value,pool,
+										  typename __bool_type<type_traits<value_type>::is_POD_type::value
+															   && is_contiguous_iterator<ForwardIterator>::value>::type());
+	}
+	
+	template <typename ForwardIterator,typename T>
+	inline void __parallel_uninitialized_fill_aux(ForwardIterator first,ForwardIterator last,const T& value,
+												  thread_pool& pool,true_type)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		if(first != last)
+			__parallel_pod_fill(&*first,size_t(last - first),value_type(value),pool);
+	}
+	
+	template <typename ForwardIterator,typename T>
+	inline void __parallel_uninitialized_fill_aux(ForwardIterator first,ForwardIterator last,const T& value,
+												  thread_pool&,false_type)
+	{
+		lzstl::uninitialized_fill(first,last,value);
+	}
+	
+	// 5.2 parallel_uninitialized_fill_n
+	template <typename ForwardIterator,typename Size,typename T>
+	ForwardIterator parallel_uninitialized_fill_n(ForwardIterator first,Size n,const T& value,
+												  thread_pool& pool = default_thread_pool())
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		return __parallel_uninitialized_fill_n_aux(first,n,value,pool,
+												   typename __bool_type<type_traits<value_type>::is_POD_type::value
+																		&& is_contiguous_iterator<ForwardIterator>::value>::type());
+	}
+	
+	template <typename ForwardIterator,typename Size,typename T>
+	inline ForwardIterator __parallel_uninitialized_fill_n_aux(ForwardIterator first,Size n,const T& value,
+															   thread_pool& pool,true_type)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		if(n <= 0)
+			return first;
+		__parallel_pod_fill(&*first,size_t(n),value_type(value),pool);
+		return first + n;
+	}
+	
+	template <typename ForwardIterator,typename Size,typename T>
+	inline ForwardIterator __parallel_uninitialized_fill_n_aux(ForwardIterator first,Size n,const T& value,
+															   thread_pool&,false_type)
+	{
+		return lzstl::uninitialized_fill_n(first,n,value);
+	}
+	
+	// 5.3 parallel_uninitialized_copy
 	template <typename InputIterator,typename ForwardIterator>
-	ForwardIterator uninitialized_move(InputIterator first,InputIterator last,ForwardIterator result)
+	ForwardIterator parallel_uninitialized_copy(InputIterator first,InputIterator last,ForwardIterator result,
+												thread_pool& pool = default_thread_pool())
+	{
+		typedef typename iterator_traits<InputIterator>::value_type value_type;
+		return __parallel_uninitialized_copy_aux(first,last,result,pool,
+												 typename __bool_type<type_traits<value_type>::is_POD_type::value
+																	  && __bytewise_copyable<InputIterator,ForwardIterator>::type::value>::type());
+	}
+	
+	template <typename InputIterator,typename ForwardIterator>
+	inline ForwardIterator __parallel_uninitialized_copy_aux(InputIterator first,InputIterator last,ForwardIterator result,
+															 thread_pool& pool,true_type)
 	{
 		typedef typename iterator_traits<InputIterator>::value_type value_type;
-		if(type_traits<value_type>::is_POD_type::value)
+		size_t n = size_t(last - first);
+		if(n != 0)
+			__parallel_pod_copy(&*result,&*first,n * sizeof(value_type),pool);
+		return result + n;
+	}
+	
+	template <typename InputIterator,typename ForwardIterator>
+	inline ForwardIterator __parallel_uninitialized_copy_aux(InputIterator first,InputIterator last,ForwardIterator result,
+															 thread_pool&,false_type)
+	{
+		return lzstl::uninitialized_copy(first,last,result);
+	}
+	
+	// 5.4 parallel_uninitialized_move：POD 的移动就是复制
+	template <typename InputIterator,typename ForwardIterator>
+	ForwardIterator parallel_uninitialized_move(InputIterator first,InputIterator last,ForwardIterator result,
+												thread_pool& pool = default_thread_pool())
+	{
+		typedef typename iterator_traits<InputIterator>::value_type value_type;
+		return __parallel_uninitialized_move_aux(first,last,result,pool,typename type_traits<value_type>::is_POD_type());
+	}
+	
+	template <typename InputIterator,typename ForwardIterator>
+	inline ForwardIterator __parallel_uninitialized_move_aux(InputIterator first,InputIterator last,ForwardIterator result,
+															 thread_pool& pool,true_type)
+	{
+		return lzstl::parallel_uninitialized_copy(first,last,result,pool);
+	}
+	
+	template <typename InputIterator,typename ForwardIterator>
+	inline ForwardIterator __parallel_uninitialized_move_aux(InputIterator first,InputIterator last,ForwardIterator result,
+															 thread_pool&,false_type)
+	{
+		return lzstl::uninitialized_move(first,last,result);
+	}
+	
+	// 6. uninitialized_default_construct / value_construct：在未初始化内存上默认构造 / 值初始化
+	// 默认构造（T 平凡时什么都不做，内容不确定，和 new T[n] 一样）
+	// 值初始化（T 平凡时全部置 0，和 new T[n]() 一样）：连续区间一次 memset
+	// 非平凡类型逐个构造，中途抛异常时析构已构造的部分
+	
+	// 6.1 uninitialized_default_construct
+	template <typename ForwardIterator>
+	inline void uninitialized_default_construct(ForwardIterator first,ForwardIterator last)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		__uninitialized_default_construct_aux(first,last,typename type_traits<value_type>::has_trivial_default_constructor());
+	}
+	
+	template <typename ForwardIterator>
+	inline void __uninitialized_default_construct_aux(ForwardIterator,ForwardIterator,true_type)
+	{
+		// 平凡默认构造：无事可做
+	}
+	
+	template <typename ForwardIterator>
+	void __uninitialized_default_construct_aux(ForwardIterator first,ForwardIterator last,false_type)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		ForwardIterator cur = first;
+		try
 		{
-			return uninitialized_copy(first,last,result);
+			for(;cur!=last;++cur)
+				::new (static_cast<void*>(&*cur)) value_type;
 		}
-		else
+		catch(...)
 		{
-			return __uninitialized_move(first,last,result);
+			lzstl::destroy(first,cur);
+			throw;
 		}
 	}
 	
-	// 辅助函数
-	template <typename InputIterator,typename ForwardIterator>
-	ForwardIterator __uninitialized_move(InputIterator first,InputIterator last,ForwardIterator result)
+	// 6.2 uninitialized_default_construct_n：返回 first + n
+	template <typename ForwardIterator,typename Size>
+	inline ForwardIterator uninitialized_default_construct_n(ForwardIterator first,Size n)
 	{
-		ForwardIterator cur = result;
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		return __uninitialized_default_construct_n_aux(first,n,typename type_traits<value_type>::has_trivial_default_constructor());
+	}
+	
+	template <typename ForwardIterator,typename Size>
+	inline ForwardIterator __uninitialized_default_construct_n_aux(ForwardIterator first,Size n,true_type)
+	{
+		lzstl::advance(first,n);
+		return first;
+	}
+	
+	template <typename ForwardIterator,typename Size>
+	ForwardIterator __uninitialized_default_construct_n_aux(ForwardIterator first,Size n,false_type)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		ForwardIterator cur = first;
 		try
 		{
-			for(;first!=last;++first,++cur)
-				construct(&*cur,std::move(*first));
+			for(;n > 0;--n,++cur)
+				::new (static_cast<void*>(&*cur)) value_type;
 		}
 		catch(...)
 		{
-			destroy(result,cur);
+			lzstl::destroy(first,cur);
 			throw;
 		}
 		return cur;
 	}
+	
+	// 6.3 uninitialized_value_construct
+	template <typename ForwardIterator>
+	inline void uninitialized_value_construct(ForwardIterator first,ForwardIterator last)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		__uninitialized_value_construct_aux(first,last,typename type_traits<value_type>::has_trivial_default_constructor(),
+											typename __bool_type<is_contiguous_iterator<ForwardIterator>::value>::type());
+	}
+	
+	// 平凡 + 连续：全部字节置 0
+	template <typename ForwardIterator>
+	inline void __uninitialized_value_construct_aux(ForwardIterator first,ForwardIterator last,true_type,true_type)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		if(first != last)
+			std::memset(static_cast<void*>(&*first),0,size_t(last - first) * sizeof(value_type));
+	}
+	
+	// 平凡，不连续：逐个赋 T()
+	template <typename ForwardIterator>
+	inline void __uninitialized_value_construct_aux(ForwardIterator first,ForwardIterator last,true_type,false_type)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		for(;first!=last;++first)
+			*first = value_type();
+	}
+	
+	// 非平凡：逐个 T()
+	template <typename ForwardIterator,typename Contiguous>
+	void __uninitialized_value_construct_aux(ForwardIterator first,ForwardIterator last,false_type,Contiguous)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		ForwardIterator cur = first;
+		try
+		{
+			for(;cur!=last;++cur)
+				::new (static_cast<void*>(&*cur)) value_type();
+		}
+		catch(...)
+		{
+			lzstl::destroy(first,cur);
+			throw;
+		}
+	}
+	
+	// 6.4 uninitialized_value_construct_n：返回 first + n
+	template <typename ForwardIterator,typename Size>
+	inline ForwardIterator uninitialized_value_construct_n(ForwardIterator first,Size n)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		return __uninitialized_value_construct_n_aux(first,n,typename type_traits<value_type>::has_trivial_default_constructor(),
+													 typename __bool_type<is_contiguous_iterator<ForwardIterator>::value>::type());
+	}
+	
+	template <typename ForwardIterator,typename Size>
+	inline ForwardIterator __uninitialized_value_construct_n_aux(ForwardIterator first,Size n,true_type,true_type)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		if(n <= 0)
+			return first;
+		std::memset(static_cast<void*>(&*first),0,size_t(n) * sizeof(value_type));
+		return first + n;
+	}
+	
+	template <typename ForwardIterator,typename Size>
+	inline ForwardIterator __uninitialized_value_construct_n_aux(ForwardIterator first,Size n,true_type,false_type)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		for(;n > 0;--n,++first)
+			*first = value_type();
+		return first;
+	}
+	
+	template <typename ForwardIterator,typename Size,typename Contiguous>
+	inline ForwardIterator __uninitialized_value_construct_n_aux(ForwardIterator first,Size n,false_type,Contiguous)
+	{
+		return lzstl::construct_n(first,n);
+	}
 }
 
 #endif 
@@ -7,9 +7,130 @@
 #include "construct.h"
 #include "uninitialized.h"
 #include <cstddef>
+#include <cstring>
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+/*
+快照（snapshot）：写时复制（copy-on-write）
+为什么需要？
+把一个很大的、以读为主的 vector 交给很多读者时，每个读者拷贝一份是 O(n) 的时间和内存
+
+做法：
+1.snapshot() 把 vector 当前的缓冲区交给一个引用计数的控制块 __vector_rep
+  vector 自己和每个 vector_snapshot 各持有一个引用，快照只读
+2.复制快照只是引用计数 +1，O(1)，不额外占内存
+3.vector 下一次修改（包括非 const 的 begin/[]/data）之前先 _detach()
+	若快照都已释放（计数为 1）：缓冲区重新归 vector 独占，不复制
+	否则：复制一份新缓冲区给 vector，旧缓冲区留给快照
+4.最后一个持有者负责析构元素并归还缓冲区
+
+注意：最后一个快照在哪个线程释放，缓冲区就在哪个线程归还给 Alloc
+     二级配置器的自由链表不是线程安全的，跨线程分发快照时 vector 应使用 malloc_alloc
+     （大于128字节的缓冲区本来就走 malloc，不受影响）
+*/
 
 namespace lzstl
 {
+	// 快照共享的缓冲区控制块，本身用 malloc_alloc 分配，可以在任意线程释放
+	template <typename T,typename Alloc>
+	struct __vector_rep
+	{
+		std::atomic<size_t> refs;
+		T* start;
+		T* finish;
+		T* end_of_storage;
+		
+		static __vector_rep* create(T* start,T* finish,T* end_of_storage)
+		{
+			__vector_rep* rep = static_cast<__vector_rep*>(malloc_alloc::allocate(sizeof(__vector_rep)));
+			new (&rep->refs) std::atomic<size_t>(1);
+			rep->start = start;
+			rep->finish = finish;
+			rep->end_of_storage = end_of_storage;
+			return rep;
+		}
+		
+		void add_ref() {refs.fetch_add(1,std::memory_order_relaxed);}
+		
+		// 只释放控制块本身（缓冲区的所有权已经转走）
+		static void free_rep(__vector_rep* rep)
+		{
+			rep->refs.~atomic();
+			malloc_alloc::deallocate(rep,sizeof(__vector_rep));
+		}
+		
+		// 引用计数 -1，最后一个持有者析构元素、归还缓冲区和控制块
+		static void release(__vector_rep* rep)
+		{
+			if(rep->refs.fetch_sub(1,std::memory_order_acq_rel) == 1)
+			{
+				lzstl::destroy(rep->start,rep->finish);
+				if(rep->start)
+					Alloc::deallocate(rep->start,(rep->end_of_storage-rep->start)*sizeof(T));
+				free_rep(rep);
+			}
+		}
+	};
+	
+	template <typename T,typename Alloc>
+	class vector;
+	
+	// vector 的只读快照，复制 O(1)
+	template <typename T,typename Alloc = alloc>
+	class vector_snapshot
+	{
+	public:
+		typedef T 			value_type;
+		typedef const T*	iterator;
+		typedef const T*	const_iterator;
+		typedef const T&	reference;
+		typedef const T&	const_reference;
+		typedef size_t		size_type;
+		typedef ptrdiff_t 	difference_type;
+	private:
+		typedef __vector_rep<T,Alloc> rep_type;
+		rep_type* _rep;
+		
+		friend class vector<T,Alloc>;
+		explicit vector_snapshot(rep_type* rep):_rep(rep){}
+	public:
+		vector_snapshot():_rep(nullptr){}
+		vector_snapshot(const vector_snapshot& rhs):_rep(rhs._rep)
+		{
+			if(_rep)
+				_rep->add_ref();
+		}
+		vector_snapshot(vector_snapshot&& rhs):_rep(rhs._rep) {rhs._rep = nullptr;}
+		~vector_snapshot()
+		{
+			if(_rep)
+				rep_type::release(_rep);
+		}
+		
+		vector_snapshot& operator=(vector_snapshot rhs)
+		{
+			rep_type* tmp = _rep;
+			_rep = rhs._rep;
+			rhs._rep = tmp;
+			return *this;
+		}
+		
+		const_iterator begin() const {return _rep ? _rep->start : nullptr;}
+		const_iterator end() const {return _rep ? _rep->finish : nullptr;}
+		size_type size() const {return end() - begin();}
+		bool empty() const {return begin() == end();}
+		
+		const_reference operator[](size_type idx) const {return _rep->start[idx];}
+		const_reference front() const {return *begin();}
+		const_reference back() const {return *(end()-1);}
+		const value_type* data() const {return begin();}
+		
+		// 当前共享这份缓冲区的持有者个数（含 vector 自己）
+		size_type use_count() const {return _rep ? _rep->refs.load(std::memory_order_relaxed) : 0;}
+	};
+	
 	template <typename T,typename Alloc = alloc>
 	class vector
 	{
@@ -28,6 +149,7 @@ namespace lzstl
 		iterator _finish;            // 数据区末尾地址的下一个地址
 		iterator _end_of_storage;
 		allocator_type _alloc;		// 分配器对象（负责内存分配/释放）
+		__vector_rep<T,Alloc>* _shared;	// 非空：缓冲区正与快照共享，修改前必须 _detach()
 		
 		// -------------------------- 内部辅助函数 --------------------------
 		// 分配内存并构造n个元素（值为value）
@@ -36,7 +158,7 @@ namespace lzstl
 			iterator res = _alloc.allocate(n*sizeof(value_type));
 			try
 			{
-				uninitialized_fill(res,res+n,value);
+				lzstl::uninitialized_fill(res,res+n,value);
 				return res;
 			}
 			catch(...)
@@ -46,21 +168,98 @@ namespace lzstl
 			}
 		}
 		
-		// 销毁[first, last)元素并释放内存
+		// 销毁[first, last)元素并释放整块内存
+		// 必须按容量而不是元素个数归还：小块要回到它原来所属的自由链表
 		void _destroy_and_deallocate(iterator first,iterator last)
 		{
-			if(first!=last)
+			lzstl::destroy(first,last);
+			if(_start)
+				_alloc.deallocate(_start,capacity()*sizeof(value_type));
+		}
+		
+		// 放弃当前缓冲区：共享中则只减引用计数，否则析构并释放
+		void _release_buffer()
+		{
+			if(_shared)
 			{
-				destroy(first,last);
-				_alloc.deallocate(first,(last-first)*sizeof(value_type));
+				__vector_rep<T,Alloc>::release(_shared);
+				_shared = nullptr;
 			}
+			else
+				_destroy_and_deallocate(_start,_finish);
+		}
+		
+		// 写时复制：缓冲区与快照共享时，修改前先拿到独占的缓冲区
+		void _detach()
+		{
+			if(!_shared) return;
+			if(_shared->refs.load(std::memory_order_acquire) == 1)
+			{
+				// 快照都已释放，缓冲区重新归 vector 独占
+				__vector_rep<T,Alloc>::free_rep(_shared);
+				_shared = nullptr;
+			}
+			else
+				_copy_to_new_buffer(capacity());
 		}
 		
 		// 扩容逻辑：至少扩容到new_capacity
+		// 独占的缓冲区把元素移动过去；与快照共享时只能复制
 		void _reallocate(size_type new_capacity)
 		{
 			if(new_capacity <= capacity()) return;
-			
+			if(_shared)
+				_copy_to_new_buffer(new_capacity);
+			else
+				_move_to_new_buffer(new_capacity);
+		}
+		
+		// 移动构造不抛异常（或者只能移动）才移动，否则复制：复制中途抛异常时旧缓冲区原封不动（强异常保证）
+		typedef typename __bool_type<std::is_nothrow_move_constructible<value_type>::value
+									 || !is_copy_constructible<value_type>::value>::type __move_on_grow;
+		
+		iterator _relocate(iterator new_start,true_type)
+		{
+			return lzstl::parallel_uninitialized_move(_start,_finish,new_start);
+		}
+		
+		iterator _relocate(iterator new_start,false_type)
+		{
+			return lzstl::parallel_uninitialized_copy(_start,_finish,new_start);
+		}
+		
+		// 把元素搬到容量为new_capacity的新缓冲区，再析构旧元素并归还旧缓冲区
+		void _move_to_new_buffer(size_type new_capacity)
+		{
+			iterator new_start = static_cast<iterator>(_alloc.allocate(new_capacity*sizeof(value_type)));
+			iterator new_finish = new_start;
+			try
+			{
+				new_finish = _relocate(new_start,__move_on_grow());
+			}
+			catch(...)
+			{
+				_alloc.deallocate(new_start,new_capacity*sizeof(value_type));
+				throw;
+			}
+			_destroy_and_deallocate(_start,_finish);
+			_start = new_start;
+			_finish = new_finish;
+			_end_of_storage = new_start + new_capacity;
+		}
+		
+		// 把元素复制到容量为new_capacity的新缓冲区，再放弃旧缓冲区
+		// 用复制而不是移动：旧缓冲区还被快照读取
+		void _copy_to_new_buffer(size_type new_capacity)
+		{
+			_copy_to_new_buffer(new_capacity,is_copy_constructible<value_type>());
+		}
+		
+		// 不能复制的类型不能做快照（snapshot() 中有 static_assert），_shared 恒为空，走不到这里
+		void _copy_to_new_buffer(size_type,false_type) {}
+		
+		void _copy_to_new_buffer(size_type new_capacity,true_type)
+		{
 			// 1. 分配新内存
 			iterator new_start = static_cast<iterator>(_alloc.allocate(new_capacity*sizeof(value_type)));
 			iterator new_finish = new_start;
@@ -68,23 +267,87 @@ namespace lzstl
 			try
 			{
 				// 2. 复制旧元素到新内存
-				new_finish = uninitialized_copy(_start,_finish,new_start);
+				new_finish = lzstl::parallel_uninitialized_copy(_start,_finish,new_start);
 			}
 			catch(...)
 			{
-				destroy(new_start,new_finish);
+				lzstl::destroy(new_start,new_finish);
 				_alloc.deallocate(new_start,new_capacity*sizeof(value_type));
 				throw;
 			}
 			
-			// 3. 销毁旧元素并释放旧内存
-			_destroy_and_deallocate(_start,_finish);
+			// 3. 销毁旧元素并释放旧内存（共享中则只减引用计数）
+			_release_buffer();
 			// 4. 更新指针
 			_start = new_start;
 			_finish = new_finish;
 			_end_of_storage = new_start + new_capacity;
 		}
 		
+		// 缩容到new_capacity（>= size()）
+		// POD：元素可以按字节搬运，交给配置器的 reallocate
+		//      大块走 realloc 通常原地缩小；小块复制到新规格后，旧块回到自由链表
+		void _shrink_to(size_type new_capacity,true_type)
+		{
+			size_type n = size();
+			_start = static_cast<iterator>(_alloc.reallocate(_start,capacity()*sizeof(value_type),
+															 new_capacity*sizeof(value_type)));
+			_finish = _start + n;
+			_end_of_storage = _start + new_capacity;
+		}
+		
+		// 非POD：分配新内存，逐个移动构造，再销毁旧元素并归还旧内存
+		void _shrink_to(size_type new_capacity,false_type)
+		{
+			_move_to_new_buffer(new_capacity);
+		}
+		
+		// 把 [pos, _finish) 向后挪 n 位，空出的 [pos, pos+n) 变成未构造的内存（_finish 不变）
+		// POD：一次 memmove
+		void _open_gap(iterator pos,size_type n,true_type)
+		{
+			if(pos != _finish)
+				std::memmove(static_cast<void*>(pos+n),static_cast<const void*>(pos),(_finish-pos)*sizeof(value_type));
+		}
+		
+		// 非POD：落到旧 _finish 之后的移动构造，其余移动赋值，最后析构空位里被移走的对象
+		void _open_gap(iterator pos,size_type n,false_type)
+		{
+			iterator src = _finish;
+			iterator dst = _finish + n;
+			while(src != pos)
+			{
+				--src;
+				--dst;
+				if(dst >= _finish)
+					lzstl::construct(dst,std::move(*src));
+				else
+					*dst = std::move(*src);
+			}
+			size_type moved = _finish - pos;
+			lzstl::destroy_n(pos,n < moved ? n : moved);
+		}
+		
+		// 把 [last, _finish) 前移到 first，返回新的 _finish（末尾多出来的元素尚未析构）
+		iterator _close_gap(iterator first,iterator last,true_type)
+		{
+			size_type tail = _finish - last;
+			if(tail)
+				std::memmove(static_cast<void*>(first),static_cast<const void*>(last),tail*sizeof(value_type));
+			return first + tail;
+		}
+		
+		iterator _close_gap(iterator first,iterator last,false_type)
+		{
+			while(last != _finish)
+			{
+				*first = std::move(*last);
+				++first;
+				++last;
+			}
+			return first;
+		}
+		
 		// 确保容量至少为n，不足则扩容（默认2倍扩容，最小1）
 		void _ensure_capacity(size_type n)
 		{
@@ -97,44 +360,78 @@ namespace lzstl
 			}
 		}
 		
+		// 整数：实际是 (n, value)
+		template <typename Integer>
+		void _range_initialize(Integer n,Integer value,true_type)
+		{
+			_ensure_capacity(size_type(n));
+			_finish = lzstl::parallel_uninitialized_fill_n(_start,size_type(n),value_type(value));
+		}
+		
+		template <typename InputIterator>
+		void _range_initialize(InputIterator first,InputIterator last,false_type)
+		{
+			size_type n =0;
+			InputIterator tmp = first;
+			while(tmp!=last)
+			{
+				++n;
+				++tmp;
+			}
+			_ensure_capacity(n);
+			_finish = lzstl::uninitialized_copy(first,last,_start);
+		}
+		
 	public:
 		// -------------------------- 构造函数/析构函数/赋值运算符 --------------------------
 		// 默认构造：空vector
-		vector():_start(nullptr),_finish(nullptr),_end_of_storage(nullptr){}
+		vector():_start(nullptr),_finish(nullptr),_end_of_storage(nullptr),_shared(nullptr){}
+		
+		// 构造n个值初始化的元素（POD 为 0）
+		explicit vector(size_type n)
+			:_start(nullptr),_finish(nullptr),_end_of_storage(nullptr),_shared(nullptr)
+		{
+			_ensure_capacity(n);
+			_finish = lzstl::uninitialized_value_construct_n(_start,n);
+		}
 		
 		// 构造n个值为value的元素
-		explicit vector(size_type n,const value_type& value = value_type())
+		vector(size_type n,const value_type& value)
+			:_start(nullptr),_finish(nullptr),_end_of_storage(nullptr),_shared(nullptr)
 		{
 			_ensure_capacity(n);
-			_finish = uninitialized_fill(_start,_start+n,value);
+			_finish = lzstl::parallel_uninitialized_fill_n(_start,n,value);
 		}
 		
 		// 拷贝构造
 		vector(const vector& rhs)
+			:_start(nullptr),_finish(nullptr),_end_of_storage(nullptr),_shared(nullptr)
 		{
 			_ensure_capacity(rhs.size());
-			_finish = uninitialized_copy(rhs._start,rhs._finish,_start);
+			_finish = lzstl::parallel_uninitialized_copy(rhs._start,rhs._finish,_start);
+		}
+		
+		// 移动构造：接管 rhs 的缓冲区，O(1)
+		vector(vector&& rhs)
+			:_start(rhs._start),_finish(rhs._finish),_end_of_storage(rhs._end_of_storage),_shared(rhs._shared)
+		{
+			rhs._start = rhs._finish = rhs._end_of_storage = nullptr;
+			rhs._shared = nullptr;
 		}
 		
 		// 迭代器范围构造
+		// vector<int> v(10, 1) 也会匹配到这里，用 is_integral 分派回 (n, value) 构造
 		template <typename InputIterator>
 		vector(InputIterator first,InputIterator last)
+			:_start(nullptr),_finish(nullptr),_end_of_storage(nullptr),_shared(nullptr)
 		{
-			size_type n =0;
-			InputIterator tmp = first;
-			while(tmp!=last)
-			{
-				++n;
-				++tmp;
-			}
-			_ensure_capacity(n);
-			_finish = uninitialized_copy(first,last,_start);
+			_range_initialize(first,last,is_integral<InputIterator>());
 		}
 		
 		// 析构函数
 		~vector() 
 		{
-			_destroy_and_deallocate(_start, _finish);
+			_release_buffer();
 		}
 		
 		//拷贝赋值
@@ -144,33 +441,54 @@ namespace lzstl
 			if(this == &rhs)
 				return *this;
 			
+			// 共享中的缓冲区不能覆盖，直接放弃，按容量不足处理
+			if(_shared)
+			{
+				_release_buffer();
+				_start = _finish = _end_of_storage = nullptr;
+			}
+			
 			// 2. 若当前容量足够，直接销毁旧元素（无需重新分配内存）
 			if(rhs.size() <= capacity())
 			{
-				destroy(_start,_finish);
+				lzstl::destroy(_start,_finish);
 				_finish = _start;
-				_finish = uninitialized_copy(rhs._start,rhs._finish,_start);
+				_finish = lzstl::parallel_uninitialized_copy(rhs._start,rhs._finish,_start);
 			}
 			else
 			{
 				// 3. 容量不足：销毁旧内存，分配新内存并复制
 				// 3.1 销毁当前元素并释放旧内存
-				_destroy_and_dealloctae(_start,_finish);
+				_release_buffer();
+				_start = _finish = _end_of_storage = nullptr;
 				
 				// 3.2 分配与 rhs 相同大小的内存
-				_start = _alloc.allocate(rhs.size()*sizeof(value_type));
+				_start = static_cast<iterator>(_alloc.allocate(rhs.size()*sizeof(value_type)));
 				_end_of_storage = _start + rhs.size();
 				
 				// 3.3 复制 rhs 的元素到新内存
-				_finish = uninitialized_copy(rhs._start, rhs._finish, _start);
+				_finish = lzstl::parallel_uninitialized_copy(rhs._start, rhs._finish, _start);
+			}
+			return *this;
+		}
+		
+		// 移动赋值：放弃自己的缓冲区，接管 rhs 的
+		vector& operator=(vector&& rhs)
+		{
+			if(this != &rhs)
+			{
+				_release_buffer();
+				_start = _finish = _end_of_storage = nullptr;
+				swap(rhs);
 			}
 			return *this;
 		}
 		
 		// -------------------------- 迭代器接口（STL标准）--------------------------
-		iterator begin() {return _start;}
+		// 非 const 版本返回可写迭代器，共享中需要先 _detach()
+		iterator begin() {_detach();return _start;}
 		const_iterator begin()const {return _start;}
-		iterator end() {return _finish;}
+		iterator end() {_detach();return _finish;}
 		const_iterator end()const {return _finish;}
 		
 		// -------------------------- 容量与大小操作 --------------------------
@@ -185,32 +503,97 @@ namespace lzstl
 				_reallocate(n);
 		}
 		
+		// 释放多余容量：容量缩到刚好放下 size() 个元素
+		// 容量按配置器的规格取整（如 3 个 int 占 12 字节，实际块为 16 字节，容量取 4）
+		// 空 vector 直接归还全部内存
+		void shrink_to_fit()
+		{
+			if(_finish == _end_of_storage) return;
+			if(empty())
+			{
+				_release_buffer();
+				_start = _finish = _end_of_storage = nullptr;
+				return;
+			}
+			size_type new_cap = _alloc.size_class(size()*sizeof(value_type)) / sizeof(value_type);
+			if(new_cap >= capacity())
+				return;
+			if(_shared)
+				_copy_to_new_buffer(new_cap);	// 旧缓冲区留给快照，复制的同时顺便缩容
+			else
+				_shrink_to(new_cap,typename type_traits<value_type>::is_POD_type());
+		}
+		
+		// 交换两个 vector 的内容：只交换三个指针，O(1)，不复制也不分配
+		void swap(vector& rhs)
+		{
+			iterator tmp;
+			tmp = _start; _start = rhs._start; rhs._start = tmp;
+			tmp = _finish; _finish = rhs._finish; rhs._finish = tmp;
+			tmp = _end_of_storage; _end_of_storage = rhs._end_of_storage; rhs._end_of_storage = tmp;
+			__vector_rep<T,Alloc>* rep = _shared; _shared = rhs._shared; rhs._shared = rep;
+		}
+		
+		// 只读快照：与 vector 共享缓冲区，O(1)，vector 下次修改时才复制
+		vector_snapshot<T,Alloc> snapshot()
+		{
+			static_assert(is_copy_constructible<value_type>::value,"snapshot 需要元素可复制（写时复制）");
+			if(!_shared)
+				_shared = __vector_rep<T,Alloc>::create(_start,_finish,_end_of_storage);
+			_shared->add_ref();
+			return vector_snapshot<T,Alloc>(_shared);
+		}
+		
 		// 调整大小（构造/析构元素）
-		void resize(size_type n,const value_type& value = value_type())
+		// 新增的元素值初始化（POD 为 0）
+		void resize(size_type n)
 		{
+			_detach();
+			if(n < size())
+			{
+				lzstl::destroy_n(_start+n,size()-n);
+				_finish = _start + n;
+			}
+			else if(n > size())
+			{
+				_ensure_capacity(n);
+				_finish = lzstl::uninitialized_value_construct_n(_finish,n-size());
+			}
+		}
+		
+		void resize(size_type n,const value_type& value)
+		{
+			_detach();
 			if(n < size())
 			{
 				// 缩小：析构多余元素
-				destroy(_start+n,_finish);
+				lzstl::destroy_n(_start+n,size()-n);
 				_finish = _start + n;
 			}
 			else if(n > size())
 			{
 				// 扩大：先确保容量，再构造新元素
 				_ensure_capacity(n);
-				_finish = uninitialized_fill(_finish,_start+n,value);
+				_finish = lzstl::parallel_uninitialized_fill_n(_finish,n-size(),value);
 			}
 		}
 		
 		// 清空vector（析构所有元素，容量不变）
 		void clear() 
 		{
-			destroy(_start, _finish);
+			if(_shared)
+			{
+				// 共享中不必复制：直接放弃旧缓冲区，变成空 vector
+				_release_buffer();
+				_start = _finish = _end_of_storage = nullptr;
+				return;
+			}
+			lzstl::destroy(_start, _finish);
 			_finish = _start;
 		}
 		
 		// -------------------------- 元素访问 --------------------------
-		reference operator[](size_type idx) {return _start[idx];}
+		reference operator[](size_type idx) {_detach();return _start[idx];}
 		const_reference operator[] (size_type idx) const {return _start[idx];}
 		
 		//   [begin,end)  end（）-1
@@ -221,49 +604,77 @@ namespace lzstl
 		const_reference back() const {return *(end()-1);}
 		
 		//兼容C
-		value_type* data() {return _start;}
+		value_type* data() {_detach();return _start;}
 		const value_type* data() const {return _start;}
 		
 		// -------------------------- 元素插入/删除 --------------------------
 		void push_back(const value_type& value)
 		{
 			if(_finish == _end_of_storage)
+			{
+				// value 可能就是本 vector 的元素，扩容会把它移走，先复制一份
+				value_type tmp(value);
 				_ensure_capacity(size() + 1);
-			construct(_finish,value);
+				lzstl::construct(_finish,std::move(tmp));
+			}
+			else
+			{
+				_detach();
+				lzstl::construct(_finish,value);
+			}
 			++_finish;
 		}
 		
+		void push_back(value_type&& value)
+		{
+			emplace_back(std::move(value));
+		}
+		
+		// 在末尾用 args 直接构造元素
+		template <typename... Args>
+		reference emplace_back(Args&&... args)
+		{
+			if(_finish == _end_of_storage)
+			{
+				value_type tmp(std::forward<Args>(args)...);
+				_ensure_capacity(size() + 1);
+				lzstl::construct(_finish,std::move(tmp));
+			}
+			else
+			{
+				_detach();
+				::new (static_cast<void*>(_finish)) value_type(std::forward<Args>(args)...);
+			}
+			return *_finish++;
+		}
+		
 		void pop_back()
 		{
 			if(!empty())
 			{
+				_detach();
 				--_finish;
-				destroy(_finish);
+				lzstl::destroy(_finish);
 			}
 		}
 		
 		//pos 插入单个
 		iterator insert(iterator pos,const value_type& value)
+		{
+			// value 可能引用本 vector 中的元素，挪动之前先复制一份
+			return insert(pos,value_type(value));
+		}
+		
+		iterator insert(iterator pos,value_type&& value)
 		{
 			size_type idx = pos-_start; // 记录索引 ---- 偏移量
-			if(_finish == _end_of_storage)
-			{
-				_ensure_capacity(size()+1);
-				pos = _start + idx;     // 扩容后重新计算pos（旧pos已失效）
-			}
-			// start,start+1, ... ,pos,pos+1........finish-2,finish-1,finish
-			// 移动[pos, _finish)区间的元素向后一位（空出pos位置）
-			if(_finish!=_start)
-				construct(_finish,*(_finish-1));
-			
-			//从后往前移动元素,完事插入更新
-			iterator cur = _finish-1;
-			while(cur>pos)
-			{
-				*cur = *(cur-1);
-				--cur;
-			}
-			*pos = value;
+			_detach();
+			_ensure_capacity(size()+1);
+			pos = _start + idx;         // 写时复制/扩容后重新定位pos（旧pos已失效）
+			// start,start+1, ... ,pos,pos+1........finish-1,finish
+			// [pos, _finish) 整体后移一位，pos 处成为未构造的内存
+			_open_gap(pos,1,typename type_traits<value_type>::is_POD_type());
+			lzstl::construct(pos,std::move(value));
 			++_finish;
 			return pos;
 		}
@@ -273,25 +684,18 @@ namespace lzstl
 		{
 			if(n==0) return pos;
 			
+			// value 可能引用本 vector 中的元素，写时复制/扩容会释放旧空间，必须在那之前先复制一份
+			value_type tmp(value);
 			size_type idx = pos-_start;
+			_detach();
 			_ensure_capacity(size()+n);
-			pos = _start + idx;      //扩容后重新定位pos
-			
-			iterator new_finish = _finish + n;
+			pos = _start + idx;      //写时复制/扩容后重新定位pos
 			
-			//从后往前
-			iterator cur = _finish-1;
-			iterator new_cur = new_finish-1;
-			while(cur >= pos)
-			{
-				*new_cur = *cur;
-				--cur;
-				--new_cur;
-			}
+			_open_gap(pos,n,typename type_traits<value_type>::is_POD_type());
 			//在空出的[pos, pos + n)位置构造n个value元素
-			uninitialized_fill(pos,pos+n,value);
+			lzstl::uninitialized_fill(pos,pos+n,tmp);
 			//更新
-			_finish = new_finish;
+			_finish += n;
 			return pos;
 		}
 		
@@ -309,39 +713,23 @@ namespace lzstl
 			if(n==0) return pos;
 			 
 			size_type idx = pos-_start;
+			_detach();
 			_ensure_capacity(size()+n);
 			pos = _start+idx;
 			
-			iterator new_finish = _finish + n;
-			iterator cur = _finish-1;
-			iterator new_cur = new_finish-1;
-			while(cur >= pos)
-			{
-				*new_cur = *cur;
-				--cur;
-				--new_cur;
-			}
-			
-			uninitialized_copy(first,last,pos);
-			_finish = new_finish;
+			_open_gap(pos,n,typename type_traits<value_type>::is_POD_type());
+			lzstl::uninitialized_copy(first,last,pos);
+			_finish += n;
 			return pos;
 		}
 		
 		//pos 删除单个  pos到finish-1  前移
 		iterator erase(iterator pos)
 		{
-			if(pos+1 != _finish)
-			{
-				iterator cur = pos;
-				while(cur+1 !=_finish)
-				{
-					*cur = *(cur+1);
-					++cur;
-				}
-			}
-			--_finish;
-			destroy(_finish);
-			return pos;
+			size_type idx = pos-_start;
+			_detach();
+			pos = _start + idx;
+			return erase(pos,pos+1);
 		}
 		
 		//迭代器范围删除
@@ -351,18 +739,13 @@ namespace lzstl
 			if(first == last) return last;
 			
 			size_type n = last-first;
-			iterator cur = first;
-			iterator src = last;
-			while(src != _finish)
-			{
-				*cur = *src;
-				++cur;
-				++src;
-			}
-			
-			iterator new_finish = _finish-n;
-			destroy(new_finish,_finish);
-			
+			size_type idx = first-_start;
+			_detach();
+			first = _start + idx;
+			last = first + n;
+			// POD 整段 memmove；非POD 逐个移动赋值，再析构末尾多出来的 n 个
+			iterator new_finish = _close_gap(first,last,typename type_traits<value_type>::is_POD_type());
+			lzstl::destroy_n(new_finish,n);
 			_finish = new_finish;
 			return first;
 		}
@@ -371,6 +754,15 @@ namespace lzstl
 		allocator_type get_allocator() const {return _alloc;}
 	};
 	
+	template <typename T,typename Alloc>
+	inline void swap(vector<T,Alloc>& lhs,vector<T,Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+	
 }
 
+// vector<bool> 的按位压缩特化
+#include "bvector.h"
+
 #endif